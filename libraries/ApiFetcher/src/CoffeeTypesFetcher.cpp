@@ -1,4 +1,5 @@
 #include "CoffeeTypesFetcher.h"
+#include <JsonSelector.h>
 
 CoffeeTypesFetcher::CoffeeTypesFetcher(HttpFetcher *fetcher)
     : _fetcher(fetcher) {}
@@ -14,22 +15,26 @@ bool CoffeeTypesFetcher::fetch()
 
 void CoffeeTypesFetcher::process(const String &json)
 {
-    StaticJsonDocument<1024> doc;
-    DeserializationError err = deserializeJson(doc, json);
-    if (err)
+    // Only the names are extracted; the rest of each result is skipped.
+    // Compiled on first use and shared by every fetcher
+    static const JsonSelector names("results[*].name");
+
+    std::vector<String> types;
+    size_t errorAt = 0;
+    int count = names.run(json.c_str(), [&](const JsonMatch &name) {
+        String type = name.toString();
+        if (type.length())
+            types.push_back(type);
+        return true;
+    }, &errorAt);
+    if (count < 0)
     {
-        Serial.println("JSON parse failed: " + String(err.c_str()));
+        const char *reason = errorAt >= json.length() ? "IncompleteInput" : "InvalidInput";
+        Serial.println("JSON parse failed: " + String(reason) + " at offset " + String((unsigned long)errorAt));
         return;
     }
 
-    _coffeeTypes.clear();
-    for (JsonObject obj : doc["results"].as<JsonArray>())
-    {
-        if (obj.containsKey("name"))
-        {
-            _coffeeTypes.push_back(obj["name"].as<String>());
-        }
-    }
+    _coffeeTypes.swap(types);
 }
 
 void CoffeeTypesFetcher::display()
@@ -1,6 +1,6 @@
 #pragma once
 #include <Arduino.h>
-#include <Arduino_LED_Matrix.h>
+#include "platform/arduino/LEDMatrixWrapper.h" // board matrix from the LEDMatrix library
 
 class ArduinoLEDMatrixWrapper
 {
@@ -15,7 +15,12 @@ public:
     ArduinoLEDMatrixWrapper &speed(unsigned long ms);
     ArduinoLEDMatrixWrapper &loop(int count); // -1 = infinite
 
-    // Run scrolling
+    // Non-blocking scrolling: start() once, then update(millis()) from loop()
+    void start();
+    bool update(unsigned long now); // true if a frame was pushed
+    bool isDone() const { return _matrix.scroller().isDone(); }
+
+    // Blocking scrolling; with loop(-1) it never returns
     void run();
     void begin(); // legacy immediate start (no chain)
 
@@ -24,28 +29,8 @@ public:
     String toString();
 
 private:
-    ArduinoLEDMatrix _matrix;
-    uint8_t _frame[8][12];
+    // Scrolls through the matrix's ScrollEngine; frames go out packed via loadFrame()
+    LEDMatrixWrapper _matrix;
 
     String _text = "";
-    unsigned long _stopDuration = 0;
-    unsigned long _speed = 200; // default ms per shift
-    int _loopCount = -1;        // -1 = infinite
-
-    void clearFrame();
-
-    // For full scroll rendering
-    void drawLetterToFullFrame(char c, int colOffset, uint8_t fullFrame[8][128]);
-    int getLetterWidth(char c);
-    void drawHFull(int col, uint8_t fullFrame[8][128]);
-    void drawEFull(int col, uint8_t fullFrame[8][128]);
-    void drawLFull(int col, uint8_t fullFrame[8][128]);
-    void drawOFull(int col, uint8_t fullFrame[8][128]);
-
-    // Legacy drawing (for direct displayText)
-    void drawLetter(char c, int col);
-    void drawH(int col);
-    void drawE(int col);
-    void drawL(int col);
-    void drawO(int col);
 };
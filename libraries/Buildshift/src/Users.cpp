@@ -20,28 +20,18 @@ HttpResponse Users::fetch(const char *host, int port, const char *url)
 
 int Users::parse(const String &json)
 {
-    StaticJsonDocument<2048> doc;
-    DeserializationError error = deserializeJson(doc, json);
+    // Streams "results" straight into _users; ids and names are truncated
+    // to the User buffers
+    int count = JsonCodec<User>::decodeArray(json.c_str(), "results", _users, MAX_USERS);
 
-    if (error)
+    if (count < 0)
     {
-        _logger->error(String("[Users] JSON parse failed: ") + error.c_str());
+        _userCount = 0;
+        _logger->error("[Users] JSON parse failed");
         return 0;
     }
 
-    // Root is an object
-    JsonArray arr = doc["results"].as<JsonArray>();
-    _userCount = 0;
-
-    for (JsonObject obj : arr)
-    {
-        if (_userCount >= MAX_USERS)
-            break;
-        _users[_userCount].id = obj["id"].as<String>();
-        _users[_userCount].name = obj["name"].as<String>();
-        _userCount++;
-    }
-
+    _userCount = count;
     _logger->info("[Users] Parsed " + String(_userCount) + " users.");
     return _userCount;
 }
@@ -57,8 +47,7 @@ void Users::setUsers(const User *newUsers, int count)
 
     for (int i = 0; i < _userCount; i++)
     {
-        _users[i].id = newUsers[i].id;
-        _users[i].name = newUsers[i].name;
+        _users[i] = newUsers[i];
     }
 
     if (_logger)
@@ -80,7 +69,7 @@ void Users::printUsers()
     _logger->info("[Users] Listing users:");
     for (int i = 0; i < _userCount; i++)
     {
-        _logger->info("  - " + _users[i].name + " (ID: " + _users[i].id + ")");
+        _logger->info("  - " + _users[i].getName() + " (ID: " + _users[i].getId() + ")");
     }
 }
 
@@ -88,7 +77,7 @@ bool Users::getUserByName(String &name, User &user)
 {
     for (int index = 0; index < _userCount; index++)
     {
-        if (_users[index].name.equals(name))
+        if (name.equals(_users[index].name))
         {
             user = _users[index];
             return true;
@@ -5,7 +5,7 @@
 #include "WiFi/WiFiClientWrapper.h"
 #include "HttpResponse.h"
 #include "RumpshiftLogger.h"
-#include <ArduinoJson.h>
+#include <JsonCodec.h>
 
 class Users
 {
@@ -16,13 +16,16 @@ public:
     int parse(const String &json);
     void printUsers();
 
+    static const size_t ID_LENGTH = 40;   ///< Fits a UUID
+    static const size_t NAME_LENGTH = 48;
+
     struct User
     {
-        String id;
-        String name;
+        char id[ID_LENGTH];
+        char name[NAME_LENGTH];
 
-        String getName() const { return name; }
-        String getId() const { return id; }
+        String getName() const { return String(name); }
+        String getId() const { return String(id); }
     };
 
     const User *getUsers() const { return _users; }
@@ -54,4 +57,8 @@ private:
     int _userCount = 0;
 };
 
+JSON_BINDING(Users::User,
+             JSON_FIELD(Users::User, id),
+             JSON_FIELD(Users::User, name));
+
 #endif
@@ -0,0 +1,263 @@
+#include "LzCodec.h"
+#include <avr/pgmspace.h>
+#include <memory>
+
+const char *const LzCodec::CONTENT_ENCODING = "x-rumpus-lz";
+
+// Static dictionary: keys and values that show up in our log, user-list and
+// print-job payloads. Back-references can reach into it from the first byte.
+static const char PROGMEM LZ_DICTIONARY[] =
+    "{\"results\":[{\"id\":\"\",\"name\":\"\"},"
+    "{\"job\":\"\",\"copies\":1,\"printer\":\"\"},"
+    "{\"user\":\"\",\"duration\":,\"value\":true,false,null,"
+    "\"status\":\"ok\",\"error\",\"warn\",\"debug\","
+    "\"source\":\"\",\"timestamp\":\"2025-01-01T00:00:00Z\",\"uptime\":,"
+    "{\"level\":\"info\",\"message\":\"";
+
+size_t LzCodec::dictionarySize()
+{
+    return sizeof(LZ_DICTIONARY) - 1;
+}
+
+uint8_t LzCodec::dictionaryByte(size_t index)
+{
+    return pgm_read_byte(LZ_DICTIONARY + index);
+}
+
+bool LzCodec::needsEscape(uint8_t b)
+{
+    return b == 0x00 || b == '\n' || b == 0xFF || b == ESCAPE;
+}
+
+size_t LzCodec::compress(const uint8_t *in, size_t inLen, uint8_t *out, size_t outCap)
+{
+    const size_t dictLen = dictionarySize();
+    size_t o = 0;
+    size_t flagPos = 0;
+    uint8_t bit = 8;
+    size_t p = 0;
+
+    while (p < inLen)
+    {
+        if (bit == 8)
+        {
+            if (o >= outCap)
+                return 0;
+            flagPos = o;
+            out[o++] = 0;
+            bit = 0;
+        }
+
+        // Longest match in the last WINDOW_SIZE bytes of dictionary + input
+        size_t here = dictLen + p;
+        size_t start = here > WINDOW_SIZE ? here - WINDOW_SIZE : 0;
+        size_t maxLen = inLen - p < MAX_MATCH ? inLen - p : MAX_MATCH;
+        size_t bestLen = 0;
+        size_t bestDist = 0;
+
+        if (maxLen >= MIN_MATCH)
+        {
+            for (size_t h = start; h < here; h++)
+            {
+                size_t k = 0;
+                while (k < maxLen)
+                {
+                    size_t src = h + k;
+                    uint8_t b = src < dictLen ? dictionaryByte(src) : in[src - dictLen];
+                    if (b != in[p + k])
+                        break;
+                    k++;
+                }
+                if (k > bestLen)
+                {
+                    bestLen = k;
+                    bestDist = here - h;
+                    if (k == maxLen)
+                        break;
+                }
+            }
+        }
+
+        if (bestLen >= MIN_MATCH)
+        {
+            if (o + 2 > outCap)
+                return 0;
+            size_t d = bestDist - 1;
+            out[o++] = (uint8_t)(d >> 4);
+            out[o++] = (uint8_t)(((d & 0x0F) << 4) | (bestLen - MIN_MATCH));
+            p += bestLen;
+        }
+        else
+        {
+            if (o + 1 > outCap)
+                return 0;
+            out[flagPos] |= (uint8_t)(1 << bit);
+            out[o++] = in[p++];
+        }
+        bit++;
+    }
+    return o;
+}
+
+size_t LzCodec::decompress(const uint8_t *in, size_t inLen, uint8_t *out, size_t outCap)
+{
+    const size_t dictLen = dictionarySize();
+    size_t i = 0;
+    size_t o = 0;
+
+    while (i < inLen)
+    {
+        uint8_t flags = in[i++];
+        for (uint8_t bit = 0; bit < 8 && i < inLen; bit++)
+        {
+            if (flags & (1 << bit))
+            {
+                if (o >= outCap)
+                    return 0;
+                out[o++] = in[i++];
+                continue;
+            }
+
+            if (i + 2 > inLen)
+                return 0;
+            size_t dist = (((size_t)in[i] << 4) | (in[i + 1] >> 4)) + 1;
+            size_t len = (in[i + 1] & 0x0F) + MIN_MATCH;
+            i += 2;
+
+            size_t here = dictLen + o;
+            if (dist > here || o + len > outCap)
+                return 0;
+
+            // Byte-by-byte so overlapping references repeat correctly
+            for (size_t h = here - dist; len > 0; len--, h++)
+                out[o++] = h < dictLen ? dictionaryByte(h) : out[h - dictLen];
+        }
+    }
+    return o;
+}
+
+size_t LzCodec::decompressedSize(const uint8_t *in, size_t inLen)
+{
+    size_t i = 0;
+    size_t o = 0;
+    while (i < inLen)
+    {
+        uint8_t flags = in[i++];
+        for (uint8_t bit = 0; bit < 8 && i < inLen; bit++)
+        {
+            if (flags & (1 << bit))
+            {
+                i++;
+                o++;
+            }
+            else
+            {
+                if (i + 2 > inLen)
+                    return 0;
+                o += (in[i + 1] & 0x0F) + MIN_MATCH;
+                i += 2;
+            }
+        }
+    }
+    return o;
+}
+
+String LzCodec::pack(const String &text)
+{
+    size_t len = text.length();
+    if (len == 0)
+        return text;
+
+    size_t cap = maxCompressedSize(len);
+    std::unique_ptr<uint8_t[]> buf(new uint8_t[cap]);
+    size_t n = compress(reinterpret_cast<const uint8_t *>(text.c_str()), len, buf.get(), cap);
+    if (n == 0)
+        return text;
+
+    size_t packedLen = 1 + n;
+    for (size_t i = 0; i < n; i++)
+        if (needsEscape(buf[i]))
+            packedLen++;
+    if (packedLen >= len)
+        return text;
+
+    String record;
+    record.reserve(packedLen);
+    record += (char)MARKER;
+    for (size_t i = 0; i < n; i++)
+    {
+        if (needsEscape(buf[i]))
+        {
+            record += (char)ESCAPE;
+            record += (char)(buf[i] ^ 0x20);
+        }
+        else
+        {
+            record += (char)buf[i];
+        }
+    }
+    return record;
+}
+
+bool LzCodec::isPacked(const String &record)
+{
+    return record.length() > 0 && (uint8_t)record[0] == MARKER;
+}
+
+size_t LzCodec::packedLength(const String &record)
+{
+    if (!isPacked(record))
+        return 0;
+    size_t n = 0;
+    for (size_t i = 1; i < record.length(); i++, n++)
+    {
+        if ((uint8_t)record[i] == ESCAPE)
+            i++;
+    }
+    return n;
+}
+
+size_t LzCodec::packedBytes(const String &record, uint8_t *out, size_t cap)
+{
+    if (!isPacked(record))
+        return 0;
+    size_t n = 0;
+    for (size_t i = 1; i < record.length(); i++)
+    {
+        if (n >= cap)
+            return 0;
+        uint8_t b = (uint8_t)record[i];
+        if (b == ESCAPE && i + 1 < record.length())
+            b = (uint8_t)record[++i] ^ 0x20;
+        out[n++] = b;
+    }
+    return n;
+}
+
+String LzCodec::unpack(const String &record, bool *ok)
+{
+    if (ok)
+        *ok = true;
+    if (!isPacked(record))
+        return record;
+
+    size_t n = packedLength(record);
+    std::unique_ptr<uint8_t[]> stream(new uint8_t[n]);
+    size_t size = 0;
+    size_t len = 0;
+    if (packedBytes(record, stream.get(), n) == n)
+        size = decompressedSize(stream.get(), n);
+    std::unique_ptr<uint8_t[]> text(new uint8_t[size + 1]);
+    if (size > 0)
+        len = decompress(stream.get(), n, text.get(), size);
+    text[len] = '\0';
+
+    // A packed record always holds text, all of it decoded and free of NULs
+    if (len == 0 || len != size || strlen(reinterpret_cast<const char *>(text.get())) != len)
+    {
+        if (ok)
+            *ok = false;
+        return String();
+    }
+    return String(reinterpret_cast<const char *>(text.get()));
+}
@@ -0,0 +1,102 @@
+#ifndef LZ_CODEC_H
+#define LZ_CODEC_H
+
+#include <Arduino.h>
+
+/**
+ * @class LzCodec
+ * @brief Heatshrink-style LZSS codec primed with a static JSON dictionary.
+ *
+ * Stream format:
+ *  - A flag byte precedes every group of up to 8 items (LSB first).
+ *  - Flag bit 1: one literal byte follows.
+ *  - Flag bit 0: a 2-byte back-reference follows:
+ *      byte0 = (distance - 1) >> 4
+ *      byte1 = ((distance - 1) & 0x0F) << 4 | (length - MIN_MATCH)
+ *    giving distances 1..4096 and lengths 3..18.
+ *
+ * Back-references point into the virtual history "dictionary + output so
+ * far", so even the first record can reuse common JSON keys. Neither side
+ * keeps a window buffer: the encoder searches its input, the decoder its
+ * output, and the dictionary is read from flash.
+ *
+ * The record helpers wrap compressed bytes for the newline-delimited
+ * Storage record log: a MARKER byte followed by the stream with 0x00,
+ * '\n', 0xFF and ESCAPE bytes escaped, so packed records are valid
+ * Strings and never contain record separators.
+ */
+class LzCodec
+{
+public:
+    static constexpr uint8_t MIN_MATCH = 3;
+    static constexpr uint8_t MAX_MATCH = 18;
+    static constexpr uint16_t WINDOW_SIZE = 4096;
+
+    static constexpr uint8_t MARKER = 0x1A; ///< First byte of a packed record
+    static constexpr uint8_t ESCAPE = 0x1B; ///< Escape byte inside packed records
+
+    /// Content-Encoding token used when sending the compressed stream
+    static const char *const CONTENT_ENCODING;
+
+    /**
+     * @brief Worst-case compressed size for n input bytes.
+     */
+    static constexpr size_t maxCompressedSize(size_t n) { return n + (n + 7) / 8; }
+
+    /**
+     * @brief Compress in[0..inLen) into out.
+     * @return Compressed length, or 0 if outCap was too small.
+     */
+    static size_t compress(const uint8_t *in, size_t inLen, uint8_t *out, size_t outCap);
+
+    /**
+     * @brief Decompress in[0..inLen) into out.
+     * @return Decompressed length, or 0 on malformed input or overflow.
+     */
+    static size_t decompress(const uint8_t *in, size_t inLen, uint8_t *out, size_t outCap);
+
+    /**
+     * @brief Size decompress() will produce, without writing any output.
+     */
+    static size_t decompressedSize(const uint8_t *in, size_t inLen);
+
+    // --- Storage record helpers ---
+
+    /**
+     * @brief Compress text into a packed record.
+     * Returns the text unchanged if compression would not make it smaller.
+     */
+    static String pack(const String &text);
+
+    /**
+     * @brief True if the record was produced by pack() and is compressed.
+     */
+    static bool isPacked(const String &record);
+
+    /**
+     * @brief Unescape a packed record into the raw compressed stream.
+     * @return Stream length, or 0 if not packed or cap is too small.
+     */
+    static size_t packedBytes(const String &record, uint8_t *out, size_t cap);
+
+    /**
+     * @brief Number of raw compressed bytes in a packed record.
+     */
+    static size_t packedLength(const String &record);
+
+    /**
+     * @brief Recover the original text of a record (packed or not).
+     * @param ok Set to false if a packed record does not decode: a bad
+     *           back-reference, a stream cut inside an item, or a NUL in
+     *           the text. The result is then empty; pack() never packs
+     *           empty text, so an empty result with ok set is a real one.
+     */
+    static String unpack(const String &record, bool *ok = nullptr);
+
+private:
+    static size_t dictionarySize();
+    static uint8_t dictionaryByte(size_t index);
+    static bool needsEscape(uint8_t b);
+};
+
+#endif // LZ_CODEC_H
@@ -0,0 +1,101 @@
+#ifndef ARDUINO_JSON_BACKED_H
+#define ARDUINO_JSON_BACKED_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "RumpusJsonDocument.h"
+
+#ifndef JSON_PARSE_FOREIGN_MAX
+#define JSON_PARSE_FOREIGN_MAX 8192 ///< Largest scratch pool parseForeign() allocates, in bytes
+#endif
+
+/**
+ * @class ArduinoJsonBacked
+ * @brief Common base of the ArduinoJson implementations of RumpusJsonDocument.
+ *
+ * Exposes the underlying variant so another ArduinoJson document can deep
+ * copy it variant-to-variant. Use fromDocument() to recover it from a
+ * RumpusJsonDocument pointer without RTTI.
+ */
+class ArduinoJsonBacked : public RumpusJsonDocument
+{
+public:
+    static constexpr const char *BACKEND = "ArduinoJson";
+
+    const char *backend() const override { return BACKEND; }
+
+    /**
+     * @brief Read-only view of the JSON value this document represents.
+     */
+    virtual JsonVariantConst variant() const = 0;
+
+    bool getBool(const char *key, bool fallback = false) const override
+    {
+        JsonVariantConst v = variant()[key];
+        return v.is<bool>() ? v.as<bool>() : fallback;
+    }
+
+    int64_t getInt64(const char *key, int64_t fallback = 0) const override
+    {
+        JsonVariantConst v = variant()[key];
+        if (v.is<long long>())
+            return v.as<long long>();
+        if (v.is<double>())
+            return (int64_t)v.as<double>();
+        return fallback;
+    }
+
+    double getDouble(const char *key, double fallback = 0) const override
+    {
+        JsonVariantConst v = variant()[key];
+        return v.is<double>() ? v.as<double>() : fallback;
+    }
+
+    String getString(const char *key, const String &fallback = "") const override
+    {
+        JsonVariantConst v = variant()[key];
+        return v.is<const char *>() ? String(v.as<const char *>()) : fallback;
+    }
+
+    size_t serializeTo(Print &out) override { return serializeJson(variant(), out); }
+    size_t measure() override { return measureJson(variant()); }
+
+    /**
+     * @brief Downcast if doc is ArduinoJson-backed, else nullptr.
+     */
+    static const ArduinoJsonBacked *fromDocument(const RumpusJsonDocument *doc)
+    {
+        if (!doc || !doc->backend() || strcmp(doc->backend(), BACKEND) != 0)
+            return nullptr;
+        return static_cast<const ArduinoJsonBacked *>(doc);
+    }
+
+    /**
+     * @brief Parse a document from another backend through its text form.
+     * The scratch pool doubles until the text fits, up to
+     * JSON_PARSE_FOREIGN_MAX; the result is null on a parse error, when the
+     * text needs more than that, or when an allocation fails.
+     */
+    static DynamicJsonDocument parseForeign(RumpusJsonDocument &doc)
+    {
+        String text = doc.serialize();
+        size_t size = JSON_OBJECT_SIZE(1) + text.length() * 2;
+        for (;;)
+        {
+            if (size > JSON_PARSE_FOREIGN_MAX)
+                size = JSON_PARSE_FOREIGN_MAX;
+            DynamicJsonDocument temp(size);
+            DeserializationError err = deserializeJson(temp, text);
+            if (err == DeserializationError::NoMemory && temp.capacity() >= size && size < JSON_PARSE_FOREIGN_MAX)
+            {
+                size *= 2;
+                continue;
+            }
+            if (err)
+                temp.clear();
+            return temp;
+        }
+    }
+};
+
+#endif // ARDUINO_JSON_BACKED_H
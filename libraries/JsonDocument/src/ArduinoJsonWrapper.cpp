@@ -1,5 +1,7 @@
 #include "ArduinoJsonWrapper.h"
-#include "JsonArrayWrapper.h" // Needed for wrapping JSON arrays
+#include "JsonArrayWrapper.h"  // Adapter returned by getArray()
+#include "JsonObjectWrapper.h" // Adapter returned by getObject()
+#include "JsonMergePatch.h"
 
 /**
  * @brief Construct a new ArduinoJsonWrapper object.
@@ -24,111 +26,160 @@ ArduinoJsonWrapper::ArduinoJsonWrapper(Size size)
     }
 }
 
+/**
+ * @brief Construct a wrapper on a document acquired from a pool.
+ */
+ArduinoJsonWrapper::ArduinoJsonWrapper(JsonDocumentPool &pool, size_t capacity)
+    : docPtr(pool.acquire(capacity)), _pool(&pool)
+{
+}
+
 /**
  * @brief Destructor cleans up allocated memory.
+ * Pooled documents go back to their pool instead of being freed.
  */
 ArduinoJsonWrapper::~ArduinoJsonWrapper()
 {
+    if (_pool)
+        _pool->release(docPtr.release());
 }
 
 /**
  * @brief Set a string value for a key.
  */
-void ArduinoJsonWrapper::set(const char *key, const char *value)
+bool ArduinoJsonWrapper::set(const char *key, const char *value)
 {
-    (*docPtr)[key] = value;
+    return assign(key, value);
 }
 
 /**
  * @brief Set an integer value for a key.
  */
-void ArduinoJsonWrapper::set(const char *key, int value)
+bool ArduinoJsonWrapper::set(const char *key, int value)
+{
+    return assign(key, value);
+}
+
+/**
+ * @brief Numbers and booleans are stored natively, no string conversion.
+ */
+bool ArduinoJsonWrapper::set(const char *key, bool value)
+{
+    return assign(key, value);
+}
+
+bool ArduinoJsonWrapper::set(const char *key, float value)
+{
+    return assign(key, value);
+}
+
+bool ArduinoJsonWrapper::set(const char *key, double value)
+{
+    return assign(key, value);
+}
+
+bool ArduinoJsonWrapper::set(const char *key, int64_t value)
+{
+    return assign(key, value);
+}
+
+bool ArduinoJsonWrapper::set(const char *key, uint32_t value)
+{
+    return assign(key, value);
+}
+
+template <typename T>
+bool ArduinoJsonWrapper::assign(const char *key, T value)
 {
-    (*docPtr)[key] = value;
+    bool stored = false;
+    write([&]
+          { stored = (*docPtr)[key].set(value); });
+    return stored;
 }
 
 /**
  * @brief Set an RumpusJsonDocument value for a key.
  */
-void ArduinoJsonWrapper::set(const char *key, RumpusJsonDocument *value)
+bool ArduinoJsonWrapper::set(const char *key, RumpusJsonDocument *value)
 {
     if (!value)
-        return;
+        return false;
 
-    String nestedJson = value->serialize();
-    DynamicJsonDocument temp(nestedJson.length() + 1); // TODO: I should probably be getting this size from 'value' var.
-    DeserializationError err = deserializeJson(temp, nestedJson);
-    if (err)
+    // Same backend: copy the tree directly, no text round-trip
+    const ArduinoJsonBacked *native = ArduinoJsonBacked::fromDocument(value);
+    if (native)
     {
-        // TODO: need to bring _logger into this lib
-        // if (_logger)
-        //     _logger->warn("[ArduinoJsonWrapper] Failed to parse nested JSON: " + String(err.c_str()));
-        return;
+        JsonVariantConst source = native->variant();
+        if (!reserve(source.memoryUsage() + JSON_OBJECT_SIZE(1)))
+            return false;
+        return (*docPtr)[key].set(source);
     }
 
-    (*docPtr)[key] = temp.as<JsonVariant>();
+    // Foreign backend: parse its text
+    DynamicJsonDocument temp = ArduinoJsonBacked::parseForeign(*value);
+    if (temp.isNull())
+        return false; // TODO: need to bring _logger into this lib
 
-    // TODO: when JsonArrayWrapper is built out, we should think about how to determine if it is array or object.
-    // // Determine if value is object or array
-    // JsonObject obj = value->asJsonObject();  // You would add this method to your base
-    // if (obj) {
-    //     (*docPtr)[key] = obj;
-    // } else {
-    //     JsonArray arr = value->asJsonArray();
-    //     if (arr) {
-    //         (*docPtr)[key] = arr;
-    //     }
-    // }
+    if (!reserve(temp.memoryUsage() + JSON_OBJECT_SIZE(1)))
+        return false;
+    return (*docPtr)[key].set(temp.as<JsonVariantConst>());
 }
 
 /**
  * @brief Get (or create) a nested object for a given key.
  *        If the key already exists, returns a wrapper for it.
- * @return Pointer to a new ArduinoJsonWrapper for the nested object.
+ * @return Heap adapter for the object at key; the caller deletes it.
  */
 RumpusJsonDocument *ArduinoJsonWrapper::getObject(const char *key)
 {
-    JsonVariant var = (*docPtr)[key];
-    JsonObject obj;
-
-    if (var.isNull())
-    {
-        // Create if missing
-        obj = (*docPtr).createNestedObject(key);
-    }
-    else
-    {
-        // Reuse if it already exists
-        obj = var.as<JsonObject>();
-    }
-
-    auto *wrapper = new ArduinoJsonWrapper();
-    wrapper->setInternalObject(obj);
-    return wrapper;
+    return new JsonObjectWrapper(*this, std::vector<String>{String(key)});
 }
 
 /**
  * @brief Get (or create) a nested array for a given key.
  *        If the key already exists, returns a wrapper for it.
- * @return Pointer to a new JsonArrayWrapper for the nested array.
+ * @return Heap adapter for the array at key; the caller deletes it.
  */
 RumpusJsonDocument *ArduinoJsonWrapper::getArray(const char *key)
 {
-    JsonVariant var = (*docPtr)[key];
-    JsonArray arr;
+    return new JsonArrayWrapper(*this, std::vector<String>{String(key)});
+}
 
-    if (var.isNull())
-    {
-        // Create if missing
-        arr = (*docPtr).createNestedArray(key);
-    }
-    else
-    {
-        // Reuse if it already exists
-        arr = var.as<JsonArray>();
-    }
+/**
+ * @brief View of the root object, converting an empty document to {}.
+ */
+JsonObjectView ArduinoJsonWrapper::root()
+{
+    if (docPtr->is<JsonObject>())
+        return JsonObjectView(docPtr->as<JsonObject>());
+    return JsonObjectView(docPtr->to<JsonObject>());
+}
+
+JsonObjectView ArduinoJsonWrapper::object(const char *key)
+{
+    return root().object(key);
+}
 
-    return new JsonArrayWrapper(arr); // ✅ safe wrapper for arrays
+JsonArrayView ArduinoJsonWrapper::array(const char *key)
+{
+    return root().array(key);
+}
+
+/**
+ * @brief Walk path from the root; adapters resolve through these on every call.
+ */
+JsonObjectView ArduinoJsonWrapper::objectAt(const std::vector<String> &path, size_t depth)
+{
+    if (depth == 0)
+        return root();
+    return objectAt(path, depth - 1).object(path[depth - 1].c_str());
+}
+
+JsonVariantConst ArduinoJsonWrapper::variantAt(const std::vector<String> &path, size_t depth) const
+{
+    if (depth == 0)
+        return docPtr->as<JsonVariantConst>();
+    return variantAt(path, depth - 1)[path[depth - 1].c_str()];
 }
 
 /**
@@ -141,6 +192,14 @@ String ArduinoJsonWrapper::serialize()
     return output;
 }
 
+/**
+ * @brief Read-only view of the document root.
+ */
+JsonVariantConst ArduinoJsonWrapper::variant() const
+{
+    return docPtr->as<JsonVariantConst>();
+}
+
 /**
  * @brief Clear the document.
  */
@@ -150,9 +209,128 @@ void ArduinoJsonWrapper::clear()
 }
 
 /**
- * @brief Set the internal object for a nested wrapper.
+ * @brief Variant of doc; foreign backends are parsed into scratch first.
+ */
+static JsonVariantConst patchSource(RumpusJsonDocument *doc, DynamicJsonDocument &scratch)
+{
+    const ArduinoJsonBacked *native = ArduinoJsonBacked::fromDocument(doc);
+    if (native)
+        return native->variant();
+    scratch = ArduinoJsonBacked::parseForeign(*doc);
+    return scratch.as<JsonVariantConst>();
+}
+
+/**
+ * @brief Apply an RFC 7386 merge patch, growing and retrying on overflow.
+ */
+bool ArduinoJsonWrapper::mergePatch(RumpusJsonDocument *patch)
+{
+    if (!patch || patch == this)
+        return false;
+
+    DynamicJsonDocument scratch(0);
+    JsonVariantConst source = patchSource(patch, scratch);
+    for (;;)
+    {
+        JsonMergePatch::apply(docPtr->as<JsonVariant>(), source);
+        if (!docPtr->overflowed())
+            return true;
+        if (!growAfterOverflow())
+            return false;
+    }
+}
+
+/**
+ * @brief Rebuild this document as the merge patch from base to target.
  */
-void ArduinoJsonWrapper::setInternalObject(JsonObject &obj)
+bool ArduinoJsonWrapper::diff(RumpusJsonDocument *base, RumpusJsonDocument *target)
 {
-    nestedObject = obj;
+    if (!base || !target || base == this || target == this)
+        return false;
+
+    DynamicJsonDocument baseScratch(0);
+    DynamicJsonDocument targetScratch(0);
+    JsonVariantConst from = patchSource(base, baseScratch);
+    JsonVariantConst to = patchSource(target, targetScratch);
+    for (;;)
+    {
+        docPtr->clear();
+        JsonMergePatch::diff(from, to, docPtr->as<JsonVariant>());
+        if (!docPtr->overflowed())
+            return true;
+        if (!growAfterOverflow())
+        {
+            docPtr->clear();
+            return false;
+        }
+    }
+}
+
+/**
+ * @brief Grow the pool so 'extra' more bytes fit.
+ * The document is copied into a larger pool; views into the old pool
+ * (object()/array() views and getObject()/getArray() adapters) must not be used afterwards.
+ */
+bool ArduinoJsonWrapper::reserve(size_t extra)
+{
+    size_t needed = docPtr->memoryUsage() + extra;
+    if (needed <= docPtr->capacity())
+        return true;
+    return replaceDocument(needed);
+}
+
+/**
+ * @brief Copy the document into a larger one and drop the old one.
+ * A failed allocation leaves a document with no pool (capacity 0); the
+ * old one is kept then, so the caller loses nothing already stored.
+ */
+bool ArduinoJsonWrapper::replaceDocument(size_t capacity)
+{
+    if (_pool)
+    {
+        DynamicJsonDocument *bigger = _pool->acquire(capacity);
+        if (!bigger || bigger->capacity() < capacity)
+        {
+            _pool->release(bigger);
+            return false;
+        }
+        bigger->set(*docPtr);
+        _pool->release(docPtr.release());
+        docPtr.reset(bigger);
+        return true;
+    }
+
+    auto bigger = std::make_unique<DynamicJsonDocument>(capacity);
+    if (!bigger || bigger->capacity() < capacity)
+        return false;
+    bigger->set(*docPtr);
+    docPtr = std::move(bigger);
+    return true;
+}
+
+/**
+ * @brief Step up one size class after a write overflowed the document.
+ */
+bool ArduinoJsonWrapper::growAfterOverflow()
+{
+    uint8_t cls = JsonDocumentPool::classFor(docPtr->capacity());
+    if (cls == JsonDocumentPool::NO_CLASS)
+        return false;
+    if (cls + 1 >= JsonDocumentPool::CLASS_COUNT && docPtr->capacity() == JsonDocumentPool::classSize(cls))
+        return false;
+
+    if (_pool)
+    {
+        DynamicJsonDocument *bigger = _pool->grow(docPtr.get());
+        if (!bigger)
+            return false;
+        docPtr.release(); // grow() already returned it to the pool
+        docPtr.reset(bigger);
+        return true;
+    }
+
+    // Documents sized exactly by reserve() first round up to their own class
+    size_t next = docPtr->capacity() < JsonDocumentPool::classSize(cls) ? JsonDocumentPool::classSize(cls)
+                                                                        : JsonDocumentPool::classSize(cls + 1);
+    return replaceDocument(next);
 }
@@ -9,8 +9,11 @@
 
 #include <Arduino.h>
 #include <ArduinoJson.h>
-#include "RumpusJsonDocument.h"
+#include "ArduinoJsonBacked.h"
+#include "JsonViews.h"
+#include "JsonDocumentPool.h"
 #include <memory>
+#include <vector>
 
 /**
  * @class ArduinoJsonWrapper
@@ -18,8 +21,11 @@
  *
  * This wrapper abstracts ArduinoJson usage behind a common interface,
  * allowing code to remain library-agnostic.
+ *
+ * The document grows to the next JsonDocumentPool size class when a set()
+ * overflows it, up to the largest class, instead of dropping the value.
  */
-class ArduinoJsonWrapper : public RumpusJsonDocument
+class ArduinoJsonWrapper : public ArduinoJsonBacked
 {
 public:
     /**
@@ -38,24 +44,108 @@ public:
      */
     explicit ArduinoJsonWrapper(Size size = MEDIUM);
 
+    /**
+     * @brief Construct a wrapper whose document is borrowed from a pool.
+     * Growth also goes through the pool, and the document is returned to
+     * it on destruction. The pool must outlive the wrapper.
+     * @param capacity Initial capacity; rounded up to a size class.
+     */
+    explicit ArduinoJsonWrapper(JsonDocumentPool &pool, size_t capacity = MEDIUM);
+
     // Destructor
     ~ArduinoJsonWrapper() override;
 
     // Interface overrides
-    void set(const char *key, const char *value) override;
-    void set(const char *key, int value) override;
-    void set(const char *key, RumpusJsonDocument *value) override;
+    using RumpusJsonDocument::set;
+    bool set(const char *key, const char *value) override;
+    bool set(const char *key, int value) override;
+    bool set(const char *key, bool value) override;
+    bool set(const char *key, float value) override;
+    bool set(const char *key, double value) override;
+    bool set(const char *key, int64_t value) override;
+    bool set(const char *key, uint32_t value) override;
+
+    /**
+     * @brief Deep copy another document under key.
+     *
+     * ArduinoJson-backed values are copied variant-to-variant; the pool
+     * grows first if the copy would not fit. Other backends fall back to
+     * a serialize()/parse round-trip.
+     */
+    bool set(const char *key, RumpusJsonDocument *value) override;
+
+    /**
+     * @brief Heap-allocated adapters for the RumpusJsonDocument interface.
+     * They find their member again on every call, so they stay valid when
+     * this document grows, and their writes grow it too. Prefer
+     * object()/array(), which allocate nothing.
+     */
     RumpusJsonDocument *getObject(const char *key) override;
     RumpusJsonDocument *getArray(const char *key) override;
     String serialize() override;
     void clear() override;
+    JsonVariantConst variant() const override;
+
+    /**
+     * @brief JSON Merge Patch support; see JsonMergePatch.h.
+     * The document grows as needed. Neither argument may be this document.
+     */
+    bool mergePatch(RumpusJsonDocument *patch) override;
+    bool diff(RumpusJsonDocument *base, RumpusJsonDocument *target) override;
+
+    /**
+     * @brief Bytes in use / available in the document's memory pool.
+     */
+    size_t memoryUsage() const { return docPtr->memoryUsage(); }
+    size_t capacity() const { return docPtr->capacity(); }
+
+    /**
+     * @brief Value-type views into this document; see JsonViews.h.
+     * object()/array() get or create the member under key. A view is a raw
+     * handle: get it again after a write that may grow the document.
+     */
+    JsonObjectView root();
+    JsonObjectView object(const char *key);
+    JsonArrayView array(const char *key);
 
 private:
+    friend class JsonObjectWrapper;
+    friend class JsonArrayWrapper;
+
     std::unique_ptr<DynamicJsonDocument> docPtr; ///< Pointer to underlying StaticJsonDocument
-    JsonObject nestedObject;                     ///< For nested objects/arrays
+    JsonDocumentPool *_pool = nullptr;           ///< Owner of docPtr's memory, if pooled
+
+    // Object reached from the root through the first depth keys of path, created as needed
+    JsonObjectView objectAt(const std::vector<String> &path, size_t depth);
+
+    // Value reached through the first depth keys of path (null if missing)
+    JsonVariantConst variantAt(const std::vector<String> &path, size_t depth) const;
+
+    // Run a write, growing the document and running it again on overflow;
+    // false if it still overflowed
+    template <typename Fn>
+    bool write(Fn fn)
+    {
+        fn();
+        while (docPtr->overflowed() && growAfterOverflow())
+            fn();
+        return !docPtr->overflowed();
+    }
+
+    // Make sure 'extra' more bytes fit in the pool, rebuilding it larger if needed;
+    // false if the larger document could not be allocated
+    bool reserve(size_t extra);
+
+    // Move the contents into a document of at least 'capacity' bytes; on a
+    // failed allocation the current document is kept and false returned
+    bool replaceDocument(size_t capacity);
+
+    // After an overflow, move to the next size class; false if there is none
+    bool growAfterOverflow();
 
-    // Internal helper to set nested JsonObject
-    void setInternalObject(JsonObject &obj);
+    // Assign (*docPtr)[key] = value, growing and retrying on overflow
+    template <typename T>
+    bool assign(const char *key, T value);
 };
 
 #endif // ARDUINO_JSON_WRAPPER_H
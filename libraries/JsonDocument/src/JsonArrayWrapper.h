@@ -3,27 +3,61 @@
 
 #include <Arduino.h>
 #include <ArduinoJson.h>
-#include "RumpusJsonDocument.h"
+#include "ArduinoJsonBacked.h"
+#include "ArduinoJsonWrapper.h"
+#include "JsonViews.h"
+#include <vector>
 
 /**
  * @class JsonArrayWrapper
  * @brief Wrapper around ArduinoJson's JsonArray for handling JSON arrays in a unified interface.
+ *
+ * RumpusJsonDocument adapter over an array inside an ArduinoJsonWrapper.
+ * Like JsonObjectWrapper it keeps the owner and the key path and finds the
+ * array again on every call, so it survives the owner growing, and add()
+ * grows the owner when it is full. Built over a bare JsonArray or
+ * JsonArrayView it writes through that handle instead.
  */
-class JsonArrayWrapper : public RumpusJsonDocument
+class JsonArrayWrapper : public ArduinoJsonBacked
 {
 public:
-    explicit JsonArrayWrapper(JsonArray arr) : array(arr) {}
+    JsonArrayWrapper(ArduinoJsonWrapper &owner, std::vector<String> path)
+        : _owner(&owner), _path(std::move(path)) {}
+    explicit JsonArrayWrapper(JsonArray arr) : _array(arr) {}
+    explicit JsonArrayWrapper(JsonArrayView view) : _array(view) {}
     ~JsonArrayWrapper() override = default;
 
-    void set(const char *key, const char *value) override {} // not used in arrays
-    void set(const char *key, int value) override {}         // not used in arrays
-    void set(const char *key, RumpusJsonDocument *value) override {}
+    using RumpusJsonDocument::set;
+
+    // Keyed sets are not used in arrays
+    bool set(const char *key, const char *value) override { return false; }
+    bool set(const char *key, int value) override { return false; }
+    bool set(const char *key, bool value) override { return false; }
+    bool set(const char *key, float value) override { return false; }
+    bool set(const char *key, double value) override { return false; }
+    bool set(const char *key, int64_t value) override { return false; }
+    bool set(const char *key, uint32_t value) override { return false; }
+    bool set(const char *key, RumpusJsonDocument *value) override { return false; }
 
     // Instead of keyed set, arrays use push/add
-    void add(const char *value) { array.add(value); }
-    void add(int value) { array.add(value); }
-    void add(float value) { array.add(value); }
-    void add(bool value) { array.add(value); }
+    bool add(const char *value) { return append(value); }
+
+    template <typename T>
+    typename std::enable_if<std::is_arithmetic<T>::value, bool>::type add(T value) { return append(value); }
+
+    /**
+     * @brief Append a buffer of samples, e.g. add(readings, count).
+     * @return Values appended; fewer than count if the owner is full at its
+     * largest size class.
+     */
+    template <typename T>
+    size_t add(const T *values, size_t count)
+    {
+        size_t added = 0;
+        while (added < count && add(values[added]))
+            added++;
+        return added;
+    }
 
     RumpusJsonDocument *getObject(const char *key) override { return nullptr; }
     RumpusJsonDocument *getArray(const char *key) override { return nullptr; }
@@ -31,14 +65,57 @@ public:
     String serialize() override
     {
         String output;
-        serializeJson(array, output);
+        serializeJson(variant(), output);
         return output;
     }
 
-    void clear() override { array.clear(); }
+    void clear() override
+    {
+        if (_owner)
+            _owner->write([&]
+                          { view().clear(); });
+        else
+            _array.clear();
+    }
+
+    JsonVariantConst variant() const override
+    {
+        return _owner ? _owner->variantAt(_path, _path.size()) : JsonVariantConst(_array.raw());
+    }
+
+    /**
+     * @brief The array as it is now, created if missing; valid until the
+     * owner next grows.
+     */
+    JsonArrayView view()
+    {
+        if (!_owner)
+            return _array;
+        return _owner->objectAt(_path, _path.size() - 1).array(_path.back().c_str());
+    }
 
 private:
-    JsonArray array;
+    ArduinoJsonWrapper *_owner = nullptr; ///< Document the array lives in, if any
+    std::vector<String> _path;            ///< Keys from the owner's root; the last names the array
+    JsonArrayView _array;                 ///< Used instead when there is no owner
+
+    template <typename T>
+    bool append(T value)
+    {
+        if (!_owner)
+            return _array.add(value);
+
+        // A failed add can leave a null slot behind: drop it before retrying
+        bool added = false;
+        _owner->write([&]
+                      {
+            JsonArrayView array = view();
+            size_t before = array.size();
+            added = array.add(value);
+            if (!added && array.size() > before)
+                array.raw().remove(before); });
+        return added;
+    }
 };
 
 #endif // JSON_ARRAY_WRAPPER_H
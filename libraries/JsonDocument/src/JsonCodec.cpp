@@ -0,0 +1,239 @@
+#include "JsonCodec.h"
+#include <string.h>
+
+namespace
+{
+    void storeSigned(void *field, uint16_t size, long value)
+    {
+        switch (size)
+        {
+        case 1:
+        {
+            int8_t v = (int8_t)value;
+            memcpy(field, &v, 1);
+            break;
+        }
+        case 2:
+        {
+            int16_t v = (int16_t)value;
+            memcpy(field, &v, 2);
+            break;
+        }
+        case 4:
+        {
+            int32_t v = (int32_t)value;
+            memcpy(field, &v, 4);
+            break;
+        }
+        default:
+            memcpy(field, &value, sizeof(long));
+        }
+    }
+
+    void storeUnsigned(void *field, uint16_t size, unsigned long value)
+    {
+        switch (size)
+        {
+        case 1:
+        {
+            uint8_t v = (uint8_t)value;
+            memcpy(field, &v, 1);
+            break;
+        }
+        case 2:
+        {
+            uint16_t v = (uint16_t)value;
+            memcpy(field, &v, 2);
+            break;
+        }
+        case 4:
+        {
+            uint32_t v = (uint32_t)value;
+            memcpy(field, &v, 4);
+            break;
+        }
+        default:
+            memcpy(field, &value, sizeof(unsigned long));
+        }
+    }
+
+    long loadSigned(const void *field, uint16_t size)
+    {
+        switch (size)
+        {
+        case 1:
+            return *(const int8_t *)field;
+        case 2:
+        {
+            int16_t v;
+            memcpy(&v, field, 2);
+            return v;
+        }
+        case 4:
+        {
+            int32_t v;
+            memcpy(&v, field, 4);
+            return v;
+        }
+        default:
+        {
+            long v;
+            memcpy(&v, field, sizeof(long));
+            return v;
+        }
+        }
+    }
+
+    unsigned long loadUnsigned(const void *field, uint16_t size)
+    {
+        switch (size)
+        {
+        case 1:
+            return *(const uint8_t *)field;
+        case 2:
+        {
+            uint16_t v;
+            memcpy(&v, field, 2);
+            return v;
+        }
+        case 4:
+        {
+            uint32_t v;
+            memcpy(&v, field, 4);
+            return v;
+        }
+        default:
+        {
+            unsigned long v;
+            memcpy(&v, field, sizeof(unsigned long));
+            return v;
+        }
+        }
+    }
+
+    // A value of the wrong type leaves the field alone; only syntax errors fail
+    bool decodeField(JsonScanner &in, void *field, const JsonField &f)
+    {
+        switch (f.kind)
+        {
+        case JsonFieldKind::Text:
+            in.readText((char *)field, f.size);
+            break;
+        case JsonFieldKind::Bool:
+        {
+            bool v;
+            if (in.readBool(v))
+                memcpy(field, &v, sizeof(bool));
+            break;
+        }
+        case JsonFieldKind::Int:
+        {
+            long v;
+            if (in.readInteger(v))
+                storeSigned(field, f.size, v);
+            break;
+        }
+        case JsonFieldKind::UInt:
+        {
+            unsigned long v;
+            if (in.readUnsigned(v))
+                storeUnsigned(field, f.size, v);
+            break;
+        }
+        case JsonFieldKind::Float:
+        {
+            double v;
+            if (!in.readNumber(v))
+                break;
+            if (f.size == sizeof(float))
+            {
+                float fv = (float)v;
+                memcpy(field, &fv, sizeof(float));
+            }
+            else
+            {
+                memcpy(field, &v, sizeof(double));
+            }
+            break;
+        }
+        default:
+            in.skipValue();
+        }
+        return !in.failed();
+    }
+}
+
+bool jsonDecodeFields(JsonScanner &in, void *base, const JsonField *fields, size_t count)
+{
+    if (!in.consume('{'))
+        return false;
+
+    bool first = true;
+    while (in.nextItem('}', first))
+    {
+        JsonScanner::Key key;
+        if (!in.readKey(key))
+            return false;
+
+        const JsonField *match = nullptr;
+        for (size_t i = 0; i < count; i++)
+        {
+            // Hash first; the name check only guards against collisions with unknown keys
+            if (fields[i].hash == key.hash && key.equals(fields[i].key, fields[i].keyLength))
+            {
+                match = &fields[i];
+                break;
+            }
+        }
+
+        if (match ? !decodeField(in, (uint8_t *)base + match->offset, *match) : !in.skipValue())
+            return false;
+    }
+    return !in.failed();
+}
+
+void jsonEncodeFields(JsonStreamWriter &out, const void *base, const JsonField *fields, size_t count)
+{
+    out.beginObject();
+    for (size_t i = 0; i < count; i++)
+    {
+        const JsonField &f = fields[i];
+        const uint8_t *field = (const uint8_t *)base + f.offset;
+
+        out.key(f.key);
+        switch (f.kind)
+        {
+        case JsonFieldKind::Text:
+            out.value((const char *)field, (size_t)f.size);
+            break;
+        case JsonFieldKind::Bool:
+            out.value(*(const bool *)field);
+            break;
+        case JsonFieldKind::Int:
+            out.value(loadSigned(field, f.size));
+            break;
+        case JsonFieldKind::UInt:
+            out.value(loadUnsigned(field, f.size));
+            break;
+        case JsonFieldKind::Float:
+        {
+            double v;
+            if (f.size == sizeof(float))
+            {
+                float fv;
+                memcpy(&fv, field, sizeof(float));
+                v = fv;
+            }
+            else
+            {
+                memcpy(&v, field, sizeof(double));
+            }
+            out.value(v, JSON_CODEC_DECIMALS);
+            break;
+        }
+        default:
+            out.nullValue();
+        }
+    }
+    out.endObject();
+}
@@ -0,0 +1,262 @@
+#ifndef JSON_CODEC_H
+#define JSON_CODEC_H
+
+#include <Arduino.h>
+#include <stddef.h>
+#include <type_traits>
+#include "JsonScanner.h"
+#include "JsonStreamWriter.h"
+
+#ifndef JSON_CODEC_DECIMALS
+#define JSON_CODEC_DECIMALS 4 ///< Decimals written for float/double fields
+#endif
+
+/**
+ * @brief How a bound field is stored in its struct.
+ */
+enum class JsonFieldKind : uint8_t
+{
+    Invalid,
+    Text, ///< char[N], always NUL-terminated after decode
+    Bool,
+    Int,  ///< signed integer of size bytes
+    UInt, ///< unsigned integer of size bytes
+    Float ///< float or double, by size
+};
+
+/**
+ * @brief Maps a member type to its JsonFieldKind; unsupported types fail to compile.
+ */
+template <typename M>
+struct JsonFieldKindOf
+{
+    static constexpr JsonFieldKind value =
+        std::is_same<M, bool>::value ? JsonFieldKind::Bool
+        : std::is_floating_point<M>::value ? JsonFieldKind::Float
+        : std::is_integral<M>::value ? (std::is_signed<M>::value ? JsonFieldKind::Int : JsonFieldKind::UInt)
+        : (std::is_array<M>::value && std::is_same<typename std::remove_extent<M>::type, char>::value) ? JsonFieldKind::Text
+                                                                                                      : JsonFieldKind::Invalid;
+
+    static_assert(value != JsonFieldKind::Invalid,
+                  "JSON_FIELD supports char[N], bool, integers and floating point members");
+    static_assert(!std::is_integral<M>::value || sizeof(M) <= sizeof(long),
+                  "JSON_FIELD integer is wider than long");
+};
+
+/**
+ * @brief Descriptor of one struct member bound to a JSON key.
+ * Built at compile time by JSON_FIELD / JSON_FIELD_KEY.
+ */
+struct JsonField
+{
+    uint32_t hash;      ///< jsonKeyHash(key)
+    const char *key;    ///< JSON member name
+    uint8_t keyLength;  ///< strlen(key)
+    JsonFieldKind kind; ///< Storage type
+    uint16_t offset;    ///< offsetof(struct, member)
+    uint16_t size;      ///< sizeof(member)
+};
+
+/**
+ * @brief True if no two fields share a key hash (checked by JSON_BINDING).
+ */
+constexpr bool jsonFieldHashesDistinct(const JsonField *fields, size_t count, size_t i = 0, size_t j = 1)
+{
+    return i >= count ? true
+           : j >= count ? jsonFieldHashesDistinct(fields, count, i + 1, i + 2)
+                        : fields[i].hash != fields[j].hash && jsonFieldHashesDistinct(fields, count, i, j + 1);
+}
+
+/**
+ * @brief Bind a member under a different JSON key (a string literal).
+ */
+#define JSON_FIELD_KEY(Type, member, jsonKey)                                              \
+    JsonField                                                                              \
+    {                                                                                      \
+        jsonKeyHash(jsonKey), jsonKey, (uint8_t)(sizeof(jsonKey) - 1),                     \
+            JsonFieldKindOf<decltype(Type::member)>::value, (uint16_t)offsetof(Type, member), \
+            (uint16_t)sizeof(Type::member)                                                 \
+    }
+
+/**
+ * @brief Bind a member under its own name.
+ */
+#define JSON_FIELD(Type, member) JSON_FIELD_KEY(Type, member, #member)
+
+/**
+ * @brief Specialize JsonBinding<Type> with the given JSON_FIELD list.
+ * Use at namespace scope, after Type is complete.
+ */
+#define JSON_BINDING(Type, ...)                                                           \
+    template <>                                                                           \
+    struct JsonBinding<Type>                                                              \
+    {                                                                                     \
+        static const JsonField *fields(size_t &count)                                     \
+        {                                                                                 \
+            static constexpr JsonField table[] = {__VA_ARGS__};                           \
+            static_assert(jsonFieldHashesDistinct(table, sizeof(table) / sizeof(table[0])), \
+                          "JSON_BINDING keys collide; rename one with JSON_FIELD_KEY");   \
+            count = sizeof(table) / sizeof(table[0]);                                     \
+            return table;                                                                 \
+        }                                                                                 \
+    }
+
+/**
+ * @brief Field table for T; provide it with JSON_BINDING.
+ */
+template <typename T>
+struct JsonBinding;
+
+/**
+ * @brief Decode one object's members into the fields of base.
+ * Unknown members are skipped; missing ones keep their value; null zeroes.
+ */
+bool jsonDecodeFields(JsonScanner &in, void *base, const JsonField *fields, size_t count);
+
+/**
+ * @brief Write the fields of base as one JSON object.
+ */
+void jsonEncodeFields(JsonStreamWriter &out, const void *base, const JsonField *fields, size_t count);
+
+/**
+ * @class JsonCodec
+ * @brief Reads and writes flat structs as JSON without a JsonDocument.
+ *
+ * The struct's fields are listed once with JSON_BINDING. Keys are compared
+ * through hashes computed at compile time, and values are parsed straight
+ * out of the input into the struct, with strings copied into fixed char
+ * buffers (truncated if too long), so decoding allocates nothing.
+ * Encoding goes through JsonStreamWriter to any Print.
+ *
+ * Example usage:
+ * @code
+ * struct Reading
+ * {
+ *     char probe[16];
+ *     float celsius;
+ *     bool ok;
+ * };
+ * JSON_BINDING(Reading,
+ *              JSON_FIELD(Reading, probe),
+ *              JSON_FIELD_KEY(Reading, celsius, "c"),
+ *              JSON_FIELD(Reading, ok));
+ *
+ * Reading readings[8];
+ * int n = JsonCodec<Reading>::decodeArray(body.c_str(), "results", readings, 8);
+ * JsonCodec<Reading>::encode(Serial, readings[0]);
+ * @endcode
+ */
+template <typename T>
+class JsonCodec
+{
+public:
+    static_assert(std::is_standard_layout<T>::value, "JsonCodec needs a standard-layout struct");
+
+    /**
+     * @brief Decode the object at the scanner's position into out.
+     */
+    static bool decode(JsonScanner &in, T &out)
+    {
+        size_t count;
+        const JsonField *fields = JsonBinding<T>::fields(count);
+        return jsonDecodeFields(in, &out, fields, count);
+    }
+
+    /**
+     * @brief Decode a JSON object text into out.
+     */
+    static bool decode(const char *json, T &out)
+    {
+        JsonScanner in(json);
+        return decode(in, out);
+    }
+
+    /**
+     * @brief Decode each object of an array, one at a time, into a
+     * zero-initialized T and pass it to fn (which returns false to stop).
+     *
+     * @param arrayKey Member of the root object holding the array, or
+     *                 nullptr if the root is the array itself.
+     * @return Objects decoded (0 if the array is missing), or -1 if the
+     *         text is malformed.
+     */
+    template <typename Fn>
+    static int forEach(const char *json, const char *arrayKey, Fn fn)
+    {
+        JsonScanner in(json);
+        if (arrayKey)
+        {
+            if (!in.consume('{'))
+                return -1;
+            if (!in.findMember(arrayKey))
+                return in.failed() ? -1 : 0;
+        }
+        if (!in.consume('['))
+            return in.failed() || !arrayKey ? -1 : 0;
+
+        int decoded = 0;
+        bool first = true;
+        while (in.nextItem(']', first))
+        {
+            if (in.peek() != '{')
+            {
+                if (!in.skipValue())
+                    return -1;
+                continue;
+            }
+
+            T item{};
+            if (!decode(in, item))
+                return -1;
+            decoded++;
+            if (!fn(item))
+                break;
+        }
+        return in.failed() ? -1 : decoded;
+    }
+
+    /**
+     * @brief Decode up to max objects of an array into out[].
+     * @return Objects stored, or -1 if the text is malformed.
+     */
+    static int decodeArray(const char *json, const char *arrayKey, T *out, size_t max)
+    {
+        size_t stored = 0;
+        if (max == 0)
+            return 0;
+        int result = forEach(json, arrayKey, [&](const T &item) {
+            out[stored++] = item;
+            return stored < max;
+        });
+        return result < 0 ? -1 : (int)stored;
+    }
+
+    static void encode(JsonStreamWriter &out, const T &in)
+    {
+        size_t count;
+        const JsonField *fields = JsonBinding<T>::fields(count);
+        jsonEncodeFields(out, &in, fields, count);
+    }
+
+    /**
+     * @brief Write in as a JSON object.
+     * @return Bytes written.
+     */
+    static size_t encode(Print &out, const T &in)
+    {
+        JsonStreamWriter json(out);
+        encode(json, in);
+        return json.bytesWritten();
+    }
+
+    /**
+     * @brief Length of encode()'s output, e.g. for a Content-Length.
+     */
+    static size_t measure(const T &in)
+    {
+        JsonStreamWriter::Counter counter;
+        return encode(counter, in);
+    }
+};
+
+#endif // JSON_CODEC_H
@@ -0,0 +1,69 @@
+#include "JsonDeltaTracker.h"
+
+JsonDeltaTracker::JsonDeltaTracker(uint16_t fullInterval, ArduinoJsonWrapper::Size capacity)
+    : _snapshot(capacity), _body(capacity), _fullInterval(fullInterval)
+{
+}
+
+/**
+ * @brief Patch when one is due and smaller than the state, else full.
+ */
+JsonDeltaTracker::Kind JsonDeltaTracker::prepare(RumpusJsonDocument &state)
+{
+    _pending = UNCHANGED;
+    _cyclesSinceFull++;
+
+    bool fullDue = !_hasSnapshot || (_fullInterval && _cyclesSinceFull >= _fullInterval);
+    if (!fullDue && _body.diff(&_snapshot, &state))
+    {
+        if (_body.variant().size() == 0)
+            return UNCHANGED;
+        if (_body.measure() < state.measure())
+            return _pending = PATCH;
+    }
+
+    // A patch applied to an empty document copies the state, as the receiver will
+    _body.clear();
+    if (!_body.mergePatch(&state))
+        return UNCHANGED;
+    _cyclesSinceFull = 0;
+    return _pending = FULL;
+}
+
+/**
+ * @brief Move the snapshot to what the receiver now holds.
+ */
+void JsonDeltaTracker::acknowledge()
+{
+    if (_pending == FULL)
+    {
+        _snapshot.clear();
+        _hasSnapshot = _snapshot.mergePatch(&_body);
+    }
+    else if (_pending == PATCH)
+    {
+        // A snapshot that no longer fits forces a full document next time
+        _hasSnapshot = _snapshot.mergePatch(&_body);
+    }
+    _pending = UNCHANGED;
+}
+
+void JsonDeltaTracker::reset()
+{
+    _snapshot.clear();
+    _hasSnapshot = false;
+    _pending = UNCHANGED;
+}
+
+const char *JsonDeltaTracker::kindName(Kind kind)
+{
+    switch (kind)
+    {
+    case PATCH:
+        return "patch";
+    case FULL:
+        return "full";
+    default:
+        return "unchanged";
+    }
+}
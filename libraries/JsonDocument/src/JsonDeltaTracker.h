@@ -0,0 +1,92 @@
+#ifndef JSON_DELTA_TRACKER_H
+#define JSON_DELTA_TRACKER_H
+
+#include <Arduino.h>
+#include "ArduinoJsonWrapper.h"
+
+#ifndef JSON_DELTA_FULL_INTERVAL
+#define JSON_DELTA_FULL_INTERVAL 30 ///< Cycles between full snapshots (0 = only when needed)
+#endif
+
+/**
+ * @class JsonDeltaTracker
+ * @brief Decides, each upload cycle, whether to send a full state document,
+ * a merge patch against the last acknowledged one, or nothing.
+ *
+ * prepare() fills body() and says what it holds; acknowledge() is called
+ * once the receiver has confirmed it, which moves the snapshot forward.
+ * Until then every patch is taken against the old snapshot, so a lost
+ * upload is covered by the next one. A full snapshot is sent first, every
+ * fullInterval cycles to resynchronise the receiver, and whenever a patch
+ * would not be smaller.
+ *
+ * The receiver applies patches with mergePatch(), and clears its copy
+ * before applying a full snapshot. Send kindName() along (e.g. as a
+ * header) so it can tell them apart.
+ *
+ * Example usage:
+ * @code
+ * JsonDeltaTracker delta;
+ * JsonDeltaTracker::Kind kind = delta.prepare(status);
+ * if (kind != JsonDeltaTracker::UNCHANGED)
+ * {
+ *     http.addRequestHeader("X-State-Delta", JsonDeltaTracker::kindName(kind));
+ *     http.postDocument("/api/status", delta.body());
+ *     if (http.lastStatusCode() / 100 == 2)
+ *         delta.acknowledge();
+ * }
+ * @endcode
+ */
+class JsonDeltaTracker
+{
+public:
+    enum Kind
+    {
+        UNCHANGED, ///< Nothing to send
+        PATCH,     ///< body() is a merge patch against the acknowledged snapshot
+        FULL       ///< body() is the whole state
+    };
+
+    /**
+     * @param fullInterval Send a full snapshot at least every this many
+     * prepare() calls; 1 always sends full, 0 only when needed.
+     * @param capacity Initial size of the snapshot and body documents.
+     */
+    explicit JsonDeltaTracker(uint16_t fullInterval = JSON_DELTA_FULL_INTERVAL,
+                              ArduinoJsonWrapper::Size capacity = ArduinoJsonWrapper::MEDIUM);
+
+    /**
+     * @brief Compare state with the acknowledged snapshot and fill body().
+     */
+    Kind prepare(RumpusJsonDocument &state);
+
+    /**
+     * @brief Document to upload after prepare().
+     */
+    ArduinoJsonWrapper &body() { return _body; }
+
+    /**
+     * @brief The last prepared body was received; it becomes the snapshot.
+     */
+    void acknowledge();
+
+    /**
+     * @brief Forget the snapshot; the next prepare() sends a full document.
+     */
+    void reset();
+
+    void setFullInterval(uint16_t cycles) { _fullInterval = cycles; }
+    uint16_t fullInterval() const { return _fullInterval; }
+
+    static const char *kindName(Kind kind);
+
+private:
+    ArduinoJsonWrapper _snapshot;
+    ArduinoJsonWrapper _body;
+    uint16_t _fullInterval;
+    uint16_t _cyclesSinceFull = 0;
+    bool _hasSnapshot = false;
+    Kind _pending = UNCHANGED;
+};
+
+#endif // JSON_DELTA_TRACKER_H
@@ -0,0 +1,159 @@
+#include "JsonDocumentPool.h"
+
+JsonDocumentPool::JsonDocumentPool(uint8_t maxFreePerClass)
+    : _maxFree(maxFreePerClass)
+{
+}
+
+JsonDocumentPool::~JsonDocumentPool()
+{
+    for (uint8_t cls = 0; cls < CLASS_COUNT; cls++)
+    {
+        for (DynamicJsonDocument *doc : _free[cls])
+            delete doc;
+    }
+}
+
+size_t JsonDocumentPool::classSize(uint8_t cls)
+{
+    return cls < CLASS_COUNT ? (size_t)128 << cls : 0;
+}
+
+uint8_t JsonDocumentPool::classFor(size_t capacity)
+{
+    for (uint8_t cls = 0; cls < CLASS_COUNT; cls++)
+    {
+        if (capacity <= classSize(cls))
+            return cls;
+    }
+    return NO_CLASS;
+}
+
+/**
+ * @brief Fill the free list so later acquire() calls do not allocate.
+ */
+void JsonDocumentPool::reserve(size_t capacity, uint8_t count)
+{
+    uint8_t cls = classFor(capacity);
+    if (cls == NO_CLASS)
+        return;
+
+    while (_free[cls].size() < count)
+    {
+        _free[cls].push_back(new DynamicJsonDocument(classSize(cls)));
+        _stats[cls].allocations++;
+    }
+    if (_maxFree < count)
+        _maxFree = count;
+}
+
+DynamicJsonDocument *JsonDocumentPool::acquire(size_t minCapacity)
+{
+    uint8_t cls = classFor(minCapacity);
+    if (cls == NO_CLASS)
+    {
+        _oversize++;
+        return new DynamicJsonDocument(minCapacity);
+    }
+
+    ClassStats &s = _stats[cls];
+    s.acquisitions++;
+    if (++s.inUse > s.peakInUse)
+        s.peakInUse = s.inUse;
+
+    if (!_free[cls].empty())
+    {
+        DynamicJsonDocument *doc = _free[cls].back();
+        _free[cls].pop_back();
+        return doc;
+    }
+
+    s.allocations++;
+    return new DynamicJsonDocument(classSize(cls));
+}
+
+/**
+ * @brief Clear the document and keep it for reuse, unless the free list
+ * is full or the document is not one of ours (oversize, or resized).
+ */
+void JsonDocumentPool::release(DynamicJsonDocument *doc)
+{
+    if (!doc)
+        return;
+
+    uint8_t cls = classFor(doc->capacity());
+    if (cls == NO_CLASS)
+    {
+        delete doc;
+        return;
+    }
+
+    if (_stats[cls].inUse > 0)
+        _stats[cls].inUse--;
+
+    // No longer its class size (e.g. shrunk by the caller): not reusable
+    if (doc->capacity() != classSize(cls))
+    {
+        delete doc;
+        return;
+    }
+
+    recordUsage(cls, doc);
+
+    if (_free[cls].size() >= _maxFree)
+    {
+        delete doc;
+        return;
+    }
+    doc->clear();
+    _free[cls].push_back(doc);
+}
+
+DynamicJsonDocument *JsonDocumentPool::grow(DynamicJsonDocument *doc)
+{
+    uint8_t cls = classFor(doc->capacity());
+    if (cls == NO_CLASS || cls + 1 >= CLASS_COUNT)
+        return nullptr;
+
+    _stats[cls].overflows++;
+    DynamicJsonDocument *bigger = acquire(classSize(cls + 1));
+    if (!bigger || bigger->capacity() < classSize(cls + 1))
+    {
+        // Out of memory: keep doc and its contents
+        release(bigger);
+        return nullptr;
+    }
+    bigger->set(*doc);
+    release(doc);
+    return bigger;
+}
+
+void JsonDocumentPool::report(Print &out) const
+{
+    for (uint8_t cls = 0; cls < CLASS_COUNT; cls++)
+    {
+        const ClassStats &s = _stats[cls];
+        out.print("[JsonDocumentPool] ");
+        out.print((unsigned long)classSize(cls));
+        out.print("B inUse=");
+        out.print(s.inUse);
+        out.print(" peakInUse=");
+        out.print(s.peakInUse);
+        out.print(" peakUsage=");
+        out.print((unsigned long)s.peakUsage);
+        out.print(" acquired=");
+        out.print((unsigned long)s.acquisitions);
+        out.print(" allocated=");
+        out.print((unsigned long)s.allocations);
+        out.print(" overflows=");
+        out.println((unsigned long)s.overflows);
+    }
+    out.print("[JsonDocumentPool] oversize=");
+    out.println((unsigned long)_oversize);
+}
+
+void JsonDocumentPool::recordUsage(uint8_t cls, const DynamicJsonDocument *doc)
+{
+    if (doc->memoryUsage() > _stats[cls].peakUsage)
+        _stats[cls].peakUsage = doc->memoryUsage();
+}
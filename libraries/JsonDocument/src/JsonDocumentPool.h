@@ -0,0 +1,169 @@
+#ifndef JSON_DOCUMENT_POOL_H
+#define JSON_DOCUMENT_POOL_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <vector>
+
+/**
+ * @class JsonDocumentPool
+ * @brief Recycles DynamicJsonDocuments in a few fixed size classes.
+ *
+ * acquire() hands out a cleared document from the smallest class that fits,
+ * reusing a released one when available, so building one log message after
+ * another does not hit the heap each time. grow() moves a document that
+ * overflowed into the next class up. Per-class statistics record how many
+ * documents were in use at once and the largest memoryUsage() seen, which
+ * shows which classes are worth pre-reserving and which are oversized.
+ *
+ * Requests above the largest class get an exact-size document that is freed
+ * on release instead of being pooled.
+ *
+ * Example usage:
+ * @code
+ * JsonDocumentPool pool;
+ * pool.reserve(256, 2);
+ * {
+ *     JsonDocumentPool::Lease doc = pool.lease(200);
+ *     (*doc)["level"] = "info";
+ *     serializeJson(*doc, Serial);
+ * } // returned to the pool
+ * pool.report(Serial);
+ * @endcode
+ */
+class JsonDocumentPool
+{
+public:
+    static constexpr uint8_t CLASS_COUNT = 5;
+    static constexpr uint8_t NO_CLASS = 0xFF;
+
+    /**
+     * @brief Usage statistics for one size class.
+     */
+    struct ClassStats
+    {
+        uint16_t inUse = 0;        ///< Documents currently handed out
+        uint16_t peakInUse = 0;    ///< High-water mark of inUse
+        size_t peakUsage = 0;      ///< Largest memoryUsage() seen at release or grow
+        uint32_t acquisitions = 0; ///< acquire() calls served by this class
+        uint32_t allocations = 0;  ///< Documents newly allocated for this class
+        uint32_t overflows = 0;    ///< Documents grown out of this class
+    };
+
+    /**
+     * @class Lease
+     * @brief RAII handle that returns its document to the pool when destroyed.
+     */
+    class Lease
+    {
+    public:
+        Lease() = default;
+        Lease(JsonDocumentPool &pool, DynamicJsonDocument *doc) : _pool(&pool), _doc(doc) {}
+        Lease(Lease &&other) : _pool(other._pool), _doc(other._doc) { other._doc = nullptr; }
+        Lease &operator=(Lease &&other)
+        {
+            if (this != &other)
+            {
+                reset();
+                _pool = other._pool;
+                _doc = other._doc;
+                other._doc = nullptr;
+            }
+            return *this;
+        }
+        Lease(const Lease &) = delete;
+        Lease &operator=(const Lease &) = delete;
+        ~Lease() { reset(); }
+
+        DynamicJsonDocument &operator*() const { return *_doc; }
+        DynamicJsonDocument *operator->() const { return _doc; }
+        DynamicJsonDocument *get() const { return _doc; }
+        explicit operator bool() const { return _doc != nullptr; }
+
+        /**
+         * @brief Move the contents into the next size class.
+         * @return false if already in the largest class, out of memory, or no pool.
+         */
+        bool grow()
+        {
+            DynamicJsonDocument *bigger = _pool && _doc ? _pool->grow(_doc) : nullptr;
+            if (!bigger)
+                return false;
+            _doc = bigger;
+            return true;
+        }
+
+        void reset()
+        {
+            if (_pool && _doc)
+                _pool->release(_doc);
+            _doc = nullptr;
+        }
+
+    private:
+        JsonDocumentPool *_pool = nullptr;
+        DynamicJsonDocument *_doc = nullptr;
+    };
+
+    /**
+     * @param maxFreePerClass Released documents kept per class; extras are freed.
+     */
+    explicit JsonDocumentPool(uint8_t maxFreePerClass = 2);
+    ~JsonDocumentPool();
+
+    JsonDocumentPool(const JsonDocumentPool &) = delete;
+    JsonDocumentPool &operator=(const JsonDocumentPool &) = delete;
+
+    /**
+     * @brief Capacity of a size class (128, 256, 512, 1024, 2048).
+     */
+    static size_t classSize(uint8_t cls);
+
+    /**
+     * @brief Smallest class holding at least capacity bytes, or NO_CLASS.
+     */
+    static uint8_t classFor(size_t capacity);
+
+    /**
+     * @brief Pre-allocate count documents in the class that fits capacity.
+     */
+    void reserve(size_t capacity, uint8_t count);
+
+    /**
+     * @brief Cleared document with at least minCapacity bytes.
+     * Give it back with release() (or use lease()).
+     */
+    DynamicJsonDocument *acquire(size_t minCapacity = 0);
+
+    /**
+     * @brief Return a document from acquire()/grow() to the pool.
+     */
+    void release(DynamicJsonDocument *doc);
+
+    /**
+     * @brief Copy doc into the next size class and release doc.
+     * @return The new document, or nullptr (doc untouched) if none is larger
+     * or it could not be allocated.
+     */
+    DynamicJsonDocument *grow(DynamicJsonDocument *doc);
+
+    Lease lease(size_t minCapacity = 0) { return Lease(*this, acquire(minCapacity)); }
+
+    const ClassStats &stats(uint8_t cls) const { return _stats[cls < CLASS_COUNT ? cls : 0]; }
+    uint32_t oversizeAcquisitions() const { return _oversize; }
+
+    /**
+     * @brief Print one line of statistics per size class.
+     */
+    void report(Print &out) const;
+
+private:
+    uint8_t _maxFree;
+    std::vector<DynamicJsonDocument *> _free[CLASS_COUNT];
+    ClassStats _stats[CLASS_COUNT];
+    uint32_t _oversize = 0;
+
+    void recordUsage(uint8_t cls, const DynamicJsonDocument *doc);
+};
+
+#endif // JSON_DOCUMENT_POOL_H
@@ -0,0 +1,133 @@
+#include "JsonMergePatch.h"
+#include <string.h>
+
+// ArduinoJson stores const char * keys by pointer; char * makes it copy them,
+// which is needed when the key belongs to another document.
+static char *ownedKey(JsonString key)
+{
+    return const_cast<char *>(key.c_str());
+}
+
+bool JsonMergePatch::diff(JsonVariantConst from, JsonVariantConst to, JsonVariant patch)
+{
+    if (from.is<JsonObjectConst>() && to.is<JsonObjectConst>())
+        return diffObjects(from.as<JsonObjectConst>(), to.as<JsonObjectConst>(), patch.to<JsonObject>());
+
+    patch.clear();
+    if (equal(from, to))
+        return false;
+    patch.set(to);
+    return true;
+}
+
+/**
+ * @brief Members removed from 'from' become null; changed members are
+ * copied, or diffed recursively when both sides are objects.
+ */
+bool JsonMergePatch::diffObjects(JsonObjectConst from, JsonObjectConst to, JsonObject patch)
+{
+    for (JsonPairConst member : from)
+    {
+        if (!member.value().isNull() && to[member.key().c_str()].isNull())
+            patch[ownedKey(member.key())] = (const char *)nullptr;
+    }
+
+    for (JsonPairConst member : to)
+    {
+        JsonVariantConst value = member.value();
+        JsonVariantConst old = from[member.key().c_str()];
+        if (value.isNull() || equal(old, value))
+            continue;
+
+        // Only allocate a nested patch once something below is known to differ
+        if (old.is<JsonObjectConst>() && value.is<JsonObjectConst>())
+            diffObjects(old.as<JsonObjectConst>(), value.as<JsonObjectConst>(),
+                        patch.createNestedObject(ownedKey(member.key())));
+        else
+            patch[ownedKey(member.key())].set(value);
+    }
+    return patch.size() > 0;
+}
+
+void JsonMergePatch::apply(JsonVariant target, JsonVariantConst patch)
+{
+    if (!patch.is<JsonObjectConst>())
+    {
+        target.set(patch);
+        return;
+    }
+
+    JsonObject object = target.is<JsonObject>() ? target.as<JsonObject>() : target.to<JsonObject>();
+    applyObject(object, patch.as<JsonObjectConst>());
+}
+
+void JsonMergePatch::applyObject(JsonObject target, JsonObjectConst patch)
+{
+    for (JsonPairConst member : patch)
+    {
+        const char *key = member.key().c_str();
+        JsonVariantConst value = member.value();
+        if (value.isNull())
+        {
+            target.remove(key);
+        }
+        else if (value.is<JsonObjectConst>())
+        {
+            JsonObject child = target[key].is<JsonObject>() ? target[key].as<JsonObject>()
+                                                            : target.createNestedObject(ownedKey(member.key()));
+            applyObject(child, value.as<JsonObjectConst>());
+        }
+        else
+        {
+            target[ownedKey(member.key())].set(value);
+        }
+    }
+}
+
+bool JsonMergePatch::equal(JsonVariantConst a, JsonVariantConst b)
+{
+    if (a.isNull() || b.isNull())
+        return a.isNull() && b.isNull();
+
+    if (a.is<JsonObjectConst>() || b.is<JsonObjectConst>())
+    {
+        if (!a.is<JsonObjectConst>() || !b.is<JsonObjectConst>())
+            return false;
+        JsonObjectConst objectA = a.as<JsonObjectConst>();
+        JsonObjectConst objectB = b.as<JsonObjectConst>();
+        if (objectA.size() != objectB.size())
+            return false;
+        for (JsonPairConst member : objectA)
+        {
+            if (!equal(member.value(), objectB[member.key().c_str()]))
+                return false;
+        }
+        return true;
+    }
+
+    if (a.is<JsonArrayConst>() || b.is<JsonArrayConst>())
+    {
+        if (!a.is<JsonArrayConst>() || !b.is<JsonArrayConst>())
+            return false;
+        JsonArrayConst arrayA = a.as<JsonArrayConst>();
+        JsonArrayConst arrayB = b.as<JsonArrayConst>();
+        if (arrayA.size() != arrayB.size())
+            return false;
+        JsonArrayConst::iterator elementB = arrayB.begin();
+        for (JsonVariantConst elementA : arrayA)
+        {
+            if (!equal(elementA, *elementB))
+                return false;
+            ++elementB;
+        }
+        return true;
+    }
+
+    if (a.is<const char *>() || b.is<const char *>())
+        return a.is<const char *>() && b.is<const char *>() && strcmp(a.as<const char *>(), b.as<const char *>()) == 0;
+    if (a.is<bool>() || b.is<bool>())
+        return a.is<bool>() && b.is<bool>() && a.as<bool>() == b.as<bool>();
+    if (a.is<long long>() && b.is<long long>())
+        return a.as<long long>() == b.as<long long>();
+    return a.is<double>() && b.is<double>() && a.as<double>() == b.as<double>();
+}
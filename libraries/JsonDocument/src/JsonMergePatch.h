@@ -0,0 +1,51 @@
+#ifndef JSON_MERGE_PATCH_H
+#define JSON_MERGE_PATCH_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+/**
+ * @class JsonMergePatch
+ * @brief JSON Merge Patch (RFC 7386) over ArduinoJson variants.
+ *
+ * A patch is a JSON value shaped like the target: object members are
+ * merged recursively, a null member removes the key, and anything else
+ * (including arrays) replaces the old value. Because null means "remove",
+ * null values in a document do not survive a diff()/apply() round-trip.
+ *
+ * Example usage:
+ * @code
+ * DynamicJsonDocument patch(256);
+ * if (JsonMergePatch::diff(lastSent, current, patch.as<JsonVariant>()))
+ *     serializeJson(patch, Serial); // e.g. {"uptime":1830,"wifi":{"rssi":-61}}
+ * JsonMergePatch::apply(remote.as<JsonVariant>(), patch);
+ * @endcode
+ */
+class JsonMergePatch
+{
+public:
+    /**
+     * @brief Write into patch the merge patch that turns from into to.
+     * patch is overwritten; check its document's overflowed() afterwards.
+     * @return true if the two values differ (patch is non-empty).
+     */
+    static bool diff(JsonVariantConst from, JsonVariantConst to, JsonVariant patch);
+
+    /**
+     * @brief Apply patch to target in place.
+     * Applying the same patch twice gives the same result, so a write that
+     * overflowed can be retried after growing the document.
+     */
+    static void apply(JsonVariant target, JsonVariantConst patch);
+
+    /**
+     * @brief Deep equality; integers and floats compare by value.
+     */
+    static bool equal(JsonVariantConst a, JsonVariantConst b);
+
+private:
+    static bool diffObjects(JsonObjectConst from, JsonObjectConst to, JsonObject patch);
+    static void applyObject(JsonObject target, JsonObjectConst patch);
+};
+
+#endif // JSON_MERGE_PATCH_H
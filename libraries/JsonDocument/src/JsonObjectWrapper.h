@@ -0,0 +1,126 @@
+#ifndef JSON_OBJECT_WRAPPER_H
+#define JSON_OBJECT_WRAPPER_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "ArduinoJsonBacked.h"
+#include "ArduinoJsonWrapper.h"
+#include "JsonViews.h"
+#include "JsonArrayWrapper.h"
+#include <vector>
+
+/**
+ * @class JsonObjectWrapper
+ * @brief RumpusJsonDocument adapter over an object inside an ArduinoJsonWrapper.
+ *
+ * Returned by ArduinoJsonWrapper::getObject(). The adapter owns no JSON
+ * memory: it keeps the owner and the key path, and finds the object again
+ * on every call, so it stays valid when the owner grows and its writes grow
+ * the owner like the owner's own set(). The owner must outlive it.
+ *
+ * Built over a bare JsonObjectView instead, it writes through that view
+ * and cannot grow anything.
+ */
+class JsonObjectWrapper : public ArduinoJsonBacked
+{
+public:
+    JsonObjectWrapper(ArduinoJsonWrapper &owner, std::vector<String> path)
+        : _owner(&owner), _path(std::move(path)) {}
+    explicit JsonObjectWrapper(JsonObjectView view) : _view(view) {}
+    ~JsonObjectWrapper() override = default;
+
+    using RumpusJsonDocument::set;
+
+    bool set(const char *key, const char *value) override { return put(key, value); }
+    bool set(const char *key, int value) override { return put(key, value); }
+    bool set(const char *key, bool value) override { return put(key, value); }
+    bool set(const char *key, float value) override { return put(key, value); }
+    bool set(const char *key, double value) override { return put(key, value); }
+    bool set(const char *key, int64_t value) override { return put(key, value); }
+    bool set(const char *key, uint32_t value) override { return put(key, value); }
+
+    bool set(const char *key, RumpusJsonDocument *value) override
+    {
+        if (!value)
+            return false;
+
+        const ArduinoJsonBacked *native = ArduinoJsonBacked::fromDocument(value);
+        if (native)
+            return put(key, native->variant());
+
+        DynamicJsonDocument temp = ArduinoJsonBacked::parseForeign(*value);
+        if (temp.isNull())
+            return false;
+        return put(key, temp.as<JsonVariantConst>());
+    }
+
+    RumpusJsonDocument *getObject(const char *key) override
+    {
+        if (!_owner)
+            return new JsonObjectWrapper(_view.object(key));
+        return new JsonObjectWrapper(*_owner, childPath(key));
+    }
+
+    RumpusJsonDocument *getArray(const char *key) override
+    {
+        if (!_owner)
+            return new JsonArrayWrapper(_view.array(key));
+        return new JsonArrayWrapper(*_owner, childPath(key));
+    }
+
+    String serialize() override
+    {
+        String output;
+        serializeJson(variant(), output);
+        return output;
+    }
+
+    void clear() override
+    {
+        write([&]
+              { view().clear(); });
+    }
+
+    JsonVariantConst variant() const override
+    {
+        return _owner ? _owner->variantAt(_path, _path.size()) : JsonVariantConst(_view.raw());
+    }
+
+    /**
+     * @brief The object as it is now, created if missing; valid until the
+     * owner next grows.
+     */
+    JsonObjectView view() { return _owner ? _owner->objectAt(_path, _path.size()) : _view; }
+
+private:
+    ArduinoJsonWrapper *_owner = nullptr; ///< Document the object lives in, if any
+    std::vector<String> _path;            ///< Keys from the owner's root to the object
+    JsonObjectView _view;                 ///< Used instead when there is no owner
+
+    template <typename T>
+    bool put(const char *key, T value)
+    {
+        bool stored = false;
+        write([&]
+              { stored = view().set(key, value); });
+        return stored;
+    }
+
+    template <typename Fn>
+    void write(Fn fn)
+    {
+        if (_owner)
+            _owner->write(fn);
+        else
+            fn();
+    }
+
+    std::vector<String> childPath(const char *key) const
+    {
+        std::vector<String> path = _path;
+        path.push_back(String(key));
+        return path;
+    }
+};
+
+#endif // JSON_OBJECT_WRAPPER_H
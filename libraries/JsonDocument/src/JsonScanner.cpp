@@ -0,0 +1,457 @@
+#include "JsonScanner.h"
+#include <stdlib.h>
+#include <string.h>
+
+bool JsonScanner::Key::equals(const char *name, size_t nameLength) const
+{
+    return length == nameLength && memcmp(start, name, length) == 0;
+}
+
+char JsonScanner::peek()
+{
+    if (_failed)
+        return '\0';
+    skipWhitespace();
+    return *_p;
+}
+
+bool JsonScanner::consume(char c)
+{
+    if (peek() != c || c == '\0')
+        return false;
+    _p++;
+    return true;
+}
+
+bool JsonScanner::nextItem(char close, bool &first)
+{
+    if (_failed || consume(close))
+        return false;
+    if (!first && !consume(','))
+        return fail();
+    first = false;
+    return true;
+}
+
+bool JsonScanner::readKey(Key &key)
+{
+    if (peek() != '"')
+        return fail();
+    _p++;
+
+    key.start = _p;
+    key.hash = JSON_KEY_HASH_SEED;
+    for (;;)
+    {
+        char c = *_p;
+        if (c == '\0')
+            return fail();
+        if (c == '"')
+            break;
+        key.hash = (uint32_t)((key.hash ^ (uint8_t)c) * JSON_KEY_HASH_PRIME);
+        _p++;
+        // Escaped characters are hashed as written; only the quote matters here
+        if (c == '\\' && *_p)
+        {
+            key.hash = (uint32_t)((key.hash ^ (uint8_t)*_p) * JSON_KEY_HASH_PRIME);
+            _p++;
+        }
+    }
+    key.length = _p - key.start;
+    _p++;
+
+    return consume(':') || fail();
+}
+
+bool JsonScanner::findMember(const char *name)
+{
+    size_t length = strlen(name);
+    bool first = true;
+    while (nextItem('}', first))
+    {
+        Key key;
+        if (!readKey(key))
+            return false;
+        if (key.equals(name, length))
+            return true;
+        if (!skipValue())
+            return false;
+    }
+    return false;
+}
+
+bool JsonScanner::readText(char *dst, size_t size)
+{
+    if (size > 0)
+        dst[0] = '\0';
+
+    switch (peek())
+    {
+    case '"':
+        return readString(dst, size);
+    case '{':
+    case '[':
+        return skipValue();
+    case 'n':
+        return readLiteral(nullptr, 0);
+    default:
+        return readLiteral(dst, size);
+    }
+}
+
+bool JsonScanner::readInteger(long &value)
+{
+    if (peek() == '{' || peek() == '[')
+    {
+        skipValue();
+        return false;
+    }
+
+    char buf[32];
+    bool quoted = peek() == '"';
+    if (!(quoted ? readString(buf, sizeof(buf)) : readLiteral(buf, sizeof(buf))))
+        return false;
+    if (!quoted && strcmp(buf, "null") == 0)
+    {
+        value = 0;
+        return true;
+    }
+
+    char *end;
+    long v = strtol(buf, &end, 10);
+    if (*end == '.' || *end == 'e' || *end == 'E')
+        v = (long)strtod(buf, &end);
+    if (end == buf || *end != '\0')
+        return false;
+    value = v;
+    return true;
+}
+
+bool JsonScanner::readUnsigned(unsigned long &value)
+{
+    long v;
+    if (peek() == '-' || peek() == '{' || peek() == '[')
+    {
+        // Negative values and containers do not fit; consume and reject
+        readInteger(v);
+        return false;
+    }
+
+    char buf[32];
+    bool quoted = peek() == '"';
+    if (!(quoted ? readString(buf, sizeof(buf)) : readLiteral(buf, sizeof(buf))))
+        return false;
+    if (!quoted && strcmp(buf, "null") == 0)
+    {
+        value = 0;
+        return true;
+    }
+
+    char *end;
+    unsigned long u = strtoul(buf, &end, 10);
+    if (*end == '.' || *end == 'e' || *end == 'E')
+        u = (unsigned long)strtod(buf, &end);
+    if (end == buf || *end != '\0' || buf[0] == '-')
+        return false;
+    value = u;
+    return true;
+}
+
+bool JsonScanner::readNumber(double &value)
+{
+    if (peek() == '{' || peek() == '[')
+    {
+        skipValue();
+        return false;
+    }
+
+    char buf[32];
+    bool quoted = peek() == '"';
+    if (!(quoted ? readString(buf, sizeof(buf)) : readLiteral(buf, sizeof(buf))))
+        return false;
+    if (!quoted && strcmp(buf, "null") == 0)
+    {
+        value = 0;
+        return true;
+    }
+
+    char *end;
+    double v = strtod(buf, &end);
+    if (end == buf || *end != '\0')
+        return false;
+    value = v;
+    return true;
+}
+
+bool JsonScanner::readBool(bool &value)
+{
+    char buf[32];
+    if (peek() == '"' || peek() == '{' || peek() == '[')
+    {
+        skipValue();
+        return false;
+    }
+    if (!readLiteral(buf, sizeof(buf)))
+        return false;
+
+    if (strcmp(buf, "true") == 0)
+        value = true;
+    else if (strcmp(buf, "false") == 0 || strcmp(buf, "null") == 0)
+        value = false;
+    else
+    {
+        char *end;
+        double v = strtod(buf, &end);
+        if (end == buf || *end != '\0')
+            return false;
+        value = v != 0;
+    }
+    return true;
+}
+
+bool JsonScanner::skipValue()
+{
+    char c = peek();
+    if (c == '"')
+        return readString(nullptr, 0);
+    if (c != '{' && c != '[')
+        return readLiteral(nullptr, 0);
+
+    int depth = 0;
+    do
+    {
+        c = *_p;
+        if (c == '\0')
+            return fail();
+        if (c == '"')
+        {
+            if (!readString(nullptr, 0))
+                return false;
+            continue;
+        }
+        if (c == '{' || c == '[')
+            depth++;
+        else if (c == '}' || c == ']')
+            depth--;
+        _p++;
+    } while (depth > 0);
+    return true;
+}
+
+bool JsonScanner::fail()
+{
+    _failed = true;
+    return false;
+}
+
+void JsonScanner::skipWhitespace()
+{
+    while (*_p == ' ' || *_p == '\t' || *_p == '\n' || *_p == '\r')
+        _p++;
+}
+
+// Expects the opening quote at _p. With dst == nullptr the string is only skipped.
+bool JsonScanner::readString(char *dst, size_t size)
+{
+    _p++;
+    size_t len = 0;
+    bool full = size == 0;
+
+    for (;;)
+    {
+        char utf8[4];
+        uint8_t n = 1;
+        char c = *_p++;
+
+        if (c == '\0')
+        {
+            _p--;
+            return fail();
+        }
+        if (c == '"')
+            break;
+
+        utf8[0] = c;
+        if (c == '\\')
+        {
+            char e = *_p++;
+            switch (e)
+            {
+            case '"':
+            case '\\':
+            case '/':
+                utf8[0] = e;
+                break;
+            case 'b':
+                utf8[0] = '\b';
+                break;
+            case 'f':
+                utf8[0] = '\f';
+                break;
+            case 'n':
+                utf8[0] = '\n';
+                break;
+            case 'r':
+                utf8[0] = '\r';
+                break;
+            case 't':
+                utf8[0] = '\t';
+                break;
+            case 'u':
+            {
+                uint32_t cp;
+                if (!readCodePoint(cp))
+                    return false;
+                if (cp < 0x80)
+                {
+                    utf8[0] = (char)cp;
+                }
+                else if (cp < 0x800)
+                {
+                    utf8[0] = (char)(0xC0 | (cp >> 6));
+                    utf8[1] = (char)(0x80 | (cp & 0x3F));
+                    n = 2;
+                }
+                else if (cp < 0x10000)
+                {
+                    utf8[0] = (char)(0xE0 | (cp >> 12));
+                    utf8[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+                    utf8[2] = (char)(0x80 | (cp & 0x3F));
+                    n = 3;
+                }
+                else
+                {
+                    utf8[0] = (char)(0xF0 | (cp >> 18));
+                    utf8[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+                    utf8[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+                    utf8[3] = (char)(0x80 | (cp & 0x3F));
+                    n = 4;
+                }
+                break;
+            }
+            default:
+                _p--;
+                return fail();
+            }
+        }
+
+        // Never split a multi-byte character when truncating
+        if (!full && len + n < size)
+        {
+            memcpy(dst + len, utf8, n);
+            len += n;
+        }
+        else
+        {
+            full = true;
+        }
+    }
+
+    if (size > 0)
+        dst[len] = '\0';
+    return true;
+}
+
+// true, false, null or a number in JSON syntax
+static bool isLiteral(const char *s, size_t len)
+{
+    if ((len == 4 && (strncmp(s, "true", 4) == 0 || strncmp(s, "null", 4) == 0)) ||
+        (len == 5 && strncmp(s, "false", 5) == 0))
+        return true;
+
+    const char *end = s + len;
+    auto digits = [&s, end]()
+    {
+        const char *from = s;
+        while (s < end && *s >= '0' && *s <= '9')
+            s++;
+        return s > from;
+    };
+
+    if (s < end && *s == '-')
+        s++;
+    if (!digits())
+        return false;
+    if (s < end && *s == '.')
+    {
+        s++;
+        if (!digits())
+            return false;
+    }
+    if (s < end && (*s == 'e' || *s == 'E'))
+    {
+        s++;
+        if (s < end && (*s == '+' || *s == '-'))
+            s++;
+        if (!digits())
+            return false;
+    }
+    return s == end;
+}
+
+// Number, true, false or null, copied as written (truncated to size - 1)
+bool JsonScanner::readLiteral(char *dst, size_t size)
+{
+    const char *start = _p;
+    while (*_p && !strchr(",:}] \t\r\n\"{[", *_p))
+        _p++;
+
+    size_t len = _p - start;
+    if (!isLiteral(start, len))
+    {
+        _p = start;
+        return fail();
+    }
+
+    if (size > 0)
+    {
+        if (len > size - 1)
+            len = size - 1;
+        memcpy(dst, start, len);
+        dst[len] = '\0';
+    }
+    return true;
+}
+
+// After "\u": four hex digits, combining a UTF-16 surrogate pair if present
+bool JsonScanner::readCodePoint(uint32_t &cp)
+{
+    auto hex4 = [this](uint32_t &out) {
+        out = 0;
+        for (uint8_t i = 0; i < 4; i++)
+        {
+            char c = *_p;
+            uint8_t digit;
+            if (c >= '0' && c <= '9')
+                digit = c - '0';
+            else if (c >= 'a' && c <= 'f')
+                digit = c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F')
+                digit = c - 'A' + 10;
+            else
+                return false;
+            out = (out << 4) | digit;
+            _p++;
+        }
+        return true;
+    };
+
+    if (!hex4(cp))
+        return fail();
+
+    if (cp >= 0xD800 && cp <= 0xDBFF && _p[0] == '\\' && _p[1] == 'u')
+    {
+        const char *save = _p;
+        uint32_t low;
+        _p += 2;
+        if (hex4(low) && low >= 0xDC00 && low <= 0xDFFF)
+        {
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+            return true;
+        }
+        _p = save;
+    }
+    if (cp >= 0xD800 && cp <= 0xDFFF)
+        cp = 0xFFFD; // lone surrogate
+    return true;
+}
@@ -0,0 +1,138 @@
+#ifndef JSON_SCANNER_H
+#define JSON_SCANNER_H
+
+#include <Arduino.h>
+
+/// FNV-1a offset basis / prime used for object keys
+#define JSON_KEY_HASH_SEED 2166136261UL
+#define JSON_KEY_HASH_PRIME 16777619UL
+
+/**
+ * @brief FNV-1a hash of a key; usable at compile time.
+ */
+constexpr uint32_t jsonKeyHash(const char *key, uint32_t hash = JSON_KEY_HASH_SEED)
+{
+    return *key ? jsonKeyHash(key + 1, (uint32_t)((hash ^ (uint8_t)*key) * JSON_KEY_HASH_PRIME)) : hash;
+}
+
+/**
+ * @class JsonScanner
+ * @brief Pull reader over a NUL-terminated JSON text, with no document.
+ *
+ * Values are read (or skipped) one at a time, straight out of the input
+ * buffer: strings are unescaped into caller-provided char buffers and keys
+ * are hashed while they are scanned, so nothing is allocated. Any syntax
+ * error sets failed() and makes every later call return false.
+ *
+ * Example usage:
+ * @code
+ * JsonScanner in(json.c_str());
+ * bool first = true;
+ * in.consume('{');
+ * while (in.nextItem('}', first))
+ * {
+ *     JsonScanner::Key key;
+ *     if (!in.readKey(key))
+ *         break;
+ *     if (key.hash == jsonKeyHash("name"))
+ *         in.readText(name, sizeof(name));
+ *     else
+ *         in.skipValue();
+ * }
+ * @endcode
+ */
+class JsonScanner
+{
+public:
+    /**
+     * @brief An object key as it appears in the input (escapes not decoded).
+     */
+    struct Key
+    {
+        const char *start = nullptr;
+        size_t length = 0;
+        uint32_t hash = JSON_KEY_HASH_SEED;
+
+        bool equals(const char *name, size_t nameLength) const;
+    };
+
+    explicit JsonScanner(const char *json) : _begin(json), _p(json ? json : "") {}
+
+    /**
+     * @brief Next significant character, or '\0' at the end or after an error.
+     */
+    char peek();
+
+    /**
+     * @brief Skip c if it is the next significant character.
+     */
+    bool consume(char c);
+
+    /**
+     * @brief Step to the next item of the open object/array.
+     * Call with first = true before the loop; handles the ',' separators.
+     * @return false at the closing character (consumed) or on error.
+     */
+    bool nextItem(char close, bool &first);
+
+    /**
+     * @brief Read "key": and leave the scanner on the value.
+     */
+    bool readKey(Key &key);
+
+    /**
+     * @brief Inside an object just opened with '{', move to the value of name.
+     * Members before it are skipped.
+     * @return false if the object has no such member (or on error).
+     */
+    bool findMember(const char *name);
+
+    /**
+     * @brief Read a string into dst, unescaping and truncating to size - 1.
+     * Numbers and true/false are copied as their literal text, null gives "".
+     */
+    bool readText(char *dst, size_t size);
+
+    /**
+     * @brief Read an integer (a quoted number is accepted too).
+     * An object or array is skipped and gives false, as for any wrong type.
+     */
+    bool readInteger(long &value);
+    bool readUnsigned(unsigned long &value);
+    bool readNumber(double &value);
+
+    /**
+     * @brief Read true/false; numbers are true when non-zero.
+     */
+    bool readBool(bool &value);
+
+    /**
+     * @brief Skip over one complete value, including nested containers.
+     */
+    bool skipValue();
+
+    bool failed() const { return _failed; }
+
+    /**
+     * @brief Position in the input, e.g. where an error was detected.
+     */
+    size_t offset() const { return _p - _begin; }
+
+    /**
+     * @brief Current read pointer; after peek() it is the start of the next value.
+     */
+    const char *position() const { return _p; }
+
+private:
+    const char *_begin;
+    const char *_p;
+    bool _failed = false;
+
+    bool fail();
+    void skipWhitespace();
+    bool readString(char *dst, size_t size);
+    bool readLiteral(char *dst, size_t size);
+    bool readCodePoint(uint32_t &cp);
+};
+
+#endif // JSON_SCANNER_H
@@ -0,0 +1,280 @@
+#include "JsonSelector.h"
+#include <stdlib.h>
+#include <string.h>
+
+bool JsonMatch::text(char *dst, size_t size) const
+{
+    JsonScanner in(raw);
+    return in.readText(dst, size);
+}
+
+String JsonMatch::toString() const
+{
+    // Unescaping never makes a string longer
+    char *buf = new char[length + 1];
+    String result = text(buf, length + 1) ? String(buf) : String();
+    delete[] buf;
+    return result;
+}
+
+bool JsonMatch::toLong(long &value) const
+{
+    JsonScanner in(raw);
+    return in.readInteger(value);
+}
+
+bool JsonMatch::toDouble(double &value) const
+{
+    JsonScanner in(raw);
+    return in.readNumber(value);
+}
+
+bool JsonMatch::toBool(bool &value) const
+{
+    JsonScanner in(raw);
+    return in.readBool(value);
+}
+
+/**
+ * @brief Compile "a.b[2].c", "results[*].name", "$.items[*]" into steps.
+ */
+bool JsonSelector::add(const char *path)
+{
+    if (!path || _pathCount >= MAX_PATHS)
+        return false;
+
+    Path &compiled = _paths[_pathCount];
+    compiled.stepCount = 0;
+
+    const char *p = path;
+    if (*p == '$')
+    {
+        p++;
+        if (*p == '.')
+            p++;
+    }
+
+    bool expectKey = *p != '[';
+    while (*p)
+    {
+        if (compiled.stepCount >= MAX_STEPS)
+            return false;
+        Step &step = compiled.steps[compiled.stepCount];
+
+        if (*p == '[')
+        {
+            p++;
+            if (*p == '*' && p[1] == ']')
+            {
+                step.type = StepType::AnyIndex;
+                p += 2;
+            }
+            else
+            {
+                char *end;
+                unsigned long index = strtoul(p, &end, 10);
+                if (end == p || *end != ']' || index > 0xFFFF || *p == '-' || *p == '+')
+                    return false;
+                step.type = StepType::Index;
+                step.index = (uint16_t)index;
+                p = end + 1;
+            }
+        }
+        else
+        {
+            if (!expectKey)
+                return false;
+            const char *start = p;
+            while (*p && *p != '.' && *p != '[')
+                p++;
+            size_t length = p - start;
+            if (length == 0 || length > 0xFF)
+                return false;
+
+            if (length == 1 && *start == '*')
+            {
+                step.type = StepType::AnyKey;
+            }
+            else
+            {
+                step.type = StepType::Key;
+                step.name = start;
+                step.length = (uint8_t)length;
+                step.hash = JSON_KEY_HASH_SEED;
+                for (size_t i = 0; i < length; i++)
+                    step.hash = (uint32_t)((step.hash ^ (uint8_t)start[i]) * JSON_KEY_HASH_PRIME);
+            }
+        }
+        compiled.stepCount++;
+
+        // After a step: '.' introduces a key, '[' an index, or the path ends
+        expectKey = false;
+        if (*p == '.')
+        {
+            p++;
+            if (!*p)
+                return false;
+            expectKey = true;
+        }
+        else if (*p && *p != '[')
+        {
+            return false;
+        }
+    }
+
+    if (compiled.stepCount == 0)
+        return false;
+    _pathCount++;
+    return true;
+}
+
+/**
+ * @class JsonSelectorWalk
+ * @brief One run() of a selector: recursive descent that only enters
+ * members and elements some path still needs.
+ */
+class JsonSelectorWalk
+{
+public:
+    JsonSelectorWalk(const JsonSelector &selector, const char *json,
+                     JsonSelector::Callback callback, void *context)
+        : _selector(selector), _in(json), _callback(callback), _context(context) {}
+
+    int run()
+    {
+        if (!walk(0, (1UL << _selector._pathCount) - 1) && !_stopped)
+            return -1;
+        return _in.failed() ? -1 : _matches;
+    }
+
+    size_t offset() const { return _in.offset(); }
+
+private:
+    const JsonSelector &_selector;
+    JsonScanner _in;
+    JsonSelector::Callback _callback;
+    void *_context;
+    uint16_t _indices[JsonSelector::MAX_STEPS];
+    uint8_t _indexCount = 0;
+    int _matches = 0;
+    bool _stopped = false;
+
+    // 'alive' has a bit per path whose first 'depth' steps lead to this value
+    bool walk(uint8_t depth, uint32_t alive)
+    {
+        char c = _in.peek();
+        const char *start = _in.position();
+
+        uint32_t complete = 0;
+        uint32_t deeper = 0;
+        for (uint8_t i = 0; i < _selector._pathCount; i++)
+        {
+            if (!(alive & (1UL << i)))
+                continue;
+            if (_selector._paths[i].stepCount == depth)
+                complete |= 1UL << i;
+            else
+                deeper |= 1UL << i;
+        }
+
+        bool ok;
+        if (deeper && c == '{')
+            ok = walkObject(depth, deeper);
+        else if (deeper && c == '[')
+            ok = walkArray(depth, deeper);
+        else
+            ok = _in.skipValue();
+        if (!ok)
+            return false;
+
+        for (uint8_t i = 0; complete && i < _selector._pathCount; i++)
+        {
+            if (!(complete & (1UL << i)))
+                continue;
+            JsonMatch match = {i, start, (size_t)(_in.position() - start), _indices, _indexCount};
+            _matches++;
+            if (!_callback(match, _context))
+            {
+                _stopped = true;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool walkObject(uint8_t depth, uint32_t paths)
+    {
+        _in.consume('{');
+        bool first = true;
+        while (_in.nextItem('}', first))
+        {
+            JsonScanner::Key key;
+            if (!_in.readKey(key))
+                return false;
+
+            uint32_t next = 0;
+            for (uint8_t i = 0; i < _selector._pathCount; i++)
+            {
+                if (!(paths & (1UL << i)))
+                    continue;
+                const JsonSelector::Step &step = _selector._paths[i].steps[depth];
+                if (step.type == JsonSelector::StepType::AnyKey ||
+                    (step.type == JsonSelector::StepType::Key && step.hash == key.hash &&
+                     key.equals(step.name, step.length)))
+                    next |= 1UL << i;
+            }
+
+            if (next ? !walk(depth + 1, next) : !_in.skipValue())
+                return false;
+        }
+        return !_in.failed();
+    }
+
+    bool walkArray(uint8_t depth, uint32_t paths)
+    {
+        _in.consume('[');
+        bool first = true;
+        uint16_t index = 0;
+        while (_in.nextItem(']', first))
+        {
+            uint32_t next = 0;
+            for (uint8_t i = 0; i < _selector._pathCount; i++)
+            {
+                if (!(paths & (1UL << i)))
+                    continue;
+                const JsonSelector::Step &step = _selector._paths[i].steps[depth];
+                if (step.type == JsonSelector::StepType::AnyIndex ||
+                    (step.type == JsonSelector::StepType::Index && step.index == index))
+                    next |= 1UL << i;
+            }
+
+            bool ok;
+            if (next)
+            {
+                _indices[_indexCount++] = index;
+                ok = walk(depth + 1, next);
+                _indexCount--;
+            }
+            else
+            {
+                ok = _in.skipValue();
+            }
+            if (!ok)
+                return false;
+            if (index < 0xFFFF)
+                index++;
+        }
+        return !_in.failed();
+    }
+};
+
+int JsonSelector::run(const char *json, Callback callback, void *context, size_t *errorOffset) const
+{
+    if (_pathCount == 0)
+        return 0;
+    JsonSelectorWalk walk(*this, json, callback, context);
+    int matches = walk.run();
+    if (matches < 0 && errorOffset)
+        *errorOffset = walk.offset();
+    return matches;
+}
@@ -0,0 +1,134 @@
+#ifndef JSON_SELECTOR_H
+#define JSON_SELECTOR_H
+
+#include <Arduino.h>
+#include <string.h>
+#include "JsonScanner.h"
+
+#ifndef JSON_SELECTOR_MAX_PATHS
+#define JSON_SELECTOR_MAX_PATHS 4 ///< Paths per selector (at most 31)
+#endif
+
+#ifndef JSON_SELECTOR_MAX_STEPS
+#define JSON_SELECTOR_MAX_STEPS 6 ///< Keys/indices per path
+#endif
+
+/**
+ * @struct JsonMatch
+ * @brief One value matched by a JsonSelector path.
+ *
+ * raw points into the scanned text (the value exactly as written, quotes
+ * included) and is only valid inside the callback.
+ */
+struct JsonMatch
+{
+    uint8_t path;            ///< Index of the matching path, in add() order
+    const char *raw;         ///< Start of the value in the input
+    size_t length;           ///< Length of the value text
+    const uint16_t *indices; ///< Array indices along the path, outermost first
+    uint8_t indexCount;      ///< Number of entries in indices
+
+    /// Index of the innermost array element on the path (0 if none)
+    uint16_t index() const { return indexCount ? indices[indexCount - 1] : 0; }
+
+    bool isNull() const { return length == 4 && memcmp(raw, "null", 4) == 0; }
+    bool isString() const { return length > 0 && raw[0] == '"'; }
+
+    /// Unescaped string (numbers/booleans as written) into dst, truncated to size - 1
+    bool text(char *dst, size_t size) const;
+    String toString() const;
+
+    bool toLong(long &value) const;
+    bool toDouble(double &value) const;
+    bool toBool(bool &value) const;
+};
+
+/**
+ * @class JsonSelector
+ * @brief A few JSON paths compiled once and matched in a single streaming pass.
+ *
+ * Paths use dots for keys and brackets for array elements, with * as a
+ * wildcard: "results[*].name", "meta.page", "items[0].*". A leading "$."
+ * is accepted. run() walks the text with a JsonScanner and hands each
+ * matching value to the callback; everything else is skipped without
+ * being stored, so the RAM needed is that of the values the caller keeps.
+ *
+ * Path strings are referenced, not copied; use literals or keep them alive.
+ *
+ * Example usage:
+ * @code
+ * JsonSelector sel;
+ * sel.add("results[*].id");
+ * sel.add("results[*].name");
+ * sel.run(body.c_str(), [&](const JsonMatch &m) {
+ *     m.text(m.path == 0 ? users[m.index()].id : users[m.index()].name, 40);
+ *     return true; // false stops the scan
+ * });
+ * @endcode
+ */
+class JsonSelector
+{
+public:
+    static constexpr uint8_t MAX_PATHS = JSON_SELECTOR_MAX_PATHS;
+    static constexpr uint8_t MAX_STEPS = JSON_SELECTOR_MAX_STEPS;
+    static_assert(MAX_PATHS < 32, "JSON_SELECTOR_MAX_PATHS must fit a 32-bit mask");
+
+    typedef bool (*Callback)(const JsonMatch &match, void *context);
+
+    JsonSelector() = default;
+    explicit JsonSelector(const char *path) { add(path); }
+
+    /**
+     * @brief Compile and add a path.
+     * @return false if the path is malformed or there is no room.
+     */
+    bool add(const char *path);
+
+    uint8_t count() const { return _pathCount; }
+
+    /**
+     * @brief Scan json and call fn(const JsonMatch &) for each match, in
+     * document order. fn returns false to stop early.
+     * @param errorOffset If set, receives where malformed text was detected
+     * (the text length when it ends too early).
+     * @return Matches reported, or -1 if the text is malformed.
+     */
+    template <typename Fn>
+    int run(const char *json, Fn fn, size_t *errorOffset = nullptr) const
+    {
+        return run(json, [](const JsonMatch &match, void *context) { return (*static_cast<Fn *>(context))(match); }, &fn, errorOffset);
+    }
+
+    int run(const char *json, Callback callback, void *context, size_t *errorOffset = nullptr) const;
+
+private:
+    enum class StepType : uint8_t
+    {
+        Key,
+        AnyKey,
+        Index,
+        AnyIndex
+    };
+
+    struct Step
+    {
+        StepType type;
+        uint8_t length;   ///< Key length
+        uint16_t index;   ///< Array index for Index steps
+        uint32_t hash;    ///< jsonKeyHash of the key
+        const char *name; ///< Key text in the path string
+    };
+
+    struct Path
+    {
+        Step steps[MAX_STEPS];
+        uint8_t stepCount;
+    };
+
+    Path _paths[MAX_PATHS];
+    uint8_t _pathCount = 0;
+
+    friend class JsonSelectorWalk;
+};
+
+#endif // JSON_SELECTOR_H
@@ -0,0 +1,318 @@
+#ifndef JSON_STREAM_WRITER_H
+#define JSON_STREAM_WRITER_H
+
+#include <Arduino.h>
+#include <math.h>
+
+/**
+ * @class JsonStreamWriter
+ * @brief SAX-style JSON writer that prints straight to any Print.
+ *
+ * Nothing is buffered: each call writes its bytes to the target
+ * (a NetworkClient, Serial, a File...). Commas and key/value separators
+ * are inserted automatically; the caller only has to keep begin/end calls
+ * balanced and call key() before every value inside an object.
+ *
+ * Example usage:
+ * @code
+ * auto body = [&](Print &out) {
+ *     JsonStreamWriter json(out);
+ *     json.beginObject();
+ *     json.key("user").value("Chuck");
+ *     json.key("values").beginArray().value(1).value(2).endArray();
+ *     json.endObject();
+ * };
+ * size_t length = JsonStreamWriter::measure(body);
+ * http.postStream("/api/log", length, body);
+ * @endcode
+ */
+class JsonStreamWriter
+{
+public:
+    static constexpr uint8_t MAX_DEPTH = 32; ///< Deepest nesting tracked for separators
+
+    /**
+     * @class Counter
+     * @brief Print that only counts bytes; used by measure().
+     */
+    class Counter : public Print
+    {
+    public:
+        size_t write(uint8_t) override
+        {
+            _count++;
+            return 1;
+        }
+        size_t write(const uint8_t *, size_t size) override
+        {
+            _count += size;
+            return size;
+        }
+        size_t count() const { return _count; }
+
+    private:
+        size_t _count = 0;
+    };
+
+    explicit JsonStreamWriter(Print &out) : _out(out) {}
+
+    /**
+     * @brief Exact number of bytes fn(Print&) writes, without writing them.
+     * Run the same fn against the real target afterwards; it must be
+     * deterministic.
+     */
+    template <typename Fn>
+    static size_t measure(Fn fn)
+    {
+        Counter counter;
+        fn(counter);
+        return counter.count();
+    }
+
+    JsonStreamWriter &beginObject() { return open('{'); }
+    JsonStreamWriter &endObject() { return close('}'); }
+    JsonStreamWriter &beginArray() { return open('['); }
+    JsonStreamWriter &endArray() { return close(']'); }
+
+    /**
+     * @brief Write an object key; the next call writes its value.
+     */
+    JsonStreamWriter &key(const char *name)
+    {
+        separator();
+        writeString(name);
+        _written += _out.write(':');
+        _afterKey = true;
+        return *this;
+    }
+
+    JsonStreamWriter &value(const char *s)
+    {
+        separator();
+        if (s)
+            writeString(s);
+        else
+            _written += _out.print("null");
+        return *this;
+    }
+
+    /**
+     * @brief Write at most maxLength chars of s (for fixed char buffers
+     * that may fill up without a terminator).
+     */
+    JsonStreamWriter &value(const char *s, size_t maxLength)
+    {
+        separator();
+        writeString(s, maxLength);
+        return *this;
+    }
+
+    JsonStreamWriter &value(const String &s) { return value(s.c_str()); }
+    JsonStreamWriter &value(int v) { return value((long)v); }
+    JsonStreamWriter &value(unsigned int v) { return value((unsigned long)v); }
+
+    JsonStreamWriter &value(long v)
+    {
+        separator();
+        _written += _out.print(v);
+        return *this;
+    }
+
+    JsonStreamWriter &value(unsigned long v)
+    {
+        separator();
+        _written += _out.print(v);
+        return *this;
+    }
+
+    /**
+     * @brief 64-bit integers, written in full (Print stops at 32 bits).
+     */
+    JsonStreamWriter &value(long long v)
+    {
+        separator();
+        if (v < 0)
+            _written += _out.write('-');
+        writeDigits(v < 0 ? 0ULL - (unsigned long long)v : (unsigned long long)v);
+        return *this;
+    }
+
+    JsonStreamWriter &value(unsigned long long v)
+    {
+        separator();
+        writeDigits(v);
+        return *this;
+    }
+
+    /**
+     * @brief Write a number with decimals digits after the point.
+     *
+     * Magnitudes Print cannot show that way (it prints "ovf" past 32 bits,
+     * and small values would round to zero) are written with an exponent,
+     * e.g. 1.50e12. NaN and infinity become null (not valid JSON).
+     */
+    JsonStreamWriter &value(double v, uint8_t decimals = 2)
+    {
+        separator();
+        if (isnan(v) || isinf(v))
+            _written += _out.print("null");
+        else
+            writeNumber(v, decimals);
+        return *this;
+    }
+
+    JsonStreamWriter &value(bool v)
+    {
+        separator();
+        _written += _out.print(v ? "true" : "false");
+        return *this;
+    }
+
+    JsonStreamWriter &nullValue()
+    {
+        separator();
+        _written += _out.print("null");
+        return *this;
+    }
+
+    /**
+     * @brief Write pre-serialized JSON as a value (not validated).
+     */
+    JsonStreamWriter &raw(const char *json)
+    {
+        separator();
+        _written += _out.print(json);
+        return *this;
+    }
+
+    /// Shorthand for key(name).value(v)
+    template <typename T>
+    JsonStreamWriter &member(const char *name, T v)
+    {
+        key(name);
+        return value(v);
+    }
+
+    size_t bytesWritten() const { return _written; }
+    uint8_t depth() const { return _depth; }
+
+private:
+    Print &_out;
+    size_t _written = 0;
+    uint8_t _depth = 0;
+    uint32_t _hasItems = 0; ///< Bit per level: a value was already written
+    bool _afterKey = false;
+
+    JsonStreamWriter &open(char c)
+    {
+        separator();
+        _written += _out.write(c);
+        if (_depth < MAX_DEPTH)
+            _hasItems &= ~(1UL << _depth);
+        _depth++;
+        return *this;
+    }
+
+    JsonStreamWriter &close(char c)
+    {
+        if (_depth > 0)
+            _depth--;
+        _written += _out.write(c);
+        return *this;
+    }
+
+    // Comma before every item but the first; nothing right after a key
+    void separator()
+    {
+        if (_afterKey)
+        {
+            _afterKey = false;
+            return;
+        }
+        if (_depth == 0 || _depth > MAX_DEPTH)
+            return;
+        uint32_t bit = 1UL << (_depth - 1);
+        if (_hasItems & bit)
+            _written += _out.write(',');
+        _hasItems |= bit;
+    }
+
+    void writeDigits(unsigned long long v)
+    {
+        char digits[21];
+        char *p = digits + sizeof(digits);
+        *--p = '\0';
+        do
+        {
+            *--p = '0' + v % 10;
+            v /= 10;
+        } while (v);
+        _written += _out.print(p);
+    }
+
+    void writeNumber(double v, uint8_t decimals)
+    {
+        static constexpr double PRINT_MAX = 4294967040.0; ///< Largest magnitude Print::print(double) shows
+        double magnitude = fabs(v);
+        double smallest = pow(10.0, -(int)decimals);
+        if (magnitude < PRINT_MAX && (magnitude == 0 || magnitude >= smallest))
+        {
+            _written += _out.print(v, decimals);
+            return;
+        }
+
+        // Mantissa in [1, 10) after rounding to decimals digits
+        int exponent = (int)floor(log10(magnitude));
+        double mantissa = v / pow(10.0, exponent / 2) / pow(10.0, exponent - exponent / 2); // split: denormals
+        if (fabs(mantissa) + smallest / 2 >= 10)
+        {
+            mantissa /= 10;
+            exponent++;
+        }
+        _written += _out.print(mantissa, decimals);
+        _written += _out.write('e');
+        _written += _out.print((long)exponent);
+    }
+
+    void writeString(const char *s, size_t maxLength = (size_t)-1)
+    {
+        _written += _out.write('"');
+        for (; maxLength && *s; s++, maxLength--)
+        {
+            char c = *s;
+            switch (c)
+            {
+            case '"':
+                _written += _out.print("\\\"");
+                break;
+            case '\\':
+                _written += _out.print("\\\\");
+                break;
+            case '\n':
+                _written += _out.print("\\n");
+                break;
+            case '\r':
+                _written += _out.print("\\r");
+                break;
+            case '\t':
+                _written += _out.print("\\t");
+                break;
+            default:
+                if ((uint8_t)c < 0x20)
+                {
+                    static const char hex[] = "0123456789abcdef";
+                    _written += _out.print("\\u00");
+                    _written += _out.write(hex[(c >> 4) & 0x0F]);
+                    _written += _out.write(hex[c & 0x0F]);
+                }
+                else
+                {
+                    _written += _out.write(c);
+                }
+            }
+        }
+        _written += _out.write('"');
+    }
+};
+
+#endif // JSON_STREAM_WRITER_H
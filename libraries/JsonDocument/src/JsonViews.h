@@ -0,0 +1,152 @@
+#ifndef JSON_VIEWS_H
+#define JSON_VIEWS_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <type_traits>
+
+class JsonArrayView;
+
+/**
+ * @class JsonObjectView
+ * @brief Value-type handle to a JSON object inside a document.
+ *
+ * A view is two pointers (the object and its document's memory pool); it
+ * allocates nothing itself and is meant to be passed and returned by value.
+ * It stays valid as long as the owning document is alive and its pool is
+ * not rebuilt (any ArduinoJsonWrapper write may grow it); the heap
+ * adapters from getObject()/getArray() look their member up again instead.
+ *
+ * Example usage:
+ * @code
+ * JsonObjectView payload = doc.object("payload");
+ * payload.set("user", "Chuck");
+ * payload.array("values").add(120);
+ * @endcode
+ */
+class JsonObjectView
+{
+public:
+    JsonObjectView() = default;
+    explicit JsonObjectView(JsonObject obj) : _obj(obj) {}
+
+    /// True if the view does not reference an object (e.g. pool exhausted)
+    bool isNull() const { return _obj.isNull(); }
+    size_t size() const { return _obj.size(); }
+
+    bool set(const char *key, const char *value) { return _obj[key].set(value); }
+
+    /// Numbers and booleans, stored natively (int64_t needs ARDUINOJSON_USE_LONG_LONG)
+    template <typename T>
+    typename std::enable_if<std::is_arithmetic<T>::value, bool>::type set(const char *key, T value) { return _obj[key].set(value); }
+
+    /// Deep copy of any JSON value into this object's pool
+    bool set(const char *key, JsonVariantConst value) { return _obj[key].set(value); }
+
+    /**
+     * @brief Value stored under key (null if missing).
+     */
+    JsonVariantConst get(const char *key) const { return _obj[key]; }
+
+    /**
+     * @brief Get or create a nested object; a non-object value is replaced.
+     */
+    JsonObjectView object(const char *key)
+    {
+        if (_obj[key].is<JsonObject>())
+            return JsonObjectView(_obj[key].as<JsonObject>());
+        return JsonObjectView(_obj.createNestedObject(key));
+    }
+
+    /**
+     * @brief Get or create a nested array; a non-array value is replaced.
+     */
+    inline JsonArrayView array(const char *key);
+
+    void remove(const char *key) { _obj.remove(key); }
+    void clear() { _obj.clear(); }
+
+    String serialize() const
+    {
+        String output;
+        serializeJson(_obj, output);
+        return output;
+    }
+
+    /// Underlying ArduinoJson handle
+    JsonObject raw() const { return _obj; }
+
+private:
+    JsonObject _obj;
+};
+
+/**
+ * @class JsonArrayView
+ * @brief Value-type handle to a JSON array inside a document.
+ *
+ * Same lifetime rules as JsonObjectView.
+ */
+class JsonArrayView
+{
+public:
+    JsonArrayView() = default;
+    explicit JsonArrayView(JsonArray arr) : _arr(arr) {}
+
+    bool isNull() const { return _arr.isNull(); }
+    size_t size() const { return _arr.size(); }
+
+    /// Append a value; false if the document is full
+    bool add(const char *value) { return _arr.add(value); }
+
+    template <typename T>
+    typename std::enable_if<std::is_arithmetic<T>::value, bool>::type add(T value) { return _arr.add(value); }
+
+    /// Deep copy of any JSON value appended to the array
+    bool add(JsonVariantConst value) { return _arr.add(value); }
+
+    /**
+     * @brief Append count values (e.g. a buffer of samples) in one call.
+     * @return Values appended; fewer than count if the document filled up.
+     */
+    template <typename T>
+    size_t add(const T *values, size_t count)
+    {
+        size_t added = 0;
+        while (added < count && add(values[added]))
+            added++;
+        return added;
+    }
+
+    /**
+     * @brief Element at index (null if out of range).
+     */
+    JsonVariantConst get(size_t index) const { return _arr[index]; }
+
+    /// Append and return a new nested object / array
+    JsonObjectView addObject() { return JsonObjectView(_arr.createNestedObject()); }
+    JsonArrayView addArray() { return JsonArrayView(_arr.createNestedArray()); }
+
+    void clear() { _arr.clear(); }
+
+    String serialize() const
+    {
+        String output;
+        serializeJson(_arr, output);
+        return output;
+    }
+
+    /// Underlying ArduinoJson handle
+    JsonArray raw() const { return _arr; }
+
+private:
+    JsonArray _arr;
+};
+
+inline JsonArrayView JsonObjectView::array(const char *key)
+{
+    if (_obj[key].is<JsonArray>())
+        return JsonArrayView(_obj[key].as<JsonArray>());
+    return JsonArrayView(_obj.createNestedArray(key));
+}
+
+#endif // JSON_VIEWS_H
@@ -0,0 +1,39 @@
+#ifndef MSG_PACK_DOCUMENT_H
+#define MSG_PACK_DOCUMENT_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "ArduinoJsonWrapper.h"
+
+/**
+ * @class MsgPackDocument
+ * @brief RumpusJsonDocument that goes on the wire as MessagePack.
+ *
+ * Built exactly like an ArduinoJsonWrapper (it is one), so code written
+ * against RumpusJsonDocument switches format by constructing this class
+ * instead. serializeTo()/measure() produce MessagePack, 21-28% smaller
+ * than the JSON text for the log and print-job payloads measured in the
+ * README (99 -> 78 B, 116 -> 84 B); serialize() still
+ * returns JSON text for logging and for servers that only take JSON.
+ *
+ * Example usage:
+ * @code
+ * MsgPackDocument doc;
+ * doc.set("level", "info");
+ * doc.set("uptime", 183022);
+ * http.postDocument("/api/log", doc); // application/msgpack
+ * @endcode
+ */
+class MsgPackDocument : public ArduinoJsonWrapper
+{
+public:
+    static constexpr const char *CONTENT_TYPE = "application/msgpack";
+
+    using ArduinoJsonWrapper::ArduinoJsonWrapper;
+
+    size_t serializeTo(Print &out) override { return serializeMsgPack(variant(), out); }
+    size_t measure() override { return measureMsgPack(variant()); }
+    const char *contentType() const override { return CONTENT_TYPE; }
+};
+
+#endif // MSG_PACK_DOCUMENT_H
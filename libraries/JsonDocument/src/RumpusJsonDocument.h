@@ -2,6 +2,8 @@
 #define JSON_DOCUMENT_H
 
 #include <Arduino.h>
+#include <limits.h>
+#include <type_traits>
 
 /**
  * @class RumpusJsonDocument
@@ -11,6 +13,9 @@
  * without depending on a specific underlying library (e.g., ArduinoJson).
  * Implementations should provide storage for the JSON data and support
  * nested objects and arrays.
+ *
+ * Every set() returns false if the value could not be stored, e.g. the
+ * document was full and could not grow; what was there before is kept.
  */
 class RumpusJsonDocument
 {
@@ -22,16 +27,65 @@ public:
      * @param key The key to set.
      * @param value The string value to assign.
      */
-    virtual void set(const char *key, const char *value) = 0;
+    virtual bool set(const char *key, const char *value) = 0;
 
     /**
      * @brief Set an integer value for a given key in the JSON document.
      * @param key The key to set.
      * @param value The integer value to assign.
      */
-    virtual void set(const char *key, int value) = 0;
+    virtual bool set(const char *key, int value) = 0;
+
+    /**
+     * @brief Store numbers and booleans as JSON numbers/booleans, without
+     * formatting them into strings first.
+     */
+    virtual bool set(const char *key, bool value) = 0;
+    virtual bool set(const char *key, float value) = 0;
+    virtual bool set(const char *key, double value) = 0;
+    virtual bool set(const char *key, int64_t value) = 0;
+    virtual bool set(const char *key, uint32_t value) = 0;
+
+    /**
+     * @brief Other integer types (long, uint16_t, size_t...) go through
+     * the int64_t/uint32_t setters instead of being ambiguous.
+     * Derived classes need `using RumpusJsonDocument::set;`.
+     */
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value, bool>::type set(const char *key, T value)
+    {
+        if (std::is_signed<T>::value || sizeof(T) > sizeof(uint32_t))
+            return set(key, (int64_t)value);
+        return set(key, (uint32_t)value);
+    }
+
+    virtual bool set(const char *key, RumpusJsonDocument *value) = 0;
+
+    /**
+     * @brief Typed reads; fallback is returned if key is missing or holds
+     * another type. Integers read from floats are truncated.
+     */
+    virtual bool getBool(const char *key, bool fallback = false) const = 0;
+    virtual int64_t getInt64(const char *key, int64_t fallback = 0) const = 0;
+    virtual double getDouble(const char *key, double fallback = 0) const = 0;
+    virtual String getString(const char *key, const String &fallback = "") const = 0;
+
+    int getInt(const char *key, int fallback = 0) const
+    {
+        int64_t v = getInt64(key, fallback);
+        return v >= INT_MIN && v <= INT_MAX ? (int)v : fallback;
+    }
 
-    virtual void set(const char *key, RumpusJsonDocument *value) = 0;
+    uint32_t getUInt32(const char *key, uint32_t fallback = 0) const
+    {
+        int64_t v = getInt64(key, fallback);
+        return v >= 0 && v <= (int64_t)UINT32_MAX ? (uint32_t)v : fallback;
+    }
+
+    float getFloat(const char *key, float fallback = 0) const
+    {
+        return (float)getDouble(key, fallback);
+    }
 
     /**
      * @brief Get or create a nested JSON object for a given key.
@@ -73,10 +127,56 @@ public:
      */
     virtual String serialize() = 0;
 
+    /**
+     * @brief Serialize directly into a Print (e.g. a NetworkClient).
+     * @return Number of bytes written.
+     */
+    virtual size_t serializeTo(Print &out)
+    {
+        return out.print(serialize());
+    }
+
+    /**
+     * @brief Exact length serializeTo() will write, e.g. for Content-Length.
+     */
+    virtual size_t measure()
+    {
+        return serialize().length();
+    }
+
+    /**
+     * @brief MIME type of what serializeTo() writes.
+     * serialize() always returns JSON text, whatever the wire format.
+     */
+    virtual const char *contentType() const { return "application/json"; }
+
     /**
      * @brief Clear all contents of the JSON document.
      */
     virtual void clear() = 0;
+
+    /**
+     * @brief Apply a JSON Merge Patch (RFC 7386) to this document: objects
+     * are merged, null members are removed, anything else is replaced.
+     * @return false if the backend does not support patches or the result does not fit.
+     */
+    virtual bool mergePatch(RumpusJsonDocument *patch) { return false; }
+
+    /**
+     * @brief Replace this document with the merge patch that turns base
+     * into target; an empty object means they are equal.
+     * @return false if the backend does not support patches or the patch does not fit.
+     */
+    virtual bool diff(RumpusJsonDocument *base, RumpusJsonDocument *target) { return false; }
+
+    /**
+     * @brief Name of the implementation backing this document, or nullptr.
+     *
+     * Documents that report the same backend can exchange data natively,
+     * e.g. set(key, doc) copies the nested tree without a serialize()/parse
+     * round-trip.
+     */
+    virtual const char *backend() const { return nullptr; }
 };
 
 #endif // JSON_DOCUMENT_H
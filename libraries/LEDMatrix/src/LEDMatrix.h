@@ -1,5 +1,6 @@
 #pragma once
 #include <Arduino.h>
+#include "PackedFrame.h"
 
 /**
  * @brief Abstract interface for controlling an LED Matrix display.
@@ -59,11 +60,19 @@ public:
     /**
      * @brief Render a prebuilt frame on the display.
      *
-     * @param frame 2D array representing the LED states.
-     *              Each element should be 0 (off) or 1 (on).
-     *              Dimensions are implementation-dependent.
+     * @param frame 8x12 frame packed into three words (see PackedFrame).
      */
-    virtual void renderFrame(const uint8_t frame[8][12]) = 0;
+    virtual void renderFrame(const PackedFrame &frame) = 0;
+
+    /**
+     * @brief Render a byte-per-LED frame (0 = off, non-zero = on).
+     * Packs it first; prefer the PackedFrame overload.
+     * Derived classes need `using LEDMatrix::renderFrame;`.
+     */
+    void renderFrame(const uint8_t frame[8][12])
+    {
+        renderFrame(PackedFrame::fromBytes(frame));
+    }
 
     /**
      * @brief Set the brightness of the LED matrix.
@@ -1,5 +1,7 @@
 #include "LEDMatrixBuilder.h"
 
+#if LEDMATRIX_HAS_BOARD_MATRIX
+
 /**
  * @brief Construct a new LEDMatrixBuilder with default values
  */
@@ -83,18 +85,19 @@ LEDMatrixWrapper *LEDMatrixBuilder::build()
         display->setDrawEngine(_drawEngine);
     }
 
-    // Optionally assign text to display
+    // Scroll settings go to the wrapper's non-blocking scroller
+    display->setScrollSpeed(_speed);
+    display->setLoopCount(_loopCount);
+    display->setStopTime(_stopMs);
+
+    // Optionally start scrolling the text; the sketch drives it with
+    // display->scroller().update(millis()) after begin()
     if (_text.length() > 0)
     {
-        display->renderText(_text); // Assumes LEDMatrixWrapper has renderText()
+        display->scroller().start(_text);
     }
 
-    // Scroll speed and loop count can be stored in wrapper if supported
-    // display->setScrollSpeed(_speed);
-    // display->setLoopCount(_loopCount);
-
-    // Stop duration can be stored in wrapper if supported
-    // display->setStopTime(_stopMs);
-
     return display;
 }
+
+#endif // LEDMATRIX_HAS_BOARD_MATRIX
@@ -5,6 +5,8 @@
 #include "renderer/DrawEngine.h"
 #include "platform/arduino/LEDMatrixWrapper.h"
 
+#if LEDMATRIX_HAS_BOARD_MATRIX
+
 /**
  * @brief Builder for constructing and configuring LEDMatrix instances.
  *
@@ -68,7 +70,7 @@ public:
     LEDMatrixBuilder &withDrawEngine(DrawEngine *engine);
 
     /**
-     * @brief Assign the text to display on the LED matrix.
+     * @brief Assign the text to scroll on the LED matrix (see LEDMatrixWrapper::scroller()).
      * @param text Message to display
      * @return Reference to builder for chaining
      */
@@ -94,3 +96,5 @@ private:
     RumpshiftLogger *_logger = nullptr;
     DrawEngine *_drawEngine = nullptr;
 };
+
+#endif // LEDMATRIX_HAS_BOARD_MATRIX
@@ -0,0 +1,192 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+ * @brief One 8x12 frame packed into 96 bits, in the layout the Uno R4
+ *        matrix takes natively (ArduinoLEDMatrix::loadFrame).
+ *
+ * Pixels are stored row by row: pixel (row, col) is bit number
+ * row * 12 + col of the 96-bit stream, counted from the MSB of word 0.
+ * A column is passed around as a uint8_t with bit r for row r (LSB = top),
+ * the same as the glyph columns in the fonts.
+ *
+ * Because rows are consecutive in the stream, scrolling the whole frame by
+ * one column is a 96-bit shift plus one masked write of the new edge column.
+ */
+class PackedFrame
+{
+public:
+    static constexpr uint8_t ROWS = 8;
+    static constexpr uint8_t COLUMNS = 12;
+    static constexpr uint8_t WORDS = 3;
+
+    constexpr PackedFrame() : _words{0, 0, 0} {}
+    constexpr PackedFrame(uint32_t w0, uint32_t w1, uint32_t w2) : _words{w0, w1, w2} {}
+
+    /**
+     * @brief Pack a byte-per-LED frame (any non-zero byte is on).
+     */
+    static PackedFrame fromBytes(const uint8_t frame[ROWS][COLUMNS])
+    {
+        PackedFrame packed;
+        for (uint8_t r = 0; r < ROWS; r++)
+            for (uint8_t c = 0; c < COLUMNS; c++)
+                if (frame[r][c])
+                    packed.set(r, c);
+        return packed;
+    }
+
+    void toBytes(uint8_t frame[ROWS][COLUMNS]) const
+    {
+        for (uint8_t r = 0; r < ROWS; r++)
+            for (uint8_t c = 0; c < COLUMNS; c++)
+                frame[r][c] = get(r, c) ? 1 : 0;
+    }
+
+    /// The three words for loadFrame()
+    const uint32_t *data() const { return _words; }
+    uint32_t word(uint8_t index) const { return _words[index]; }
+
+    void clear() { _words[0] = _words[1] = _words[2] = 0; }
+    bool isEmpty() const { return (_words[0] | _words[1] | _words[2]) == 0; }
+
+    bool get(uint8_t row, uint8_t col) const
+    {
+        uint8_t i = row * COLUMNS + col;
+        return _words[i >> 5] & bitAt(i);
+    }
+
+    void set(uint8_t row, uint8_t col, bool on = true)
+    {
+        uint8_t i = row * COLUMNS + col;
+        if (on)
+            _words[i >> 5] |= bitAt(i);
+        else
+            _words[i >> 5] &= ~bitAt(i);
+    }
+
+    /**
+     * @brief Flip bit index (row * 12 + col) of the 96-bit stream.
+     */
+    void toggle(uint8_t index) { _words[index >> 5] ^= bitAt(index); }
+
+    /**
+     * @brief XOR byte index (0-11) of the 96-bit stream, MSB first.
+     *
+     * Delta-coded data (see AnimationPlayer) applies to the frame this way
+     * without unpacking it.
+     */
+    void xorByte(uint8_t index, uint8_t bits)
+    {
+        _words[index >> 2] ^= (uint32_t)bits << (24 - 8 * (index & 3));
+    }
+
+    /**
+     * @brief Column col as bits (bit r = row r).
+     */
+    uint8_t column(uint8_t col) const
+    {
+        uint8_t bits = 0;
+        for (uint8_t r = 0; r < ROWS; r++)
+            if (get(r, col))
+                bits |= 1 << r;
+        return bits;
+    }
+
+    /**
+     * @brief Replace column col; clearing it is one mask per word.
+     */
+    void setColumn(uint8_t col, uint8_t bits)
+    {
+        clearColumn(col);
+        orColumn(col, bits);
+    }
+
+    /**
+     * @brief Turn on the bits of column col, leaving the others as they are.
+     */
+    void orColumn(uint8_t col, uint8_t bits)
+    {
+        for (uint8_t i = col; bits; i += COLUMNS, bits >>= 1)
+            if (bits & 1)
+                _words[i >> 5] |= bitAt(i);
+    }
+
+    void clearColumn(uint8_t col)
+    {
+        const uint32_t *mask = columnMasks(col);
+        _words[0] &= ~mask[0];
+        _words[1] &= ~mask[1];
+        _words[2] &= ~mask[2];
+    }
+
+    /**
+     * @brief Scroll one column left; incoming becomes the rightmost column.
+     */
+    void shiftLeft(uint8_t incoming = 0)
+    {
+        _words[0] = (_words[0] << 1) | (_words[1] >> 31);
+        _words[1] = (_words[1] << 1) | (_words[2] >> 31);
+        _words[2] <<= 1;
+        // Each row's column 11 now holds the next row's column 0
+        setColumn(COLUMNS - 1, incoming);
+    }
+
+    /**
+     * @brief Scroll one column right; incoming becomes the leftmost column.
+     */
+    void shiftRight(uint8_t incoming = 0)
+    {
+        _words[2] = (_words[2] >> 1) | (_words[1] << 31);
+        _words[1] = (_words[1] >> 1) | (_words[0] << 31);
+        _words[0] >>= 1;
+        setColumn(0, incoming);
+    }
+
+    bool operator==(const PackedFrame &other) const
+    {
+        return _words[0] == other._words[0] && _words[1] == other._words[1] && _words[2] == other._words[2];
+    }
+    bool operator!=(const PackedFrame &other) const { return !(*this == other); }
+
+    /**
+     * @brief Bits of word w that belong to column col.
+     */
+    static constexpr uint32_t columnMask(uint8_t col, uint8_t w)
+    {
+        uint32_t mask = 0;
+        for (uint8_t r = 0; r < ROWS; r++)
+        {
+            uint8_t i = r * COLUMNS + col;
+            if ((i >> 5) == w)
+                mask |= bitAt(i);
+        }
+        return mask;
+    }
+
+private:
+    uint32_t _words[WORDS];
+
+    struct ColumnMaskTable
+    {
+        uint32_t masks[COLUMNS][WORDS];
+
+        constexpr ColumnMaskTable() : masks{}
+        {
+            for (uint8_t c = 0; c < COLUMNS; c++)
+                for (uint8_t w = 0; w < WORDS; w++)
+                    masks[c][w] = columnMask(c, w);
+        }
+    };
+
+    static const uint32_t *columnMasks(uint8_t col);
+
+    static constexpr uint32_t bitAt(uint8_t index) { return 0x80000000UL >> (index & 31); }
+};
+
+// Built at compile time; one row of three masks per column
+inline const uint32_t *PackedFrame::columnMasks(uint8_t col)
+{
+    static constexpr ColumnMaskTable TABLE{};
+    return TABLE.masks[col];
+}
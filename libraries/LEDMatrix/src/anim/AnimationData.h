@@ -0,0 +1,36 @@
+#pragma once
+#include <Arduino.h>
+
+/**
+ * @brief A compressed 12x8 animation stored in flash.
+ *
+ * Written by tools/animc from a sprite sheet and played by
+ * AnimationPlayer. Each frame is the change from the one before it (the
+ * first from a blank frame), so frames decode straight into the packed
+ * framebuffer with XORs.
+ *
+ * Frame record:
+ *   header   bit 7     a new duration follows (LEB128 varint, ms); it holds
+ *                      for this frame and the ones after it
+ *            bits 6-5  encoding
+ *            bits 4-0  encoding argument
+ *   [duration]
+ *   payload  ANIMATION_TOGGLES  argument = n; n bit indexes (row * 12 + col)
+ *                               to flip
+ *            ANIMATION_MASK     2 bytes, little endian: bit i set = byte i of
+ *                               the 96-bit stream changes; then one XOR byte
+ *                               per set bit
+ *            ANIMATION_RLE      XOR of all 12 stream bytes, run-length coded
+ *                               as in FONT_TABLE_RLE fonts
+ */
+struct AnimationData
+{
+    const uint8_t *data; ///< PROGMEM frame records
+    uint16_t size;       ///< Bytes in data
+    uint16_t frames;     ///< Frame records in data
+};
+
+#define ANIMATION_DURATION_FOLLOWS 0x80
+#define ANIMATION_TOGGLES 0
+#define ANIMATION_MASK 1
+#define ANIMATION_RLE 2
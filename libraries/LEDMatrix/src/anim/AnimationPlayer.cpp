@@ -0,0 +1,218 @@
+#include "AnimationPlayer.h"
+#include <avr/pgmspace.h>
+
+AnimationPlayer::AnimationPlayer(LEDMatrix *matrix, RumpshiftLogger *logger)
+    : _matrix(matrix), _logger(logger)
+{
+}
+
+AnimationPlayer::AnimationPlayer(DrawEngine *engine, RumpshiftLogger *logger)
+    : _engine(engine), _logger(logger)
+{
+}
+
+void AnimationPlayer::start(const AnimationData &animation)
+{
+    _animation = animation;
+    _loopsDone = 0;
+    _duration = 0;
+    _corrupt = false;
+    rewind();
+
+    if ((!_matrix && !_engine) || !animation.data || animation.frames == 0 || _loopCount == 0)
+    {
+        _state = DONE;
+        if (_logger)
+            _logger->warn("AnimationPlayer: nothing to play");
+        return;
+    }
+
+    _state = WAITING;
+    if (_logger)
+        _logger->info("AnimationPlayer: playing " + String(animation.frames) + " frames");
+}
+
+bool AnimationPlayer::update(uint32_t now)
+{
+    switch (_state)
+    {
+    case DONE:
+        return false;
+
+    case WAITING:
+        // First tick: show frame 0 and start the clock
+        _frameStart = now;
+        if (!decodeNext())
+            return false;
+        _state = PLAYING;
+        push(now);
+        return true;
+
+    case PLAYING:
+        break;
+    }
+
+    // A rate-limited DrawEngine may still be holding the last frame back
+    if (now - _frameStart < _duration)
+    {
+        if (_engine)
+            _engine->present(now);
+        return false;
+    }
+
+    uint8_t steps = 0;
+    while (now - _frameStart >= _duration)
+    {
+        // After a long stall, jump ahead rather than replaying every frame
+        if (steps == ANIMATION_PLAYER_MAX_CATCH_UP)
+        {
+            _frameStart = now;
+            break;
+        }
+        _frameStart += _duration;
+        if (!step())
+            break;
+        steps++;
+    }
+
+    // However many frames passed, the hardware gets one
+    if (steps)
+        push(now);
+    return steps > 0;
+}
+
+/**
+ * @brief Start the sequence over from a blank frame
+ */
+void AnimationPlayer::rewind()
+{
+    _frame.clear();
+    _pos = 0;
+    _index = 0;
+}
+
+/**
+ * @brief Move to the next frame, looping as needed; false when playback ended
+ */
+bool AnimationPlayer::step()
+{
+    if (_index + 1 < _animation.frames)
+    {
+        _index++;
+        return decodeNext();
+    }
+
+    _loopsDone++;
+    if (_loopCount >= 0 && _loopsDone >= _loopCount)
+    {
+        // The last frame stays up
+        _state = DONE;
+        if (_logger)
+            _logger->info("AnimationPlayer: done");
+        return false;
+    }
+    rewind();
+    return decodeNext();
+}
+
+/**
+ * @brief Apply the record at _pos to _frame; false (and stop) if the data is bad
+ */
+bool AnimationPlayer::decodeNext()
+{
+    uint8_t header = readByte();
+    if (header & ANIMATION_DURATION_FOLLOWS)
+    {
+        uint32_t duration = 0;
+        uint8_t b;
+        uint8_t shift = 0;
+        do
+        {
+            b = readByte();
+            duration |= (uint32_t)(b & 0x7F) << shift;
+            shift += 7;
+        } while ((b & 0x80) && shift < 32 && !_corrupt);
+        _duration = duration ? duration : 1;
+    }
+
+    uint8_t argument = header & 0x1F;
+    switch ((header >> 5) & 0x03)
+    {
+    case ANIMATION_TOGGLES:
+        while (argument--)
+        {
+            uint8_t index = readByte();
+            if (index < PackedFrame::ROWS * PackedFrame::COLUMNS)
+                _frame.toggle(index);
+        }
+        break;
+
+    case ANIMATION_MASK:
+    {
+        uint16_t mask = readByte();
+        mask |= (uint16_t)readByte() << 8;
+        for (uint8_t i = 0; i < PackedFrame::WORDS * 4; i++)
+            if (mask & (1 << i))
+                _frame.xorByte(i, readByte());
+        break;
+    }
+
+    case ANIMATION_RLE:
+    {
+        uint8_t n = 0;
+        while (n < PackedFrame::WORDS * 4 && !_corrupt)
+        {
+            uint8_t control = readByte();
+            uint8_t count = (control & 0x7F) + 1;
+            if (control & 0x80)
+            {
+                uint8_t value = readByte();
+                while (count-- && n < PackedFrame::WORDS * 4)
+                    _frame.xorByte(n++, value);
+            }
+            else
+            {
+                while (count-- && n < PackedFrame::WORDS * 4)
+                    _frame.xorByte(n++, readByte());
+            }
+        }
+        break;
+    }
+
+    default:
+        _corrupt = true;
+        break;
+    }
+
+    if (_corrupt)
+    {
+        _state = DONE;
+        if (_logger)
+            _logger->error("AnimationPlayer: bad frame record " + String(_index));
+        return false;
+    }
+    return true;
+}
+
+uint8_t AnimationPlayer::readByte()
+{
+    if (_pos >= _animation.size)
+    {
+        _corrupt = true;
+        return 0;
+    }
+    return pgm_read_byte(_animation.data + _pos++);
+}
+
+void AnimationPlayer::push(uint32_t now)
+{
+    if (_engine)
+    {
+        _engine->drawFrame(_frame);
+        _engine->present(now);
+    }
+    else
+    {
+        _matrix->renderFrame(_frame);
+    }
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include <Arduino.h>
+#include "LEDMatrix.h"
+#include "PackedFrame.h"
+#include "RumpshiftLogger.h"
+#include "renderer/DrawEngine.h"
+#include "anim/AnimationData.h"
+
+#ifndef ANIMATION_PLAYER_MAX_CATCH_UP
+#define ANIMATION_PLAYER_MAX_CATCH_UP 32 ///< Most frames decoded by one late update(); older time is dropped
+#endif
+
+/**
+ * @brief Tick-driven player for AnimationData sequences kept in flash.
+ *
+ * Frames are decoded one record at a time straight from PROGMEM into a
+ * single PackedFrame, so an animation costs its compressed size in flash
+ * and 12 bytes of RAM however long it is. update(now) works like
+ * ScrollEngine::update(): it catches up on any frames whose time has
+ * passed and pushes the result once.
+ *
+ * Output goes either directly to a LEDMatrix or through a DrawEngine, in
+ * which case only frames that differ reach the hardware.
+ *
+ * Example usage:
+ * @code
+ * #include "anim/BootSpinner.h"
+ *
+ * AnimationPlayer player(&display);
+ * player.setLoopCount(3);
+ * player.start(BOOTSPINNER);
+ *
+ * void loop()
+ * {
+ *     player.update(millis());
+ *     // ... other work ...
+ * }
+ * @endcode
+ */
+class AnimationPlayer
+{
+public:
+    AnimationPlayer(LEDMatrix *matrix, RumpshiftLogger *logger = nullptr);
+    AnimationPlayer(DrawEngine *engine, RumpshiftLogger *logger = nullptr);
+
+    /**
+     * @brief Play from the first frame; shown on the next update().
+     */
+    void start(const AnimationData &animation);
+
+    /**
+     * @brief Advance to the frame for now (millis()).
+     * @return true if a new frame was pushed to the display.
+     */
+    bool update(uint32_t now);
+
+    bool isDone() const { return _state == DONE; }
+
+    /**
+     * @brief Stop playing; the display keeps its last frame.
+     */
+    void stop() { _state = DONE; }
+
+    void setLoopCount(int count) { _loopCount = count; }
+
+    int loopCount() const { return _loopCount; }
+    int loopsDone() const { return _loopsDone; }
+    uint16_t frameIndex() const { return _index; }
+    const PackedFrame &frame() const { return _frame; }
+
+private:
+    enum State
+    {
+        DONE,
+        WAITING, ///< Started; the first update() sets the clock
+        PLAYING
+    };
+
+    LEDMatrix *_matrix = nullptr;
+    DrawEngine *_engine = nullptr;
+    RumpshiftLogger *_logger = nullptr;
+
+    AnimationData _animation = {nullptr, 0, 0};
+    PackedFrame _frame;
+
+    uint16_t _pos = 0;      ///< Next byte of _animation.data
+    uint16_t _index = 0;    ///< Frame on display
+    uint32_t _duration = 0; ///< ms for the current frame
+    uint32_t _frameStart = 0;
+    bool _corrupt = false;
+
+    int _loopCount = -1; ///< -1 = infinite
+    int _loopsDone = 0;
+
+    State _state = DONE;
+
+    void rewind();
+    bool decodeNext();
+    bool step();
+    uint8_t readByte();
+    void push(uint32_t now);
+};
@@ -0,0 +1,18 @@
+// Generated by tools/animc/animc.py - do not edit; regenerate instead.
+// Source: boot_spinner.txt
+// Options: --name BootSpinner --duration 60
+// 20 frames, 1200 ms per loop, 62 B (byte frames 1920 B = 31.0x, uint32_t[4] frames 320 B = 5.2x)
+#pragma once
+#include "anim/AnimationData.h"
+#include <avr/pgmspace.h>
+
+static constexpr uint8_t BOOTSPINNER_FRAMES[] PROGMEM = {
+    0x83, 0x3C, 0x0F, 0x1B, 0x27, 0x02, 0x10, 0x27, 0x02, 0x11, 0x1B, 0x02,
+    0x0F, 0x12, 0x02, 0x10, 0x13, 0x02, 0x11, 0x14, 0x02, 0x12, 0x20, 0x02,
+    0x13, 0x2C, 0x02, 0x14, 0x38, 0x02, 0x20, 0x44, 0x02, 0x2C, 0x50, 0x02,
+    0x38, 0x4F, 0x02, 0x44, 0x4E, 0x02, 0x4D, 0x50, 0x02, 0x4C, 0x4F, 0x02,
+    0x4B, 0x4E, 0x02, 0x3F, 0x4D, 0x02, 0x33, 0x4C, 0x02, 0x27, 0x4B, 0x02,
+    0x1B, 0x3F,
+};
+
+static constexpr AnimationData BOOTSPINNER = {BOOTSPINNER_FRAMES, sizeof(BOOTSPINNER_FRAMES), 20};
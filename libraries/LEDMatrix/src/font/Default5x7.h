@@ -1,16 +1,18 @@
 #pragma once
-#include "Font.h"
+#include "TableFont.h"
 
-class Default5x7 : public Font
+/**
+ * @brief Built-in 5x7 font covering printable ASCII (' ' to '~').
+ *
+ * Used by every renderer when no other font is set; shared() returns
+ * the one instance they use.
+ */
+class Default5x7 : public TableFont
 {
 public:
-    uint8_t lineHeight() const override { return 7; }
-    uint8_t baseline() const override { return 6; } // row index (0..6)
-    static uint8_t spacing() { return 1; }
+    Default5x7();
 
-    bool getGlyph(char c, Glyph &out) const override;
+    static uint8_t spacing() { return 1; }
 
-private:
-    static const uint8_t *glyphBitmap(char c);
-    static bool glyphMetrics(char c, Glyph &out);
+    static const Default5x7 &shared();
 };
@@ -0,0 +1,128 @@
+// Generated by tools/fontc/fontc.py - do not edit; regenerate instead.
+// Source: default5x7.bdf
+// Options: --name Default5x7 --space-width 3 --spacing 1
+// 95 glyphs (' '..'~'), 8 rows, bitmap 473 B, glyph table 380 B, 0 kerning pairs
+//
+// Include from exactly one .cpp and wrap DEFAULT5X7_TABLE in a TableFont.
+#pragma once
+#include "font/FontCommon.h"
+#include <avr/pgmspace.h>
+
+static constexpr uint8_t DEFAULT5X7_BITMAP[] PROGMEM = {
+    0x00, 0x00, 0x00, // ' '
+    0x00, 0x00, 0x5F, 0x00, 0x00, // '!'
+    0x00, 0x07, 0x00, 0x07, 0x00, // '"'
+    0x14, 0x7F, 0x14, 0x7F, 0x14, // '#'
+    0x24, 0x2A, 0x7F, 0x2A, 0x12, // '$'
+    0x23, 0x13, 0x08, 0x64, 0x62, // '%'
+    0x36, 0x49, 0x56, 0x20, 0x50, // '&'
+    0x00, 0x08, 0x07, 0x03, 0x00, // '''
+    0x00, 0x1C, 0x22, 0x41, 0x00, // '('
+    0x00, 0x41, 0x22, 0x1C, 0x00, // ')'
+    0x2A, 0x1C, 0x7F, 0x1C, 0x2A, // '*'
+    0x08, 0x08, 0x3E, 0x08, 0x08, // '+'
+    0x00, 0x80, 0x70, 0x30, 0x00, // ','
+    0x08, 0x08, 0x08, 0x08, 0x08, // '-'
+    0x00, 0x00, 0x60, 0x60, 0x00, // '.'
+    0x20, 0x10, 0x08, 0x04, 0x02, // '/'
+    0x3E, 0x51, 0x49, 0x45, 0x3E, // '0'
+    0x00, 0x42, 0x7F, 0x40, 0x00, // '1'
+    0x72, 0x49, 0x49, 0x49, 0x46, // '2'
+    0x21, 0x41, 0x49, 0x4D, 0x33, // '3'
+    0x18, 0x14, 0x12, 0x7F, 0x10, // '4'
+    0x27, 0x45, 0x45, 0x45, 0x39, // '5'
+    0x3C, 0x4A, 0x49, 0x49, 0x31, // '6'
+    0x41, 0x21, 0x11, 0x09, 0x07, // '7'
+    0x36, 0x49, 0x49, 0x49, 0x36, // '8'
+    0x46, 0x49, 0x49, 0x29, 0x1E, // '9'
+    0x00, 0x00, 0x14, 0x00, 0x00, // ':'
+    0x00, 0x40, 0x34, 0x00, 0x00, // ';'
+    0x00, 0x08, 0x14, 0x22, 0x41, // '<'
+    0x14, 0x14, 0x14, 0x14, 0x14, // '='
+    0x00, 0x41, 0x22, 0x14, 0x08, // '>'
+    0x02, 0x01, 0x59, 0x09, 0x06, // '?'
+    0x3E, 0x41, 0x5D, 0x59, 0x4E, // '@'
+    0x7C, 0x12, 0x11, 0x12, 0x7C, // 'A'
+    0x7F, 0x49, 0x49, 0x49, 0x36, // 'B'
+    0x3E, 0x41, 0x41, 0x41, 0x22, // 'C'
+    0x7F, 0x41, 0x41, 0x41, 0x3E, // 'D'
+    0x7F, 0x49, 0x49, 0x49, 0x41, // 'E'
+    0x7F, 0x09, 0x09, 0x09, 0x01, // 'F'
+    0x3E, 0x41, 0x41, 0x51, 0x73, // 'G'
+    0x7F, 0x08, 0x08, 0x08, 0x7F, // 'H'
+    0x00, 0x41, 0x7F, 0x41, 0x00, // 'I'
+    0x20, 0x40, 0x41, 0x3F, 0x01, // 'J'
+    0x7F, 0x08, 0x14, 0x22, 0x41, // 'K'
+    0x7F, 0x40, 0x40, 0x40, 0x40, // 'L'
+    0x7F, 0x02, 0x1C, 0x02, 0x7F, // 'M'
+    0x7F, 0x04, 0x08, 0x10, 0x7F, // 'N'
+    0x3E, 0x41, 0x41, 0x41, 0x3E, // 'O'
+    0x7F, 0x09, 0x09, 0x09, 0x06, // 'P'
+    0x3E, 0x41, 0x51, 0x21, 0x5E, // 'Q'
+    0x7F, 0x09, 0x19, 0x29, 0x46, // 'R'
+    0x26, 0x49, 0x49, 0x49, 0x32, // 'S'
+    0x03, 0x01, 0x7F, 0x01, 0x03, // 'T'
+    0x3F, 0x40, 0x40, 0x40, 0x3F, // 'U'
+    0x1F, 0x20, 0x40, 0x20, 0x1F, // 'V'
+    0x3F, 0x40, 0x38, 0x40, 0x3F, // 'W'
+    0x63, 0x14, 0x08, 0x14, 0x63, // 'X'
+    0x03, 0x04, 0x78, 0x04, 0x03, // 'Y'
+    0x61, 0x59, 0x49, 0x4D, 0x43, // 'Z'
+    0x00, 0x7F, 0x41, 0x41, 0x41, // '['
+    0x02, 0x04, 0x08, 0x10, 0x20, // '\\'
+    0x00, 0x41, 0x41, 0x41, 0x7F, // ']'
+    0x04, 0x02, 0x01, 0x02, 0x04, // '^'
+    0x40, 0x40, 0x40, 0x40, 0x40, // '_'
+    0x00, 0x03, 0x07, 0x08, 0x00, // '`'
+    0x20, 0x54, 0x54, 0x78, 0x40, // 'a'
+    0x7F, 0x28, 0x44, 0x44, 0x38, // 'b'
+    0x38, 0x44, 0x44, 0x44, 0x28, // 'c'
+    0x38, 0x44, 0x44, 0x28, 0x7F, // 'd'
+    0x38, 0x54, 0x54, 0x54, 0x18, // 'e'
+    0x00, 0x08, 0x7E, 0x09, 0x02, // 'f'
+    0x18, 0xA4, 0xA4, 0x9C, 0x78, // 'g'
+    0x7F, 0x08, 0x04, 0x04, 0x78, // 'h'
+    0x00, 0x44, 0x7D, 0x40, 0x00, // 'i'
+    0x20, 0x40, 0x40, 0x3D, 0x00, // 'j'
+    0x7F, 0x10, 0x28, 0x44, 0x00, // 'k'
+    0x00, 0x41, 0x7F, 0x40, 0x00, // 'l'
+    0x7C, 0x04, 0x78, 0x04, 0x78, // 'm'
+    0x7C, 0x08, 0x04, 0x04, 0x78, // 'n'
+    0x38, 0x44, 0x44, 0x44, 0x38, // 'o'
+    0xFC, 0x18, 0x24, 0x24, 0x18, // 'p'
+    0x18, 0x24, 0x24, 0x18, 0xFC, // 'q'
+    0x7C, 0x08, 0x04, 0x04, 0x08, // 'r'
+    0x48, 0x54, 0x54, 0x54, 0x24, // 's'
+    0x04, 0x04, 0x3F, 0x44, 0x24, // 't'
+    0x3C, 0x40, 0x40, 0x20, 0x7C, // 'u'
+    0x1C, 0x20, 0x40, 0x20, 0x1C, // 'v'
+    0x3C, 0x40, 0x30, 0x40, 0x3C, // 'w'
+    0x44, 0x28, 0x10, 0x28, 0x44, // 'x'
+    0x4C, 0x90, 0x90, 0x90, 0x7C, // 'y'
+    0x44, 0x64, 0x54, 0x4C, 0x44, // 'z'
+    0x00, 0x08, 0x36, 0x41, 0x00, // '{'
+    0x00, 0x00, 0x77, 0x00, 0x00, // '|'
+    0x00, 0x41, 0x36, 0x08, 0x00, // '}'
+    0x02, 0x01, 0x02, 0x04, 0x02, // '~'
+};
+
+static constexpr GlyphEntry DEFAULT5X7_GLYPHS[] PROGMEM = {
+    {0, 3}, {3, 5}, {8, 5}, {13, 5}, {18, 5}, {23, 5}, {28, 5}, {33, 5},
+    {38, 5}, {43, 5}, {48, 5}, {53, 5}, {58, 5}, {63, 5}, {68, 5}, {73, 5},
+    {78, 5}, {83, 5}, {88, 5}, {93, 5}, {98, 5}, {103, 5}, {108, 5}, {113, 5},
+    {118, 5}, {123, 5}, {128, 5}, {133, 5}, {138, 5}, {143, 5}, {148, 5}, {153, 5},
+    {158, 5}, {163, 5}, {168, 5}, {173, 5}, {178, 5}, {183, 5}, {188, 5}, {193, 5},
+    {198, 5}, {203, 5}, {208, 5}, {213, 5}, {218, 5}, {223, 5}, {228, 5}, {233, 5},
+    {238, 5}, {243, 5}, {248, 5}, {253, 5}, {258, 5}, {263, 5}, {268, 5}, {273, 5},
+    {278, 5}, {283, 5}, {288, 5}, {293, 5}, {298, 5}, {303, 5}, {308, 5}, {313, 5},
+    {318, 5}, {323, 5}, {328, 5}, {333, 5}, {338, 5}, {343, 5}, {348, 5}, {353, 5},
+    {358, 5}, {363, 5}, {368, 5}, {373, 5}, {378, 5}, {383, 5}, {388, 5}, {393, 5},
+    {398, 5}, {403, 5}, {408, 5}, {413, 5}, {418, 5}, {423, 5}, {428, 5}, {433, 5},
+    {438, 5}, {443, 5}, {448, 5}, {453, 5}, {458, 5}, {463, 5}, {468, 5},
+};
+
+static constexpr FontTable DEFAULT5X7_TABLE = {' ', '~', 8, 1, DEFAULT5X7_BITMAP, DEFAULT5X7_GLYPHS, nullptr, 0, 0};
+
+static_assert(sizeof(DEFAULT5X7_GLYPHS) / sizeof(GlyphEntry) == DEFAULT5X7_TABLE.count(), "one entry per character");
+static_assert(sizeof(DEFAULT5X7_BITMAP) == 473, "bitmap size");
+static_assert(sizeof(DEFAULT5X7_GLYPHS) == 380, "glyph table size");
@@ -0,0 +1,15 @@
+#include "Font.h"
+
+Font::~Font()
+{
+    delete _metrics[0];
+    delete _metrics[1];
+}
+
+GlyphMetricsCache *Font::metricsCache(bool proportional) const
+{
+    GlyphMetricsCache *&cache = _metrics[proportional ? 1 : 0];
+    if (!cache)
+        cache = new GlyphMetricsCache();
+    return cache;
+}
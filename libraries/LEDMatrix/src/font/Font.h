@@ -6,7 +6,10 @@
 class Font
 {
 public:
-    virtual ~Font() = default;
+    Font() = default;
+    Font(const Font &) {} // a copy fills its own metrics cache
+    Font &operator=(const Font &) { return *this; }
+    virtual ~Font();
 
     // Overall metrics (for layout/scrolling)
     virtual uint8_t lineHeight() const = 0; // e.g., 7 for a 5x7 font
@@ -15,4 +18,14 @@ public:
 
     // Returns true if glyph exists; fills out 'out' with metrics + bitmap ptr
     virtual bool getGlyph(char c, Glyph &out) const = 0;
+
+    // Extra columns between left and right (negative tightens); 0 if none
+    virtual int8_t kerning(char /*left*/, char /*right*/) const { return 0; }
+
+    // Glyph metrics cache shared by every TextLayout using this font, one per
+    // layout mode; allocated on first use, nullptr if that fails
+    GlyphMetricsCache *metricsCache(bool proportional) const;
+
+private:
+    mutable GlyphMetricsCache *_metrics[2] = {nullptr, nullptr}; // monospaced, proportional
 };
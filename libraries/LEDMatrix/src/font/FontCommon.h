@@ -1,6 +1,11 @@
 // fonts/FontCommon.h
 #pragma once
 #include <Arduino.h>
+#include <avr/pgmspace.h>
+
+#ifndef FONT_TABLE_MAX_GLYPH_WIDTH
+#define FONT_TABLE_MAX_GLYPH_WIDTH 16 // widest glyph a run-length coded table may hold
+#endif
 
 // A single glyph’s metrics + bitmap pointer (bit-packed)
 struct Glyph
@@ -11,4 +16,77 @@ struct Glyph
     int8_t xOffset;        // draw offset (usually 0 for simple fonts)
     int8_t yOffset;        // baseline offset (0 = top aligned; positive moves down)
     const uint8_t *bitmap; // PROGMEM pointer, bit-packed columns or rows
+    bool ram = false;      // bitmap was decoded into RAM (compressed fonts)
+
+    // Column col as drawn: bit r = row r, clipped to height, moved by yOffset
+    uint8_t column(uint8_t col) const
+    {
+        uint8_t bits = ram ? bitmap[col] : pgm_read_byte(bitmap + col);
+        if (height < 8)
+            bits &= (1 << height) - 1;
+        return yOffset >= 0 ? bits << yOffset : bits >> -yOffset;
+    }
+};
+
+// Where one glyph's columns sit in a FontTable bitmap
+struct GlyphEntry
+{
+    uint16_t offset; // first column in the bitmap
+    uint8_t width;   // columns (0 = character not in the font)
+};
+
+#ifndef TEXT_LAYOUT_CACHE_FIRST
+#define TEXT_LAYOUT_CACHE_FIRST ' ' // first character whose metrics are cached
+#endif
+
+#ifndef TEXT_LAYOUT_CACHE_LAST
+#define TEXT_LAYOUT_CACHE_LAST '~' // last character whose metrics are cached
+#endif
+
+// Where a character's columns go in laid-out text (see TextLayout)
+struct GlyphMetrics
+{
+    uint8_t left;    // glyph columns skipped on the left (proportional layout)
+    uint8_t width;   // glyph columns drawn, starting at left
+    uint8_t advance; // columns the character takes, including spacing after it
+};
+
+// Metrics of TEXT_LAYOUT_CACHE_FIRST..TEXT_LAYOUT_CACHE_LAST in one font and
+// layout mode, filled in as characters are first laid out
+struct GlyphMetricsCache
+{
+    static constexpr uint8_t SIZE = TEXT_LAYOUT_CACHE_LAST - TEXT_LAYOUT_CACHE_FIRST + 1;
+
+    GlyphMetrics entries[SIZE];
+    uint8_t filled[(SIZE + 7) / 8] = {0}; // bit per entry that is set
+};
+
+// Columns to add between a pair of characters (usually negative)
+struct KernPair
+{
+    char left;
+    char right;
+    int8_t adjust;
+};
+
+#define FONT_TABLE_RLE 0x01 // bitmap holds run-length coded glyphs (see TableFont)
+
+// Compile-time font: every glyph's columns back to back (column-major,
+// bit r = row r) and one entry per character from first to last, so a
+// lookup is a single indexed load of glyphs[c - first]. All arrays live
+// in PROGMEM. Tables are written by tools/fontc.
+struct FontTable
+{
+    char first;               // first character covered
+    char last;                // last character covered
+    uint8_t height;           // rows used by the bitmaps
+    uint8_t spacing;          // blank columns after each glyph
+    const uint8_t *bitmap;    // PROGMEM columns
+    const GlyphEntry *glyphs; // PROGMEM, last - first + 1 entries
+    const KernPair *kerning;  // PROGMEM, sorted by (left, right); may be null
+    uint16_t kerningCount;
+    uint8_t flags;            // FONT_TABLE_* bits
+
+    constexpr bool covers(char c) const { return c >= first && c <= last; }
+    constexpr uint16_t count() const { return last - first + 1; }
 };
@@ -0,0 +1,75 @@
+#include "TableFont.h"
+#include <avr/pgmspace.h>
+
+bool TableFont::getGlyph(char c, Glyph &out) const
+{
+    if (!_table.covers(c))
+        return false;
+
+    const GlyphEntry *entry = _table.glyphs + (c - _table.first);
+    out.width = pgm_read_byte(&entry->width);
+    if (out.width == 0)
+        return false;
+
+    out.height = _table.height;
+    out.xAdvance = out.width + _table.spacing;
+    out.xOffset = 0;
+    out.yOffset = 0;
+    out.bitmap = _table.bitmap + pgm_read_word(&entry->offset);
+    out.ram = false;
+
+    if (_table.flags & FONT_TABLE_RLE)
+    {
+        if (out.width > FONT_TABLE_MAX_GLYPH_WIDTH)
+            return false;
+        decode(out.bitmap, out.width);
+        out.bitmap = _columns;
+        out.ram = true;
+    }
+    return true;
+}
+
+int8_t TableFont::kerning(char left, char right) const
+{
+    if (!_table.kerning)
+        return 0;
+
+    // Pairs are sorted by (left, right)
+    uint16_t key = ((uint8_t)left << 8) | (uint8_t)right;
+    int lo = 0;
+    int hi = (int)_table.kerningCount - 1;
+    while (lo <= hi)
+    {
+        int mid = (lo + hi) / 2;
+        const KernPair *pair = _table.kerning + mid;
+        uint16_t at = ((uint8_t)pgm_read_byte(&pair->left) << 8) | (uint8_t)pgm_read_byte(&pair->right);
+        if (at == key)
+            return (int8_t)pgm_read_byte(&pair->adjust);
+        if (at < key)
+            lo = mid + 1;
+        else
+            hi = mid - 1;
+    }
+    return 0;
+}
+
+void TableFont::decode(const uint8_t *in, uint8_t width) const
+{
+    uint8_t n = 0;
+    while (n < width)
+    {
+        uint8_t control = pgm_read_byte(in++);
+        uint8_t count = (control & 0x7F) + 1;
+        if (control & 0x80)
+        {
+            uint8_t value = pgm_read_byte(in++);
+            while (count-- && n < width)
+                _columns[n++] = value;
+        }
+        else
+        {
+            while (count-- && n < width)
+                _columns[n++] = pgm_read_byte(in++);
+        }
+    }
+}
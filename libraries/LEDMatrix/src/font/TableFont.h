@@ -0,0 +1,43 @@
+#pragma once
+#include "Font.h"
+
+/**
+ * @brief Font backed by a compile-time FontTable.
+ *
+ * getGlyph() is one range check and one indexed read of the glyph table;
+ * the bitmap pointer it returns points straight into flash. All fonts in
+ * the library use this format, so every renderer reads glyphs the same way.
+ *
+ * Tables marked FONT_TABLE_RLE store each glyph run-length coded. A
+ * control byte n < 0x80 is followed by n + 1 literal columns; n >= 0x80
+ * by one column repeated (n & 0x7F) + 1 times. Such glyphs are decoded
+ * into a buffer in the font, so their bitmap stays valid only until the
+ * next getGlyph() on the same font. Callers that keep a glyph across
+ * calls copy its columns first, as TextColumnStream does.
+ */
+class TableFont : public Font
+{
+public:
+    constexpr TableFont(const FontTable &table, uint8_t baseline)
+        : _table(table), _baseline(baseline), _columns{} {}
+
+    uint8_t lineHeight() const override { return _table.height; }
+    uint8_t baseline() const override { return _baseline; }
+    uint8_t glyphSpacing() const { return _table.spacing; }
+
+    bool getGlyph(char c, Glyph &out) const override;
+
+    /**
+     * @brief Kerning pair lookup (binary search of the table's pairs).
+     */
+    int8_t kerning(char left, char right) const override;
+
+    const FontTable &table() const { return _table; }
+
+private:
+    const FontTable &_table;
+    uint8_t _baseline;
+    mutable uint8_t _columns[FONT_TABLE_MAX_GLYPH_WIDTH]; ///< Decoded RLE glyph
+
+    void decode(const uint8_t *in, uint8_t width) const;
+};
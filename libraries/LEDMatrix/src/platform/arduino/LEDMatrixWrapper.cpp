@@ -1,4 +1,6 @@
 #include "LEDMatrixWrapper.h"
+
+#if LEDMATRIX_HAS_BOARD_MATRIX
 #include <avr/pgmspace.h>
 #include "renderer/DrawEngine.h"
 
@@ -6,7 +8,7 @@
  * @brief Construct a new LEDMatrixWrapper without logger
  */
 LEDMatrixWrapper::LEDMatrixWrapper()
-    : _logger(nullptr), _engine(nullptr)
+    : _logger(nullptr), _engine(nullptr), _scroller(this)
 {
 }
 
@@ -15,7 +17,7 @@ LEDMatrixWrapper::LEDMatrixWrapper()
  * @param logger Pointer to RumpshiftLogger instance
  */
 LEDMatrixWrapper::LEDMatrixWrapper(RumpshiftLogger *logger)
-    : _logger(logger), _engine(nullptr)
+    : _logger(logger), _engine(nullptr), _scroller(this, logger)
 {
 }
 
@@ -37,7 +39,7 @@ void LEDMatrixWrapper::begin()
 void LEDMatrixWrapper::clear()
 {
     clearFrame();
-    _matrix.renderBitmap(_frame, Rows::EIGHT, Columns::TWELVE);
+    pushFrame();
 
     if (_logger)
         _logger->debug("LEDMatrixWrapper: display cleared");
@@ -46,20 +48,33 @@ void LEDMatrixWrapper::clear()
 /**
  * @brief Render a prebuilt frame on the hardware
  */
-void LEDMatrixWrapper::renderFrame(const uint8_t frame[Rows::EIGHT][Columns::TWELVE])
+void LEDMatrixWrapper::renderFrame(const PackedFrame &frame)
 {
-    // Copy to internal buffer
-    for (int r = 0; r < Rows::EIGHT; r++)
-        for (int c = 0; c < Columns::TWELVE; c++)
-            _frame[r][c] = frame[r][c];
-
-    // Render to hardware
-    _matrix.renderBitmap(_frame, Rows::EIGHT, Columns::TWELVE);
+    // Copy to internal buffer (three words) and render to hardware
+    _frame = frame;
+    pushFrame();
 
     if (_logger)
         _logger->debug("LEDMatrixWrapper: frame rendered");
 }
 
+/**
+ * @brief Shift the framebuffer one column left and render it
+ */
+void LEDMatrixWrapper::scrollLeft(uint8_t incoming)
+{
+    _frame.shiftLeft(incoming);
+    pushFrame();
+}
+
+/**
+ * @brief loadFrame() takes the packed words as they are; no repacking
+ */
+void LEDMatrixWrapper::pushFrame()
+{
+    _matrix.loadFrame(_frame.data());
+}
+
 /**
  * @brief Set brightness on the underlying hardware
  */
@@ -76,9 +91,7 @@ void LEDMatrixWrapper::setBrightness(uint8_t level)
  */
 void LEDMatrixWrapper::clearFrame()
 {
-    for (int r = 0; r < Rows::EIGHT; r++)
-        for (int c = 0; c < Columns::TWELVE; c++)
-            _frame[r][c] = 0;
+    _frame.clear();
 
     if (_logger)
         _logger->debug("LEDMatrixWrapper: frame buffer cleared");
@@ -108,7 +121,7 @@ String LEDMatrixWrapper::toString() const
     {
         for (int c = 0; c < Columns::TWELVE; c++)
         {
-            result += (_frame[r][c] ? "#" : " ");
+            result += (_frame.get(r, c) ? "#" : " ");
         }
         result += "\n";
     }
@@ -120,69 +133,16 @@ String LEDMatrixWrapper::toString() const
 }
 
 // --------------------------------------------
-// Letter Drawing
+// Letter/Number Drawing (both come from the font)
 // --------------------------------------------
 void LEDMatrixWrapper::drawLetter(char c, int colOffset)
 {
-    switch (c)
-    {
-    case 'H':
-        drawH(colOffset);
-        break;
-    case 'E':
-        drawE(colOffset);
-        break;
-    case 'L':
-        drawL(colOffset);
-        break;
-    case 'O':
-        drawO(colOffset);
-        break;
-    default:
-        break; // unsupported chars
-    }
+    drawChar(c, colOffset);
 }
 
-// --------------------------------------------
-// Number Drawing
-// --------------------------------------------
 void LEDMatrixWrapper::drawNumber(char n, int colOffset)
 {
-    switch (n)
-    {
-    case '0':
-        draw0(colOffset);
-        break;
-    case '1':
-        draw1(colOffset);
-        break;
-    case '2':
-        draw2(colOffset);
-        break;
-    case '3':
-        draw3(colOffset);
-        break;
-    case '4':
-        draw4(colOffset);
-        break;
-    case '5':
-        draw5(colOffset);
-        break;
-    case '6':
-        draw6(colOffset);
-        break;
-    case '7':
-        draw7(colOffset);
-        break;
-    case '8':
-        draw8(colOffset);
-        break;
-    case '9':
-        draw9(colOffset);
-        break;
-    default:
-        break; // unsupported numbers
-    }
+    drawChar(n, colOffset);
 }
 
 // --------------------------------------------
@@ -191,27 +151,28 @@ void LEDMatrixWrapper::drawNumber(char n, int colOffset)
 void LEDMatrixWrapper::renderText(const String &text)
 {
     int colOffset = 0;
-    for (size_t i = 0; i < text.length(); i++)
+    for (size_t i = 0; i < text.length() && colOffset < Columns::TWELVE; i++)
     {
-        char c = text[i];
-        if (c >= '0' && c <= '9')
-            drawNumber(c, colOffset);
-        else if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z'))
-            drawLetter(toupper(c), colOffset);
+        Glyph glyph;
+        if (!font()->getGlyph(text[i], glyph))
+            continue;
 
-        colOffset += 4; // basic spacing; could adjust per char
+        drawChar(text[i], colOffset);
+        colOffset += glyph.xAdvance;
     }
 
     // After drawing into frame buffer, optionally render
-    renderFrame(_frame);
+    pushFrame();
 }
 
 #include "LEDMatrixWrapper.h"
 #include <avr/pgmspace.h>
+#include "font/Default5x7.h"
 
 void LEDMatrixWrapper::setFont(const Font *font)
 {
     _font = font;
+    _scroller.setFont(font);
     if (_logger)
         _logger->info("LEDMatrixWrapper: font set");
 }
@@ -224,39 +185,26 @@ void LEDMatrixWrapper::setFont(const Font *font)
  */
 void LEDMatrixWrapper::drawChar(char c, int colOffset)
 {
-    if (!_font)
-    {
-        if (_logger)
-            _logger->warn("LEDMatrixWrapper: no font set");
-        return;
-    }
-
     Glyph glyph;
-    if (!_font->getGlyph(c, glyph) || !glyph.bitmap)
+    if (!font()->getGlyph(c, glyph) || !glyph.bitmap)
     {
         if (_logger)
             _logger->warn(String("LEDMatrixWrapper: no glyph for '") + c + "'");
         return;
     }
 
-    // Loop through each column of the glyph
+    // Glyph columns use the framebuffer's column format; OR each one in whole
     for (int col = 0; col < glyph.width; col++)
     {
-        uint8_t colBits = pgm_read_byte(glyph.bitmap + col);
-
-        for (int row = 0; row < glyph.height; row++)
-        {
-            bool pixelOn = colBits & (1 << row);
-            if (pixelOn)
-            {
-                // Write into internal frame buffer at proper offset
-                int x = colOffset + col + glyph.xOffset;
-                int y = row + glyph.yOffset;
-                if (x >= 0 && x < Columns::TWELVE && y >= 0 && y < Rows::EIGHT)
-                {
-                    _frame[y][x] = 1;
-                }
-            }
-        }
+        int x = colOffset + col + glyph.xOffset;
+        if (x >= 0 && x < Columns::TWELVE)
+            _frame.orColumn(x, glyph.column(col));
     }
 }
+
+const Font *LEDMatrixWrapper::font() const
+{
+    return _font ? _font : &Default5x7::shared();
+}
+
+#endif // LEDMATRIX_HAS_BOARD_MATRIX
@@ -1,9 +1,23 @@
 #pragma once
+
+// Only built for the UNO R4 WiFi, the board with the on-board matrix; on
+// other targets (host tests) the Arduino-specific classes are left out.
+// Build with -DLEDMATRIX_HAS_BOARD_MATRIX=0 or =1 to override.
+#ifndef LEDMATRIX_HAS_BOARD_MATRIX
+#if defined(ARDUINO_UNOR4_WIFI)
+#define LEDMATRIX_HAS_BOARD_MATRIX 1
+#else
+#define LEDMATRIX_HAS_BOARD_MATRIX 0
+#endif
+#endif
+
+#if LEDMATRIX_HAS_BOARD_MATRIX
 #include <Arduino.h>
 #include <Arduino_LED_Matrix.h>
 #include "LEDMatrix.h"
 #include "RumpshiftLogger.h"
 #include "font/Font.h"
+#include "renderer/ScrollEngine.h"
 
 class DrawEngine;
 
@@ -39,12 +53,26 @@ public:
      */
     void clear() override;
 
+    using LEDMatrix::renderFrame;
+
+    /**
+     * @brief Copy a packed frame into the framebuffer and push it with loadFrame().
+     *
+     * @param frame Packed 8x12 frame
+     */
+    void renderFrame(const PackedFrame &frame) override;
+
     /**
-     * @brief Render a prebuilt frame on the hardware.
+     * @brief Scroll the display one column left and push it.
      *
-     * @param frame 2D array of size ROWS x COLUMNS representing LED states
+     * @param incoming New rightmost column (bit r = row r)
      */
-    void renderFrame(const uint8_t frame[Rows::EIGHT][Columns::TWELVE]) override;
+    void scrollLeft(uint8_t incoming);
+
+    /**
+     * @brief The framebuffer as last drawn or rendered.
+     */
+    const PackedFrame &frame() const { return _frame; }
 
     /**
      * @brief Set the brightness of the LED matrix.
@@ -80,7 +108,7 @@ public:
     /**
      * @brief Draw a single letter into the internal frame buffer.
      *
-     * @param c Character to draw (A-Z)
+     * @param c Character to draw (A-Z, a-z)
      * @param colOffset Column offset to start drawing
      */
     void drawLetter(char c, int colOffset);
@@ -100,59 +128,44 @@ public:
      */
     void renderText(const String &text);
 
-    void setFont(const Font *font); ///< Set current font for text rendering
+    void setFont(const Font *font); ///< Set current font for text rendering (and scrolling)
     void drawChar(char c, int colOffset);
 
+    // --- Scrolling ---
+
+    /**
+     * @brief Non-blocking scroller bound to this display.
+     *
+     * Call scroller().start(text) once and scroller().update(millis())
+     * from loop().
+     */
+    ScrollEngine &scroller() { return _scroller; }
+    const ScrollEngine &scroller() const { return _scroller; }
+
+    void setScrollSpeed(uint32_t ms) { _scroller.setSpeed(ms); } ///< ms per column shift
+    void setLoopCount(int count) { _scroller.setLoopCount(count); } ///< -1 = infinite
+    void setStopTime(uint32_t ms) { _scroller.setStopTime(ms); } ///< Pause between loops
+
 private:
     ArduinoLEDMatrix _matrix;                     ///< Underlying hardware object
-    uint8_t _frame[Rows::EIGHT][Columns::TWELVE]; ///< Local frame buffer for the visible display
+    PackedFrame _frame;                           ///< Local frame buffer for the visible display
     RumpshiftLogger *_logger = nullptr;           ///< Optional logger
     uint8_t _textSize = TextSize::MEDIUM;         ///< Current text size
     DrawEngine *_engine = nullptr;                ///< Optional engine for rendering frames
     const Font *_font = nullptr;                  ///< Active font (default can be set in begin())
+    ScrollEngine _scroller;                       ///< Scrolls text onto this display
 
     /**
      * @brief Clear the internal frame buffer.
      */
     void clearFrame();
 
-    // --- Internal helpers for drawing specific letters/numbers ---
-    void drawA(int colOffset);
-    void drawB(int colOffset);
-    void drawC(int colOffset);
-    void drawD(int colOffset);
-    void drawE(int colOffset);
-    void drawF(int colOffset);
-    void drawG(int colOffset);
-    void drawH(int colOffset);
-    void drawI(int colOffset);
-    void drawJ(int colOffset);
-    void drawK(int colOffset);
-    void drawL(int colOffset);
-    void drawM(int colOffset);
-    void drawN(int colOffset);
-    void drawO(int colOffset);
-    void drawP(int colOffset);
-    void drawQ(int colOffset);
-    void drawR(int colOffset);
-    void drawS(int colOffset);
-    void drawT(int colOffset);
-    void drawU(int colOffset);
-    void drawV(int colOffset);
-    void drawW(int colOffset);
-    void drawX(int colOffset);
-    void drawY(int colOffset);
-    void drawZ(int colOffset);
-
-    // Numbers
-    void draw0(int colOffset);
-    void draw1(int colOffset);
-    void draw2(int colOffset);
-    void draw3(int colOffset);
-    void draw4(int colOffset);
-    void draw5(int colOffset);
-    void draw6(int colOffset);
-    void draw7(int colOffset);
-    void draw8(int colOffset);
-    void draw9(int colOffset);
+    /**
+     * @brief Send the frame buffer to the hardware.
+     */
+    void pushFrame();
+
+    const Font *font() const; ///< Active font, or Default5x7
 };
+
+#endif // LEDMATRIX_HAS_BOARD_MATRIX
@@ -0,0 +1,138 @@
+#include "VirtualLEDMatrix.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <stdio.h>
+#include <string.h>
+
+VirtualLEDMatrix::VirtualLEDMatrix(size_t maxFrames)
+    : _maxFrames(maxFrames)
+{
+}
+
+void VirtualLEDMatrix::begin()
+{
+    clear();
+}
+
+void VirtualLEDMatrix::clear()
+{
+    present(PackedFrame());
+}
+
+void VirtualLEDMatrix::renderFrame(const PackedFrame &frame)
+{
+    present(frame);
+}
+
+void VirtualLEDMatrix::present(const PackedFrame &frame)
+{
+    _current = frame;
+    _presented++;
+    if (_captures.size() < _maxFrames)
+        _captures.push_back({_now, frame});
+}
+
+void VirtualLEDMatrix::reset()
+{
+    _captures.clear();
+    _presented = 0;
+}
+
+String VirtualLEDMatrix::toAscii(const PackedFrame &frame, char on, char off)
+{
+    String out;
+    for (uint8_t r = 0; r < PackedFrame::ROWS; r++)
+    {
+        for (uint8_t c = 0; c < PackedFrame::COLUMNS; c++)
+            out += frame.get(r, c) ? on : off;
+        out += '\n';
+    }
+    return out;
+}
+
+size_t VirtualLEDMatrix::stripFrames(size_t first, size_t count, size_t step) const
+{
+    if (first >= _captures.size() || step == 0)
+        return 0;
+    size_t available = (_captures.size() - first + step - 1) / step;
+    return count < available ? count : available;
+}
+
+String VirtualLEDMatrix::asciiStrip(size_t first, size_t count, size_t step) const
+{
+    size_t frames = stripFrames(first, count, step);
+    String out;
+    for (uint8_t r = 0; r < PackedFrame::ROWS && frames; r++)
+    {
+        for (size_t i = 0; i < frames; i++)
+        {
+            if (i)
+                out += ' ';
+            const PackedFrame &frame = _captures[first + i * step].frame;
+            for (uint8_t c = 0; c < PackedFrame::COLUMNS; c++)
+                out += frame.get(r, c) ? '#' : '.';
+        }
+        out += '\n';
+    }
+    return out;
+}
+
+bool VirtualLEDMatrix::writeAscii(const char *path, size_t first, size_t count, size_t step) const
+{
+    FILE *f = fopen(path, "w");
+    if (!f)
+        return false;
+
+    // One header line per frame so the strip can be matched to timestamps
+    size_t frames = stripFrames(first, count, step);
+    fprintf(f, "# %u frames:", (unsigned)frames);
+    for (size_t i = 0; i < frames; i++)
+        fprintf(f, " %lu", (unsigned long)_captures[first + i * step].time);
+    fprintf(f, " ms\n");
+
+    String strip = asciiStrip(first, count, step);
+    bool ok = fwrite(strip.c_str(), 1, strip.length(), f) == strip.length();
+    return fclose(f) == 0 && ok;
+}
+
+bool VirtualLEDMatrix::writePpm(const char *path, size_t first, size_t count, size_t step, uint8_t scale) const
+{
+    size_t frames = stripFrames(first, count, step);
+    if (!frames || !scale)
+        return false;
+
+    FILE *f = fopen(path, "wb");
+    if (!f)
+        return false;
+
+    // Frames are COLUMNS LEDs wide with one dark LED between them
+    size_t widthLeds = frames * (PackedFrame::COLUMNS + 1) - 1;
+    size_t width = widthLeds * scale;
+    size_t height = PackedFrame::ROWS * scale;
+    fprintf(f, "P6\n%u %u\n255\n", (unsigned)width, (unsigned)height);
+
+    static const uint8_t LIT[3] = {255, 32, 16};
+    static const uint8_t DARK[3] = {24, 8, 8};
+    static const uint8_t GAP[3] = {0, 0, 0};
+
+    std::vector<uint8_t> line(width * 3);
+    bool ok = true;
+    for (uint8_t r = 0; r < PackedFrame::ROWS && ok; r++)
+    {
+        for (size_t led = 0; led < widthLeds; led++)
+        {
+            size_t i = led / (PackedFrame::COLUMNS + 1);
+            size_t c = led % (PackedFrame::COLUMNS + 1);
+            const uint8_t *rgb = c == PackedFrame::COLUMNS ? GAP
+                                 : _captures[first + i * step].frame.get(r, c) ? LIT
+                                                                                : DARK;
+            for (uint8_t x = 0; x < scale; x++)
+                memcpy(&line[(led * scale + x) * 3], rgb, 3);
+        }
+        for (uint8_t y = 0; y < scale && ok; y++)
+            ok = fwrite(line.data(), 1, line.size(), f) == line.size();
+    }
+    return fclose(f) == 0 && ok;
+}
+
+#endif // __unix__ || __APPLE__
@@ -0,0 +1,105 @@
+#pragma once
+#include "LEDMatrix.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <vector>
+
+#ifndef VIRTUAL_MATRIX_MAX_FRAMES
+#define VIRTUAL_MATRIX_MAX_FRAMES 4096 ///< Frames kept for inspection; later ones are only counted
+#endif
+
+/**
+ * @class VirtualLEDMatrix
+ * @brief Host-only LEDMatrix that records what would have been shown.
+ *
+ * Every frame pushed through renderFrame() or clear() is captured with the
+ * time set by setTime(), so renderers (ScrollEngine, DrawEngine, ...) can
+ * be tested and benchmarked on Linux/macOS without a board. Captures can
+ * be compared as ASCII art for golden tests, or exported as ASCII or PPM
+ * strips (frames side by side) to look at a whole animation at once.
+ *
+ * busBytes() counts what the UNO R4 matrix would move: three words per
+ * frame.
+ *
+ * Only built on Unix-like hosts; on boards this header is empty.
+ */
+class VirtualLEDMatrix : public LEDMatrix
+{
+public:
+    struct Capture
+    {
+        uint32_t time;     ///< setTime() value when the frame arrived
+        PackedFrame frame; ///< Frame as presented
+    };
+
+    explicit VirtualLEDMatrix(size_t maxFrames = VIRTUAL_MATRIX_MAX_FRAMES);
+
+    using LEDMatrix::renderFrame;
+
+    void begin() override;
+    void clear() override;
+    void renderFrame(const PackedFrame &frame) override;
+    void setBrightness(uint8_t level) override { _brightness = level; }
+    void setTextSize(uint8_t size) override { _textSize = size; }
+
+    /**
+     * @brief Timestamp for the frames that follow (ms, like millis()).
+     */
+    void setTime(uint32_t now) { _now = now; }
+    uint32_t time() const { return _now; }
+
+    /**
+     * @brief Drop all captures and counters; the display keeps its content.
+     */
+    void reset();
+
+    const PackedFrame &current() const { return _current; } ///< What the display shows
+    uint8_t brightness() const { return _brightness; }
+
+    size_t captureCount() const { return _captures.size(); }
+    const Capture &capture(size_t index) const { return _captures[index]; }
+    uint32_t framesPresented() const { return _presented; } ///< Including frames past the capture limit
+    uint32_t busBytes() const { return _presented * PackedFrame::WORDS * sizeof(uint32_t); }
+
+    /**
+     * @brief One frame as 8 lines of on/off characters.
+     */
+    static String toAscii(const PackedFrame &frame, char on = '#', char off = '.');
+
+    /**
+     * @brief Captured frames side by side, one space between frames.
+     *
+     * @param first First capture
+     * @param count Captures to include (clipped to what was captured)
+     * @param step  Take every step-th capture
+     */
+    String asciiStrip(size_t first = 0, size_t count = (size_t)-1, size_t step = 1) const;
+
+    /**
+     * @brief Write asciiStrip() to a text file.
+     */
+    bool writeAscii(const char *path, size_t first = 0, size_t count = (size_t)-1, size_t step = 1) const;
+
+    /**
+     * @brief Write the captures as a binary PPM (P6) strip.
+     *
+     * Each LED becomes a scale x scale block, lit red on dark, with a
+     * one-LED gap between frames.
+     */
+    bool writePpm(const char *path, size_t first = 0, size_t count = (size_t)-1, size_t step = 1,
+                  uint8_t scale = 4) const;
+
+private:
+    std::vector<Capture> _captures;
+    size_t _maxFrames;
+    PackedFrame _current;
+    uint32_t _now = 0;
+    uint32_t _presented = 0;
+    uint8_t _brightness = 255;
+    uint8_t _textSize = TextSize::MEDIUM;
+
+    void present(const PackedFrame &frame);
+    size_t stripFrames(size_t first, size_t count, size_t step) const; ///< Captures a strip covers
+};
+
+#endif // __unix__ || __APPLE__
@@ -0,0 +1,21 @@
+// Host stand-in for <avr/pgmspace.h>: flash is ordinary memory on Linux/macOS.
+// Native test environments put platform/host on the include path.
+#pragma once
+#include <stdint.h>
+#include <string.h>
+
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+#ifndef pgm_read_byte
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#endif
+#ifndef pgm_read_word
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#endif
+#ifndef pgm_read_dword
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#endif
+#ifndef memcpy_P
+#define memcpy_P memcpy
+#endif
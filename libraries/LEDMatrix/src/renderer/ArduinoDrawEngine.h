@@ -2,11 +2,13 @@
 #include "DrawEngine.h"
 #include "platform/arduino/LEDMatrixWrapper.h"
 
+#if LEDMATRIX_HAS_BOARD_MATRIX
+
 /**
  * @brief Arduino-specific implementation of DrawEngine.
  *
- * This class uses LEDMatrixWrapper to perform actual pixel-level
- * operations while DrawEngine handles higher-level drawing logic.
+ * Presents frames through LEDMatrixWrapper, which hands the packed words
+ * straight to the UNO R4 matrix; buffering and diffing live in DrawEngine.
  */
 class ArduinoDrawEngine : public DrawEngine
 {
@@ -22,14 +24,6 @@ public:
      * @brief Initialize hardware (via LEDMatrixWrapper) and clear display
      */
     void begin() override;
-
-    /**
-     * @brief Draw a text string using the active font
-     */
-    void drawText(const char *text, int colOffset = 0) override;
-
-    /**
-     * @brief Render the current framebuffer to the Arduino hardware
-     */
-    void render() override;
 };
+
+#endif // LEDMATRIX_HAS_BOARD_MATRIX
@@ -1,10 +1,15 @@
 #include "DrawEngine.h"
+#include "font/Default5x7.h"
 
-DrawEngine::DrawEngine(LEDMatrixWrapper *matrix, RumpshiftLogger *logger)
+DrawEngine::DrawEngine(LEDMatrix *matrix, RumpshiftLogger *logger)
     : _matrix(matrix), _logger(logger) {}
 
 void DrawEngine::begin()
 {
+    _back.clear();
+    _front.clear();
+    _dirty = false;
+
     if (_matrix)
     {
         _matrix->begin();
@@ -14,41 +19,108 @@ void DrawEngine::begin()
     }
 }
 
+void DrawEngine::clear()
+{
+    _back.clear();
+    _dirty = true;
+}
+
+void DrawEngine::setPixel(int row, int col, bool on)
+{
+    if (row < 0 || row >= PackedFrame::ROWS || col < 0 || col >= PackedFrame::COLUMNS)
+        return;
+    _back.set(row, col, on);
+    _dirty = true;
+}
+
+void DrawEngine::drawColumn(int col, uint8_t bits)
+{
+    if (col < 0 || col >= PackedFrame::COLUMNS)
+        return;
+    _back.orColumn(col, bits);
+    _dirty = true;
+}
+
+void DrawEngine::drawFrame(const PackedFrame &frame)
+{
+    _back = frame;
+    _dirty = true;
+}
+
 void DrawEngine::drawText(const char *text, int colOffset)
 {
-    if (!_matrix || !_font)
+    if (!text)
         return;
 
+    const Font *f = font();
     int cursorX = colOffset;
 
-    while (*text)
+    for (; *text && cursorX < PackedFrame::COLUMNS; text++)
     {
+        GlyphMetrics m = _layout.metrics(*text);
         Glyph g;
-        if (_font->getGlyph(*text, g))
+        if (m.width && f->getGlyph(*text, g))
         {
-            _matrix->drawChar(*text, cursorX); // delegate pixel drawing
-            cursorX += g.xAdvance;             // move cursor by glyph width
+            for (int col = 0; col < m.width; col++)
+                drawColumn(cursorX + col + g.xOffset, g.column(m.left + col));
         }
-        text++;
+        cursorX += _layout.advance(text[0], text[1]);
     }
+    _dirty = true;
 
     if (_logger)
         _logger->debug("DrawEngine: text drawn");
 }
 
+bool DrawEngine::present(uint32_t now)
+{
+    if (!_matrix || !_dirty)
+        return false;
+
+    // Too soon: stay dirty and go out on a later call
+    if (_fps && _presented && now - _lastPresent < 1000UL / _fps)
+        return false;
+
+    _dirty = false;
+    if (_back == _front)
+        return false; // redrawn with the same content
+
+    _matrix->renderFrame(_back);
+    _front = _back;
+    _lastPresent = now;
+    _presented++;
+
+    if (_logger)
+        _logger->debug("DrawEngine: frame presented");
+    return true;
+}
+
 void DrawEngine::render()
 {
-    if (_matrix)
-    {
-        _matrix->renderFrame(nullptr); // TODO: fix this, maybe something like _matrix->getFrame() as the param
-        if (_logger)
-            _logger->debug("DrawEngine: frame rendered");
-    }
+    present(millis());
+}
+
+void DrawEngine::setTargetFps(uint8_t fps)
+{
+    _fps = fps;
+    if (_logger)
+        _logger->info(String("DrawEngine: target fps ") + fps);
 }
 
 void DrawEngine::setFont(const Font *font)
 {
     _font = font;
+    _layout.setFont(font);
     if (_logger)
         _logger->info("DrawEngine: font set");
 }
+
+void DrawEngine::setProportional(bool proportional)
+{
+    _layout.setProportional(proportional);
+}
+
+const Font *DrawEngine::font() const
+{
+    return _font ? _font : &Default5x7::shared();
+}
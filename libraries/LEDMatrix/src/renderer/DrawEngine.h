@@ -1,16 +1,36 @@
 #pragma once
 #include <Arduino.h>
 #include "LEDMatrix.h"
-#include "platform/arduino/LEDMatrixWrapper.h"
+#include "PackedFrame.h"
 #include "RumpshiftLogger.h"
 #include "font/Font.h"
+#include "TextLayout.h"
+
+#ifndef DRAW_ENGINE_DEFAULT_FPS
+#define DRAW_ENGINE_DEFAULT_FPS 30 ///< Most frames present() sends per second (0 = no limit)
+#endif
 
 /**
- * @brief Base class for rendering text and shapes onto an LEDMatrix.
+ * @brief Double-buffered renderer for text and pixels on an LEDMatrix.
+ *
+ * Drawing calls only touch the back buffer. present() compares it with
+ * the front buffer (the frame the display is showing) and pushes it to
+ * the hardware only if something changed, at most once per frame
+ * interval. Static content costs no bus traffic, and any number of
+ * drawing calls between two presents go out as one frame.
+ *
+ * Example usage:
+ * @code
+ * DrawEngine engine(&display);
+ * engine.begin();
  *
- * DrawEngine handles higher-level concepts such as text rendering,
- * while delegating pixel-level drawing to the platform-specific
- * LEDMatrix implementation.
+ * void loop()
+ * {
+ *     engine.clear();
+ *     engine.drawText(clockText);
+ *     engine.present(millis()); // no-op unless the text changed
+ * }
+ * @endcode
  */
 class DrawEngine
 {
@@ -20,35 +40,98 @@ public:
      * @param matrix Pointer to an LEDMatrix implementation
      * @param logger Optional pointer to RumpshiftLogger
      */
-    DrawEngine(LEDMatrixWrapper *matrix, RumpshiftLogger *logger = nullptr);
+    DrawEngine(LEDMatrix *matrix, RumpshiftLogger *logger = nullptr);
 
     virtual ~DrawEngine() = default;
 
     /**
-     * @brief Initialize hardware and clear display
+     * @brief Initialize hardware and clear display and both buffers
      */
     virtual void begin();
 
     /**
-     * @brief Draw a string using the active font
+     * @brief Clear the back buffer
+     */
+    void clear();
+
+    /**
+     * @brief Set or clear one pixel in the back buffer (off-screen is ignored)
+     */
+    void setPixel(int row, int col, bool on = true);
+
+    /**
+     * @brief OR a column (bit r = row r) into the back buffer
+     */
+    void drawColumn(int col, uint8_t bits);
+
+    /**
+     * @brief Replace the back buffer with a whole frame
+     */
+    void drawFrame(const PackedFrame &frame);
+
+    /**
+     * @brief Draw a string using the active font and layout
      * @param text      C-string to draw
-     * @param colOffset Starting column position
+     * @param colOffset Starting column position (may be negative)
      */
     virtual void drawText(const char *text, int colOffset = 0);
 
     /**
-     * @brief Render the current framebuffer to hardware
+     * @brief Push the back buffer to hardware if it changed and the frame interval has passed
+     * @param now Current time in ms (millis())
+     * @return true if a frame was sent
+     */
+    bool present(uint32_t now);
+
+    /**
+     * @brief present(millis())
      */
     virtual void render();
 
+    /**
+     * @brief Most frames per second present() sends; 0 = no limit
+     */
+    void setTargetFps(uint8_t fps);
+    uint8_t targetFps() const { return _fps; }
+
+    /**
+     * @brief true if the back buffer may differ from what the display shows
+     */
+    bool isDirty() const { return _dirty; }
+
+    const PackedFrame &backBuffer() const { return _back; }   ///< Frame being drawn
+    const PackedFrame &frontBuffer() const { return _front; } ///< Frame on the display
+    uint32_t framesPresented() const { return _presented; }   ///< Frames sent to hardware
+
     /**
      * @brief Assign a font for text rendering
-     * @param font Pointer to a font implementation
+     * @param font Pointer to a font implementation (nullptr = Default5x7)
      */
     void setFont(const Font *font);
 
+    /**
+     * @brief Monospaced (default) or proportional text; see TextLayout
+     */
+    void setProportional(bool proportional);
+
+    /**
+     * @brief Text layout drawText() uses, e.g. to measure text before drawing it
+     */
+    const TextLayout &layout() const { return _layout; }
+
 protected:
-    LEDMatrixWrapper *_matrix = nullptr;       ///< Hardware interface
+    LEDMatrix *_matrix = nullptr;       ///< Hardware interface
     const Font *_font = nullptr;        ///< Active font
     RumpshiftLogger *_logger = nullptr; ///< Optional logger
+
+    const Font *font() const; ///< Active font, or Default5x7
+
+private:
+    PackedFrame _back;            ///< Drawing target
+    PackedFrame _front;           ///< Last frame sent to hardware
+    TextLayout _layout;           ///< Glyph metrics for drawText()
+    bool _dirty = false;          ///< Back buffer written since the last present
+    uint8_t _fps = DRAW_ENGINE_DEFAULT_FPS;
+    uint32_t _lastPresent = 0;    ///< The first present is never rate limited
+    uint32_t _presented = 0;
 };
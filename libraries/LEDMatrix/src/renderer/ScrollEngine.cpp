@@ -0,0 +1,129 @@
+#include "ScrollEngine.h"
+
+ScrollEngine::ScrollEngine(LEDMatrix *matrix, RumpshiftLogger *logger)
+    : _matrix(matrix), _logger(logger)
+{
+}
+
+void ScrollEngine::start(const String &text)
+{
+    _stream.setText(text);
+    _loopsDone = 0;
+    _trailing = 0;
+    _frame.clear();
+
+    if (!_matrix || text.length() == 0 || _loopCount == 0)
+    {
+        _state = DONE;
+        if (_logger)
+            _logger->warn("ScrollEngine: nothing to scroll");
+        return;
+    }
+
+    _state = WAITING;
+    if (_logger)
+        _logger->info("ScrollEngine: scrolling \"" + text + "\"");
+}
+
+/**
+ * @brief Swap the text under the cursor; the frame is left alone
+ */
+void ScrollEngine::setText(const String &text)
+{
+    if (_state == DONE || _state == WAITING || text.length() == 0)
+    {
+        start(text);
+        return;
+    }
+
+    _stream.setText(text);
+    _loopsDone = 0;
+    _trailing = 0;
+    // Separate the new text from whatever is still on screen
+    if (_state == SCROLLING)
+        _stream.insertGap(SCROLL_ENGINE_SPACE_WIDTH);
+
+    if (_logger)
+        _logger->info("ScrollEngine: text replaced with \"" + text + "\"");
+}
+
+bool ScrollEngine::update(uint32_t now)
+{
+    switch (_state)
+    {
+    case DONE:
+        return false;
+
+    case WAITING:
+        // First tick: show the blank frame and start the clock
+        _lastStep = now;
+        _state = SCROLLING;
+        _matrix->renderFrame(_frame);
+        return true;
+
+    case PAUSED:
+        if (now - _lastStep < _stopMs)
+            return false;
+        _lastStep += _stopMs;
+        _state = SCROLLING;
+        break;
+
+    case SCROLLING:
+        break;
+    }
+
+    uint32_t steps = (now - _lastStep) / _speed;
+    if (steps == 0)
+        return false;
+
+    // After a long stall, jump ahead rather than replaying every column
+    if (steps > SCROLL_ENGINE_MAX_CATCH_UP)
+    {
+        _lastStep += (steps - SCROLL_ENGINE_MAX_CATCH_UP) * _speed;
+        steps = SCROLL_ENGINE_MAX_CATCH_UP;
+    }
+
+    while (steps--)
+    {
+        _lastStep += _speed;
+        if (!step())
+            break;
+    }
+
+    // However many columns moved, the hardware gets one frame
+    _matrix->renderFrame(_frame);
+    return true;
+}
+
+/**
+ * @brief Shift in one column; false when that ended a loop
+ */
+bool ScrollEngine::step()
+{
+    uint8_t bits;
+    if (_stream.next(bits))
+    {
+        _frame.shiftLeft(bits);
+        return true;
+    }
+
+    // Text is all in; scroll it off the display
+    _frame.shiftLeft(0);
+    if (++_trailing < PackedFrame::COLUMNS)
+        return true;
+
+    _loopsDone++;
+    _trailing = 0;
+    _stream.rewind();
+    if (_loopCount >= 0 && _loopsDone >= _loopCount)
+    {
+        _state = DONE;
+        if (_logger)
+            _logger->debug("ScrollEngine: done");
+    }
+    else if (_stopMs > 0)
+    {
+        _state = PAUSED;
+    }
+    return false;
+}
@@ -0,0 +1,136 @@
+#pragma once
+#include <Arduino.h>
+#include "LEDMatrix.h"
+#include "PackedFrame.h"
+#include "RumpshiftLogger.h"
+#include "font/Font.h"
+#include "TextColumnStream.h"
+
+#ifndef SCROLL_ENGINE_SPACE_WIDTH
+#define SCROLL_ENGINE_SPACE_WIDTH TEXT_COLUMN_SPACE_WIDTH ///< Blank columns between swapped texts
+#endif
+
+#ifndef SCROLL_ENGINE_MAX_CATCH_UP
+#define SCROLL_ENGINE_MAX_CATCH_UP 12 ///< Most columns advanced by one late update(); older time is dropped
+#endif
+
+/**
+ * @brief Tick-driven text scroller for any LEDMatrix.
+ *
+ * Nothing blocks: start() sets up a message, and update(now) is called
+ * from loop() with millis(). Each call advances as many columns as the
+ * elapsed time allows (one per speed ms), pushes the frame once if it
+ * moved, and returns straight away, so networking and other work run
+ * between calls.
+ *
+ * Text enters from the right edge and scrolls fully out before the next
+ * loop starts. Columns come from a TextColumnStream as they are needed,
+ * so the message length does not affect memory.
+ *
+ * Example usage:
+ * @code
+ * ScrollEngine scroller(&display);
+ * scroller.setSpeed(80);
+ * scroller.setLoopCount(-1);
+ * scroller.start("HELLO");
+ *
+ * void loop()
+ * {
+ *     scroller.update(millis());
+ *     // ... other work ...
+ * }
+ * @endcode
+ */
+class ScrollEngine
+{
+public:
+    /**
+     * @param matrix Display to render on
+     * @param logger Optional logger
+     */
+    ScrollEngine(LEDMatrix *matrix, RumpshiftLogger *logger = nullptr);
+
+    /**
+     * @brief Start scrolling text from a blank display.
+     */
+    void start(const String &text);
+
+    /**
+     * @brief Replace the text without restarting the display.
+     *
+     * Whatever is on screen keeps scrolling; the new text follows it in
+     * after a space, and the loop count starts over. Starts normally if
+     * nothing is scrolling.
+     */
+    void setText(const String &text);
+
+    /**
+     * @brief Advance by the time elapsed since the last step.
+     *
+     * @param now Current time in ms (millis())
+     * @return true if a new frame was pushed
+     */
+    bool update(uint32_t now);
+
+    /**
+     * @brief true once the loop count has been reached (or before start()).
+     */
+    bool isDone() const { return _state == DONE; }
+
+    /**
+     * @brief Stop scrolling; the display keeps its last frame.
+     */
+    void stop() { _state = DONE; }
+
+    void setSpeed(uint32_t msPerColumn) { _speed = msPerColumn ? msPerColumn : 1; }
+    void setStopTime(uint32_t ms) { _stopMs = ms; }
+    void setLoopCount(int count) { _loopCount = count; }
+    void setFont(const Font *font) { _stream.setFont(font); }
+    void setProportional(bool proportional) { _stream.setProportional(proportional); }
+
+    uint32_t speed() const { return _speed; }
+    uint32_t stopTime() const { return _stopMs; }
+    int loopCount() const { return _loopCount; }
+    int loopsDone() const { return _loopsDone; }
+    const String &text() const { return _stream.text(); }
+    const TextLayout &layout() const { return _stream.layout(); }
+
+    /**
+     * @brief Column steps in one loop: the text scrolling in, then out.
+     *
+     * Measured from cached glyph metrics; nothing is rendered.
+     */
+    uint32_t scrollLength() const { return _stream.layout().measure(_stream.text()) + PackedFrame::COLUMNS; }
+
+    /**
+     * @brief ms one loop takes at the current speed, including the stop time.
+     */
+    uint32_t loopDuration() const { return scrollLength() * _speed + _stopMs; }
+    const PackedFrame &frame() const { return _frame; }
+
+private:
+    enum State
+    {
+        DONE,
+        WAITING,   ///< Started; the first update() sets the clock
+        SCROLLING,
+        PAUSED     ///< Between loops, for the stop time
+    };
+
+    LEDMatrix *_matrix = nullptr;
+    RumpshiftLogger *_logger = nullptr;
+    TextColumnStream _stream;
+    PackedFrame _frame;
+
+    uint32_t _speed = 200;
+    uint32_t _stopMs = 0;
+    int _loopCount = -1; ///< -1 = infinite
+    int _loopsDone = 0;
+
+    State _state = DONE;
+    uint32_t _lastStep = 0;
+
+    uint8_t _trailing = 0; ///< Blank columns shifted in after the text
+
+    bool step();
+};
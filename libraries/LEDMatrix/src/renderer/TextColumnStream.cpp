@@ -0,0 +1,87 @@
+#include "TextColumnStream.h"
+
+TextColumnStream::TextColumnStream(const Font *font)
+    : _layout(font)
+{
+}
+
+void TextColumnStream::setFont(const Font *font)
+{
+    _layout.setFont(font);
+    _glyphLoaded = false;
+}
+
+void TextColumnStream::setProportional(bool proportional)
+{
+    _layout.setProportional(proportional);
+    _glyphLoaded = false;
+}
+
+void TextColumnStream::setText(const String &text)
+{
+    _text = text;
+    rewind();
+}
+
+void TextColumnStream::rewind()
+{
+    _charIndex = 0;
+    _glyphCol = 0;
+    _glyphLoaded = false;
+    _gap = 0;
+}
+
+bool TextColumnStream::next(uint8_t &bits)
+{
+    if (_gap)
+    {
+        _gap--;
+        bits = 0;
+        return true;
+    }
+
+    while (_charIndex < _text.length())
+    {
+        if (!_glyphLoaded)
+            loadGlyph();
+
+        if (_glyphCol < _advance)
+        {
+            bits = _glyphCol < _metrics.width ? _glyph.column(_metrics.left + _glyphCol) : 0;
+            _glyphCol++;
+            return true;
+        }
+
+        _charIndex++;
+        _glyphCol = 0;
+        _glyphLoaded = false;
+    }
+    return false;
+}
+
+void TextColumnStream::loadGlyph()
+{
+    char c = _text[_charIndex];
+    _metrics = _layout.metrics(c);
+    _advance = _layout.advance(c, _charIndex + 1 < _text.length() ? _text[_charIndex + 1] : '\0');
+
+    // Blank and missing glyphs go by as a gap without reading the font
+    if (_metrics.width && !font()->getGlyph(c, _glyph))
+        _metrics.width = 0;
+
+    // A decoded glyph lives in a buffer the font reuses on the next
+    // getGlyph(), from this stream or anything else sharing the font
+    if (_metrics.width && _glyph.ram)
+    {
+        if (_glyph.width > FONT_TABLE_MAX_GLYPH_WIDTH)
+        {
+            _metrics.width = 0;
+        }
+        else
+        {
+            memcpy(_columns, _glyph.bitmap, _glyph.width);
+            _glyph.bitmap = _columns;
+        }
+    }
+    _glyphLoaded = true;
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <Arduino.h>
+#include "font/Font.h"
+#include "TextLayout.h"
+
+/**
+ * @brief Produces the columns of a string one at a time, straight from the font.
+ *
+ * The stream keeps only a cursor (character, column within its glyph and
+ * that glyph's metrics), so nothing is pre-rendered and the message can be
+ * any length. Each column is a uint8_t with bit r for row r, ready for
+ * PackedFrame::shiftLeft().
+ *
+ * Characters are placed by a TextLayout: each takes its advance in
+ * columns (the glyph's columns, then blank spacing adjusted by kerning),
+ * so the stream emits exactly layout().measure(text) columns. Uses
+ * Default5x7 when no font is set.
+ *
+ * Example usage:
+ * @code
+ * TextColumnStream stream;
+ * stream.setText(status);
+ * uint8_t bits;
+ * while (stream.next(bits))
+ *     frame.shiftLeft(bits);
+ * @endcode
+ */
+class TextColumnStream
+{
+public:
+    explicit TextColumnStream(const Font *font = nullptr);
+
+    void setFont(const Font *font);
+
+    /**
+     * @brief Replace the text and rewind to its first column.
+     */
+    void setText(const String &text);
+
+    /**
+     * @brief Go back to the first column of the text.
+     */
+    void rewind();
+
+    /**
+     * @brief Emit this many blank columns before the next text column.
+     */
+    void insertGap(uint8_t columns) { _gap = columns; }
+
+    /**
+     * @brief Next column of the text.
+     *
+     * @param bits Column bits (bit r = row r)
+     * @return false once the text is exhausted
+     */
+    bool next(uint8_t &bits);
+
+    /**
+     * @brief Monospaced (default) or proportional layout; see TextLayout.
+     */
+    void setProportional(bool proportional);
+
+    const String &text() const { return _text; }
+    const Font *font() const { return _layout.font(); }
+    const TextLayout &layout() const { return _layout; }
+
+private:
+    TextLayout _layout;
+    String _text;
+    size_t _charIndex = 0;
+    uint8_t _glyphCol = 0;
+    bool _glyphLoaded = false;
+    Glyph _glyph;
+    GlyphMetrics _metrics;
+    uint8_t _advance = 0; ///< Columns for the current character, kerning included
+    uint8_t _gap = 0;
+    uint8_t _columns[FONT_TABLE_MAX_GLYPH_WIDTH]; ///< Copy of a glyph decoded into the font's buffer
+
+    void loadGlyph();
+};
@@ -0,0 +1,92 @@
+#include "TextLayout.h"
+#include "font/Default5x7.h"
+
+TextLayout::TextLayout(const Font *font)
+    : _font(font)
+{
+}
+
+void TextLayout::setFont(const Font *font)
+{
+    _font = font;
+}
+
+void TextLayout::setProportional(bool proportional)
+{
+    _proportional = proportional;
+}
+
+const Font *TextLayout::font() const
+{
+    return _font ? _font : &Default5x7::shared();
+}
+
+GlyphMetrics TextLayout::metrics(char c) const
+{
+    uint8_t code = (uint8_t)c;
+    if (code < (uint8_t)TEXT_LAYOUT_CACHE_FIRST || code > (uint8_t)TEXT_LAYOUT_CACHE_LAST)
+        return compute(c);
+
+    GlyphMetricsCache *cache = font()->metricsCache(_proportional);
+    if (!cache)
+        return compute(c);
+
+    uint8_t i = code - (uint8_t)TEXT_LAYOUT_CACHE_FIRST;
+    if (!(cache->filled[i >> 3] & (1 << (i & 7))))
+    {
+        cache->entries[i] = compute(c);
+        cache->filled[i >> 3] |= 1 << (i & 7);
+    }
+    return cache->entries[i];
+}
+
+uint8_t TextLayout::advance(char c, char next) const
+{
+    GlyphMetrics m = metrics(c);
+    if (!next)
+        return m.advance;
+
+    int columns = m.advance + font()->kerning(c, next);
+    return columns > m.width ? columns : m.width;
+}
+
+uint32_t TextLayout::measure(const char *text) const
+{
+    if (!text)
+        return 0;
+
+    uint32_t columns = 0;
+    for (; *text; text++)
+        columns += advance(text[0], text[1]);
+    return columns;
+}
+
+/**
+ * @brief Read the glyph and work out its metrics (the uncached path)
+ */
+GlyphMetrics TextLayout::compute(char c) const
+{
+    Glyph glyph;
+    if (!font()->getGlyph(c, glyph) || !glyph.bitmap)
+        return {0, 0, TEXT_COLUMN_SPACE_WIDTH}; // missing glyphs go by as a gap
+
+    uint8_t advance = glyph.xAdvance > (int8_t)glyph.width ? glyph.xAdvance : glyph.width;
+    GlyphMetrics m = {0, glyph.width, advance};
+    if (!_proportional)
+        return m;
+
+    uint8_t first = 0;
+    while (first < glyph.width && !glyph.column(first))
+        first++;
+    if (first == glyph.width)
+        return m; // blank glyph: keep its width
+
+    uint8_t last = glyph.width - 1;
+    while (!glyph.column(last))
+        last--;
+
+    m.left = first;
+    m.width = last - first + 1;
+    m.advance = m.width + (advance - glyph.width);
+    return m;
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <Arduino.h>
+#include "font/Font.h"
+
+#ifndef TEXT_COLUMN_SPACE_WIDTH
+#define TEXT_COLUMN_SPACE_WIDTH 3 ///< Blank columns for a space or a character the font lacks
+#endif
+
+/**
+ * @brief Column layout of text in a font: metrics, kerning and measuring.
+ *
+ * The width of each character is worked out once, from the font's glyph,
+ * and cached (TEXT_LAYOUT_CACHE_FIRST..TEXT_LAYOUT_CACHE_LAST, 3 bytes
+ * each), so measuring a string is a table walk and TextColumnStream and
+ * DrawEngine place every character the same way. The cache belongs to the
+ * font (Font::metricsCache()), one per layout mode, so every layout on a
+ * font shares it and a layout itself holds only a few bytes.
+ *
+ * In proportional mode the blank columns on either side of each glyph are
+ * dropped, so a monospaced font such as Default5x7 sets '1' or 'i' in
+ * fewer columns than 'W'. Blank glyphs (space) keep their full width.
+ *
+ * Kerning from the font adjusts the spacing after a character. Glyphs may
+ * end up touching but never overlap, which keeps the layout streamable
+ * one column at a time.
+ *
+ * Example usage:
+ * @code
+ * TextLayout layout;
+ * layout.setProportional(true);
+ * uint32_t columns = layout.measure("12:45");
+ * @endcode
+ */
+class TextLayout
+{
+public:
+    explicit TextLayout(const Font *font = nullptr);
+
+    /**
+     * @brief Use font (nullptr = Default5x7).
+     */
+    void setFont(const Font *font);
+
+    /**
+     * @brief Trim blank glyph columns.
+     */
+    void setProportional(bool proportional);
+
+    bool proportional() const { return _proportional; }
+    const Font *font() const;
+
+    /**
+     * @brief Metrics of c, from the cache when c is in its range.
+     */
+    GlyphMetrics metrics(char c) const;
+
+    /**
+     * @brief Columns from the start of c to the start of next ('\0' = none).
+     */
+    uint8_t advance(char c, char next) const;
+
+    /**
+     * @brief Columns the text takes, as TextColumnStream emits it.
+     *
+     * Includes the spacing after the last character.
+     */
+    uint32_t measure(const char *text) const;
+    uint32_t measure(const String &text) const { return measure(text.c_str()); }
+
+private:
+    const Font *_font = nullptr;
+    bool _proportional = false;
+
+    GlyphMetrics compute(char c) const;
+};
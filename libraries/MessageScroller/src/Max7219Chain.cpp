@@ -0,0 +1,144 @@
+#include "Max7219Chain.h"
+
+// MAX7219 registers
+static const uint8_t REG_DIGIT0 = 0x01; // rows 0-7 are registers 1-8
+static const uint8_t REG_DECODE_MODE = 0x09;
+static const uint8_t REG_INTENSITY = 0x0A;
+static const uint8_t REG_SCAN_LIMIT = 0x0B;
+static const uint8_t REG_SHUTDOWN = 0x0C;
+static const uint8_t REG_DISPLAY_TEST = 0x0F;
+
+Max7219Chain::Max7219Chain(uint8_t dataPin, uint8_t clkPin, uint8_t csPin, uint8_t numDevices)
+    : _dataPin(dataPin), _clkPin(clkPin), _csPin(csPin),
+      _numDevices(numDevices < 1 ? 1 : (numDevices > MAX7219_MAX_DEVICES ? MAX7219_MAX_DEVICES : numDevices))
+{
+    memset(_rows, 0, sizeof(_rows));
+    memset(_sent, 0, sizeof(_sent));
+}
+
+void Max7219Chain::begin(uint8_t intensity)
+{
+    pinMode(_dataPin, OUTPUT);
+    pinMode(_clkPin, OUTPUT);
+    pinMode(_csPin, OUTPUT);
+    digitalWrite(_csPin, HIGH);
+
+    sendAll(REG_DISPLAY_TEST, 0);
+    sendAll(REG_SCAN_LIMIT, 7); // all eight rows
+    sendAll(REG_DECODE_MODE, 0); // raw segments, no BCD
+    setIntensity(intensity);
+    shutdown(false);
+
+    _transfers = 0;
+    clear();
+    invalidate();
+    flush();
+}
+
+void Max7219Chain::setIntensity(uint8_t level)
+{
+    sendAll(REG_INTENSITY, level > 15 ? 15 : level);
+}
+
+void Max7219Chain::shutdown(bool off)
+{
+    sendAll(REG_SHUTDOWN, off ? 0 : 1);
+}
+
+void Max7219Chain::clear()
+{
+    memset(_rows, 0, sizeof(_rows));
+}
+
+void Max7219Chain::setPixel(int row, int col, bool on)
+{
+    if (row < 0 || row >= 8 || col < 0 || col >= width())
+        return;
+    uint8_t mask = 0x80 >> (col & 7);
+    if (on)
+        _rows[row][col >> 3] |= mask;
+    else
+        _rows[row][col >> 3] &= ~mask;
+}
+
+void Max7219Chain::setColumn(int col, uint8_t bits)
+{
+    if (col < 0 || col >= width())
+        return;
+    for (uint8_t r = 0; r < 8; r++)
+        setPixel(r, col, bits & (1 << r));
+}
+
+uint8_t Max7219Chain::column(int col) const
+{
+    if (col < 0 || col >= width())
+        return 0;
+    uint8_t mask = 0x80 >> (col & 7);
+    uint8_t bits = 0;
+    for (uint8_t r = 0; r < 8; r++)
+        if (_rows[r][col >> 3] & mask)
+            bits |= 1 << r;
+    return bits;
+}
+
+void Max7219Chain::scrollLeft(uint8_t incoming)
+{
+    // Each row is one bit string across the chain; carry the top bit of
+    // the device to the right into the bottom of this one
+    for (uint8_t r = 0; r < 8; r++)
+    {
+        uint8_t *row = _rows[r];
+        for (uint8_t d = 0; d + 1 < _numDevices; d++)
+            row[d] = (row[d] << 1) | (row[d + 1] >> 7);
+        row[_numDevices - 1] = (row[_numDevices - 1] << 1) | ((incoming >> r) & 1);
+    }
+}
+
+uint8_t Max7219Chain::flush()
+{
+    uint8_t sent = 0;
+    for (uint8_t r = 0; r < 8; r++)
+    {
+        if (!(_stale & (1 << r)) && memcmp(_rows[r], _sent[r], _numDevices) == 0)
+            continue;
+        sendRow(r);
+        memcpy(_sent[r], _rows[r], _numDevices);
+        sent++;
+    }
+    _stale = 0;
+    return sent;
+}
+
+void Max7219Chain::invalidate()
+{
+    _stale = 0xFF;
+}
+
+void Max7219Chain::sendRow(uint8_t row)
+{
+    // The first word shifted in ends up in the device farthest from the board
+    digitalWrite(_csPin, LOW);
+    for (int d = _numDevices - 1; d >= 0; d--)
+    {
+        shiftByte(REG_DIGIT0 + row);
+        shiftByte(_rows[row][d]);
+    }
+    digitalWrite(_csPin, HIGH);
+    _transfers++;
+}
+
+void Max7219Chain::sendAll(uint8_t reg, uint8_t value)
+{
+    digitalWrite(_csPin, LOW);
+    for (uint8_t d = 0; d < _numDevices; d++)
+    {
+        shiftByte(reg);
+        shiftByte(value);
+    }
+    digitalWrite(_csPin, HIGH);
+}
+
+void Max7219Chain::shiftByte(uint8_t value)
+{
+    shiftOut(_dataPin, _clkPin, MSBFIRST, value);
+}
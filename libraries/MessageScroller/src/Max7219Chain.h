@@ -0,0 +1,82 @@
+#ifndef MAX7219_CHAIN_H
+#define MAX7219_CHAIN_H
+
+#include <Arduino.h>
+
+#ifndef MAX7219_MAX_DEVICES
+#define MAX7219_MAX_DEVICES 8 ///< Longest chain the framebuffer is sized for
+#endif
+
+/**
+ * @brief Framebuffer spanning a daisy chain of MAX7219 8x8 modules.
+ *
+ * Drawing only changes the buffer; flush() sends the rows that differ
+ * from what the chips hold. Each row goes out as one chain-wide shift
+ * (row data for every device behind a single chip-select pulse), so a
+ * full frame is at most 8 transfers however many modules are chained,
+ * and an unchanged frame costs none.
+ *
+ * Columns run left to right across the chain: device 0 (the one wired
+ * to the board) shows columns 0-7, device 1 columns 8-15, and so on.
+ * Column data is bit r = row r (LSB = top), the same as the LEDMatrix
+ * fonts.
+ */
+class Max7219Chain
+{
+public:
+    Max7219Chain(uint8_t dataPin, uint8_t clkPin, uint8_t csPin, uint8_t numDevices = 1);
+
+    /**
+     * @brief Set up the pins and chips and blank the display.
+     */
+    void begin(uint8_t intensity = 8);
+
+    void setIntensity(uint8_t level); ///< 0-15, all devices
+    void shutdown(bool off);          ///< Power-save every device
+
+    uint8_t numDevices() const { return _numDevices; }
+    uint16_t width() const { return _numDevices * 8; } ///< Columns across the chain
+
+    // --- Framebuffer ---
+
+    void clear();
+    void setPixel(int row, int col, bool on = true);
+    void setColumn(int col, uint8_t bits); ///< Off-chain columns are ignored
+    uint8_t column(int col) const;
+
+    /**
+     * @brief Shift everything one column left; incoming fills the rightmost column.
+     */
+    void scrollLeft(uint8_t incoming);
+
+    /**
+     * @brief Send the rows that changed since the last flush.
+     * @return Number of chain transfers (0-8)
+     */
+    uint8_t flush();
+
+    /**
+     * @brief Resend every row on the next flush() (e.g. after a glitch).
+     */
+    void invalidate();
+
+    uint32_t transfers() const { return _transfers; } ///< Chain transfers since begin()
+
+private:
+    uint8_t _dataPin;
+    uint8_t _clkPin;
+    uint8_t _csPin;
+    uint8_t _numDevices;
+
+    // Row registers per device: bit 7 = leftmost column of that device
+    uint8_t _rows[8][MAX7219_MAX_DEVICES];
+    uint8_t _sent[8][MAX7219_MAX_DEVICES];
+    uint8_t _stale = 0xFF; ///< Bit r set = row r must be sent
+    uint32_t _transfers = 0;
+
+    void sendRow(uint8_t row);
+    void sendAll(uint8_t reg, uint8_t value); ///< Same register write to every device
+    void shiftByte(uint8_t value);
+};
+
+#endif
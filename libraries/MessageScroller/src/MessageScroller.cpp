@@ -1,53 +1,41 @@
 #include "MessageScroller.h"
-#include "font.h" // font data stored as bitmaps
+#include "renderer/TextColumnStream.h" // shared font columns from the LEDMatrix library
 
 MessageScroller::MessageScroller(uint8_t dataPin, uint8_t clkPin, uint8_t csPin, uint8_t numDevices)
-    : numDevices(numDevices)
+    : chain(dataPin, clkPin, csPin, numDevices)
 {
-    lc = new LedControl(dataPin, clkPin, csPin, numDevices);
 }
 
 void MessageScroller::begin()
 {
-    for (uint8_t i = 0; i < numDevices; i++)
-    {
-        lc->shutdown(i, false);
-        lc->setIntensity(i, 8);
-        lc->clearDisplay(i);
-    }
+    chain.begin(8);
 }
 
 void MessageScroller::clearDisplay()
 {
-    for (uint8_t i = 0; i < numDevices; i++)
-    {
-        lc->clearDisplay(i);
-    }
+    chain.clear();
+    chain.flush();
 }
 
 void MessageScroller::scrollMessage(const String &msg, int delayMs)
 {
-    for (int offset = 0; offset < msg.length() * 8; offset++)
+    clearDisplay();
+
+    TextColumnStream stream;
+    stream.setText(msg);
+
+    // Text in from the right, then blank columns until it has left the chain
+    uint8_t bits;
+    uint16_t trailing = 0;
+    while (trailing < chain.width())
     {
-        clearDisplay();
-        for (int col = 0; col < 8; col++)
+        if (!stream.next(bits))
         {
-            int charIndex = (offset + col) / 8;
-            int colOffset = (offset + col) % 8;
-            if (charIndex < msg.length())
-            {
-                char c = msg.charAt(charIndex);
-                byte columnData = getCharBitmap(c, colOffset);
-                lc->setColumn(0, 7 - col, columnData); // reverse column order for scrolling
-            }
+            bits = 0;
+            trailing++;
         }
+        chain.scrollLeft(bits);
+        chain.flush();
         delay(delayMs);
     }
 }
-
-byte MessageScroller::getCharBitmap(char c, int col)
-{
-    if (c < 32 || c > 127)
-        return 0; // unsupported char
-    return font[c - 32][col];
-}
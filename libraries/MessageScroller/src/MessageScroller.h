@@ -2,8 +2,15 @@
 #define MESSAGE_SCROLLER_H
 
 #include <Arduino.h>
-#include <LedControl.h>
+#include "Max7219Chain.h"
 
+/**
+ * @brief Scrolls text across a chain of MAX7219 8x8 modules.
+ *
+ * The message enters from the right edge of the whole chain and scrolls
+ * out on the left. Each step shifts the chain framebuffer one column and
+ * flushes only the rows that changed.
+ */
 class MessageScroller
 {
 public:
@@ -11,12 +18,11 @@ public:
     void begin();
     void scrollMessage(const String &msg, int delayMs = 100);
 
+    Max7219Chain &display() { return chain; } ///< Direct access to the chain framebuffer
+
 private:
-    LedControl *lc;
-    uint8_t numDevices;
+    Max7219Chain chain;
     void clearDisplay();
-    void displayChar(char c, int offset);
-    byte getCharBitmap(char c, int row);
 };
 
 #endif
@@ -1,13 +0,0 @@
-#ifndef FONT_H
-#define FONT_H
-
-// 8-bit wide, 8-pixel high ASCII font (partial, add more as needed)
-const byte font[][8] = {
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // space
-    {0x3E, 0x5B, 0x4F, 0x5B, 0x3E, 0x00, 0x00, 0x00}, // heart ♥ (optional)
-    {0x7C, 0x12, 0x11, 0x12, 0x7C, 0x00, 0x00, 0x00}, // A
-    {0x7F, 0x49, 0x49, 0x49, 0x36, 0x00, 0x00, 0x00}, // B
-                                                      // ... add more characters
-};
-
-#endif
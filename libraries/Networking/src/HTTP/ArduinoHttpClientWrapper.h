@@ -20,6 +20,14 @@ public:
     void sendHeader(const char *name, int value) override { _http.sendHeader(name, value); }
     void beginBody() override { _http.beginBody(); }
     void print(const String &data) override { _http.print(data); }
+    void write(const uint8_t *data, size_t len) override { _http.write(data, len); }
+
+    Print *beginStreamBody(size_t length) override
+    {
+        _http.sendHeader("Content-Length", (int)length);
+        _http.beginBody();
+        return &_http;
+    }
 
     int responseStatusCode() override { return _http.responseStatusCode(); }
     String responseBody() override { return _http.responseBody(); }
@@ -19,9 +19,19 @@ public:
     void sendHeader(const char *, int) override {}
     void beginBody() override {}
     void print(const String &) override {}
+    void write(const uint8_t *, size_t) override {}
+    Print *beginStreamBody(size_t) override { return &_sink; }
 
     int responseStatusCode() override { return 200; }
     String responseBody() override { return "{}"; }
     bool connected() const override { return true; }
+
+private:
+    // Discards streamed bodies
+    class NullPrint : public Print
+    {
+    public:
+        size_t write(uint8_t) override { return 1; }
+    } _sink;
 };
 #endif
@@ -21,6 +21,18 @@ public:
     virtual void beginBody() = 0;
     virtual void print(const String &data) = 0;
 
+    /**
+     * @brief Send a binary body. The buffer must stay valid until endRequest().
+     */
+    virtual void write(const uint8_t *data, size_t len) = 0;
+
+    /**
+     * @brief Send the request head now and stream a body of exactly length bytes.
+     * Write the body to the returned Print, then call endRequest().
+     * @return Body sink, or nullptr if the request could not be started.
+     */
+    virtual Print *beginStreamBody(size_t length) = 0;
+
     virtual int responseStatusCode() = 0;
     virtual String responseBody() = 0;
     virtual bool connected() const = 0;
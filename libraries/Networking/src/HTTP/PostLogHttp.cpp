@@ -1,4 +1,7 @@
 #include "PostLogHttp.h"
+#include "StorageRecords.h"
+#include "LzCodec.h"
+#include <memory>
 
 PostLogHttp::PostLogHttp(
     NetworkManager &network,
@@ -21,6 +24,7 @@ void PostLogHttp::begin()
     if (_queueFailedRequests && _storage)
     {
         _storage->begin();
+        _storageEnd = StorageRecords::UNKNOWN_END;
         loadFromStorage();
     }
 }
@@ -37,12 +41,14 @@ void PostLogHttp::log(const String &message)
         if (_logger)
             _logger->warn("[PostLogHttp::log] network unavailable, queuing message");
 
-        _queue.push(message);
+        // Pack only what is kept; the queued record is sent and stored as is
+        String record = _compress ? LzCodec::pack(message) : message;
+        _queue.push(record);
 
         if (_logger)
             _logger->info("[PostLogHttp::log] saving message to storage");
 
-        saveToStorage(message);
+        saveToStorage(record);
     }
     else if (sent && _logger)
     {
@@ -76,7 +82,8 @@ void PostLogHttp::processQueue()
 bool PostLogHttp::sendHttp(const String &message)
 {
     if (_logger)
-        _logger->info("[PostLogHttp::sendHttp] called with message: " + message);
+        _logger->info("[PostLogHttp::sendHttp] called with message: " +
+                      (LzCodec::isPacked(message) ? "<packed " + String(message.length()) + " bytes>" : message));
 
     if (!_httpClient.isConnected())
     {
@@ -88,7 +95,32 @@ bool PostLogHttp::sendHttp(const String &message)
     if (_logger)
         _logger->info("[PostLogHttp::sendHttp] network connected, attempting POST to path: " + _path);
 
-    _httpClient.post(_path, message);
+    if (!LzCodec::isPacked(message))
+    {
+        // Sent straight away: compress for the wire only if asked to
+        if (!_compressOnWire || !postCompressed(message))
+            _httpClient.post(_path, message);
+    }
+    else if (_compressOnWire)
+    {
+        size_t length = LzCodec::packedLength(message);
+        std::unique_ptr<uint8_t[]> body(new uint8_t[length]);
+        LzCodec::packedBytes(message, body.get(), length);
+        _httpClient.post(_path, body.get(), length, "application/json", LzCodec::CONTENT_ENCODING);
+    }
+    else
+    {
+        bool ok = false;
+        String text = LzCodec::unpack(message, &ok);
+        if (!ok)
+        {
+            // Retrying cannot repair it; drop it rather than post nothing
+            if (_logger)
+                _logger->error("[PostLogHttp::sendHttp] packed message is corrupt, dropping it");
+            return true;
+        }
+        _httpClient.post(_path, text);
+    }
     int status = _httpClient.lastStatusCode();
 
     if (_logger)
@@ -97,13 +129,29 @@ bool PostLogHttp::sendHttp(const String &message)
     return (status >= 200 && status < 300);
 }
 
+bool PostLogHttp::postCompressed(const String &message)
+{
+    size_t length = message.length();
+    size_t cap = LzCodec::maxCompressedSize(length);
+    std::unique_ptr<uint8_t[]> body(new uint8_t[cap]);
+    size_t n = LzCodec::compress(reinterpret_cast<const uint8_t *>(message.c_str()), length, body.get(), cap);
+    if (n == 0 || n >= length)
+        return false;
+
+    _httpClient.post(_path, body.get(), n, "application/json", LzCodec::CONTENT_ENCODING);
+    return true;
+}
+
 void PostLogHttp::clearQueue()
 {
     while (!_queue.isEmpty())
         _queue.pop();
 
     if (_storage)
+    {
         _storage->clear();
+        _storageEnd = StorageRecords::UNKNOWN_END;
+    }
 }
 
 void PostLogHttp::saveToStorage(const String &message)
@@ -111,19 +159,13 @@ void PostLogHttp::saveToStorage(const String &message)
     if (!_queueFailedRequests || !_storage)
         return;
 
-    // Load current stored messages
-    String stored = _storage->load();
-
-    if (stored.length() > 0)
-        stored += '\n';
-    stored += message;
-
-    // Trim if storage has a limit
-    constexpr int STORAGE_LIMIT = 512;
-    if (stored.length() > STORAGE_LIMIT - 1)
-        stored = stored.substring(stored.length() - (STORAGE_LIMIT - 1));
-
-    _storage->save(stored);
+    // Append in place; the oldest records are dropped when storage is full
+    if (!StorageRecords::append(*_storage, message, _storageEnd))
+    {
+        if (_logger)
+            _logger->warn("[PostLogHttp] message larger than storage, not saved");
+        return;
+    }
 
     if (_logger)
         _logger->debug("[PostLogHttp] saved message to storage");
@@ -134,26 +176,24 @@ void PostLogHttp::loadFromStorage()
     if (!_queueFailedRequests || !_storage)
         return;
 
-    String stored = _storage->load();
-    if (stored.length() == 0)
-        return;
-
-    int start = 0;
-    int end = stored.indexOf('\n');
-    while (end != -1)
-    {
-        String line = stored.substring(start, end);
-        if (line.length() > 0)
+    // Records are streamed out of storage one at a time
+    size_t corrupt = 0;
+    size_t loaded = StorageRecords::forEach(*_storage, [this, &corrupt](const String &line)
+                                            {
+        bool ok = true;
+        if (LzCodec::isPacked(line))
+            LzCodec::unpack(line, &ok);
+        if (ok)
             _queue.push(line);
-        start = end + 1;
-        end = stored.indexOf('\n', start);
-    }
-
-    String lastLine = stored.substring(start);
-    if (lastLine.length() > 0)
-        _queue.push(lastLine);
+        else
+            corrupt++; });
+    if (corrupt > 0 && _logger)
+        _logger->error("[PostLogHttp] dropped " + String((unsigned long)corrupt) + " corrupt stored messages");
+    if (loaded == 0)
+        return;
 
     _storage->clear();
+    _storageEnd = StorageRecords::UNKNOWN_END;
 
     if (_logger)
         _logger->debug("[PostLogHttp] loaded queued messages from storage");
@@ -163,3 +203,9 @@ void PostLogHttp::setPath(const String &path)
 {
     _path = path;
 }
+
+void PostLogHttp::setCompression(bool enabled, bool onWire)
+{
+    _compress = enabled;
+    _compressOnWire = enabled && onWire;
+}
@@ -6,7 +6,7 @@
 #include "NetworkProtocol.h"  // Base interface for protocols
 #include "RumpusHttpClient.h" // Base HTTP client
 #include "RumpshiftLogger.h"
-#include "Storage.h"
+#include "StorageRecords.h"
 
 constexpr size_t QUEUE_INITIAL_CAPACITY = 128;
 
@@ -73,6 +73,19 @@ public:
      */
     void setPath(const String &path);
 
+    /**
+     * @brief Compress queued messages with LzCodec.
+     *
+     * A message is packed only when it has to be queued, so more of them fit
+     * in RAM and storage; one sent straight away is never packed. With
+     * onWire, messages are POSTed in compressed form with "Content-Encoding:
+     * x-rumpus-lz"; otherwise queued messages are expanded before sending.
+     *
+     * @param enabled Compress messages in the queue and storage.
+     * @param onWire Send the compressed bytes as the request body.
+     */
+    void setCompression(bool enabled, bool onWire = false);
+
     void loadFromStorage();
     void saveToStorage(const String &message);
 
@@ -83,6 +96,9 @@ private:
     RumpusHttpClient _httpClient; ///< Internal HTTP client for sending messages
     bool _queueFailedRequests;    ///< Whether failed messages are queued
     Storage *_storage;
+    bool _compress = false;       ///< Pack queued messages with LzCodec
+    bool _compressOnWire = false; ///< Send packed messages with Content-Encoding
+    size_t _storageEnd = StorageRecords::UNKNOWN_END; ///< End of the stored records, saves a scan per append
 
     /**
      * @brief Attempt to send a single message via HTTP.
@@ -90,6 +106,12 @@ private:
      * @return true if successful, false if network unavailable
      */
     bool sendHttp(const String &message);
+
+    /**
+     * @brief POST an unpacked message LZ-compressed with Content-Encoding.
+     * @return false, without sending, if it does not get smaller.
+     */
+    bool postCompressed(const String &message);
 };
 
 #endif // POST_LOG_HTTP_H
@@ -1,4 +1,7 @@
 #include "PostPrintJobHttp.h"
+#include "StorageRecords.h"
+#include "LzCodec.h"
+#include <memory>
 
 PostPrintJobHttp::PostPrintJobHttp(
     NetworkManager &network,
@@ -21,29 +24,34 @@ void PostPrintJobHttp::begin()
     if (_queueFailedRequests && _storage)
     {
         _storage->begin();
+        _storageEnd = StorageRecords::UNKNOWN_END;
         loadFromStorage();
     }
 }
 
-void PostPrintJobHttp::enqueueJob(const String &job)
+uint32_t PostPrintJobHttp::enqueueJob(const String &job)
 {
     if (_logger)
         _logger->info("[PostPrintJobHttp::enqueueJob] called with job: " + job);
 
-    bool sent = sendHttp(job);
+    uint32_t id = allocateJobId();
+
+    // Keep delivery in ID order: only bypass the queue when it is empty
+    bool sent = (_queue.isEmpty() || !_queueFailedRequests) && sendHttp(makeRecord(id, job));
 
     if (!sent && _queueFailedRequests)
     {
         if (_logger)
             _logger->warn("[PostPrintJobHttp::enqueueJob] network unavailable, queuing job");
 
-        String copy = job;
-        _queue.push(copy);
+        // Pack only what is kept; the queued record is sent and stored as is
+        String record = makeRecord(id, _compress ? LzCodec::pack(job) : job);
+        _queue.push(record);
 
         if (_logger)
             _logger->info("[PostPrintJobHttp::enqueueJob] saving job to storage");
 
-        saveToStorage(copy);
+        saveToStorage(record);
     }
     else if (sent && _logger)
     {
@@ -58,26 +66,35 @@ void PostPrintJobHttp::enqueueJob(const String &job)
 
     if (_logger)
         _logger->info("[PostPrintJobHttp::enqueueJob] enqueueJob() completed");
+
+    return id;
 }
 
 void PostPrintJobHttp::processQueue()
 {
+    // Queued jobs are already in storage; a failed retry leaves them there
     while (!_queue.isEmpty())
     {
-        String job = _queue.peek();
-        if (!sendHttp(job))
-        {
-            saveToStorage(job);
+        String record = _queue.peek();
+        if (!sendHttp(record))
             break;
-        }
         _queue.pop();
     }
+
+    // Everything delivered: drop acknowledged records, keep the ID reservation
+    if (_queue.isEmpty() && _storedJobs > 0)
+        compactStorage();
 }
 
-bool PostPrintJobHttp::sendHttp(const String &job)
+bool PostPrintJobHttp::sendHttp(const String &record)
 {
+    uint32_t id = 0;
+    String job;
+    parseRecord(record, id, job);
+
     if (_logger)
-        _logger->info("[PostPrintJobHttp::sendHttp] called with job: " + job);
+        _logger->info("[PostPrintJobHttp::sendHttp] called with job " + String(id) + ": " +
+                      (LzCodec::isPacked(job) ? "<packed " + String(job.length()) + " bytes>" : job));
 
     if (!_httpClient.isConnected())
     {
@@ -89,13 +106,58 @@ bool PostPrintJobHttp::sendHttp(const String &job)
     if (_logger)
         _logger->info("[PostPrintJobHttp::sendHttp] network connected, attempting POST to path: " + _path);
 
-    _httpClient.post(_path, job);
+    String key = idempotencyKey(id);
+    if (key.length() > 0)
+        _httpClient.addRequestHeader("Idempotency-Key", key);
+    if (!LzCodec::isPacked(job))
+    {
+        // Sent straight away: compress for the wire only if asked to
+        if (!_compressOnWire || !postCompressed(job))
+            _httpClient.post(_path, job);
+    }
+    else if (_compressOnWire)
+    {
+        size_t length = LzCodec::packedLength(job);
+        std::unique_ptr<uint8_t[]> body(new uint8_t[length]);
+        LzCodec::packedBytes(job, body.get(), length);
+        _httpClient.post(_path, body.get(), length, "application/json", LzCodec::CONTENT_ENCODING);
+    }
+    else
+    {
+        bool ok = false;
+        String text = LzCodec::unpack(job, &ok);
+        if (!ok)
+        {
+            // Retrying cannot repair it; drop it rather than post nothing
+            if (_logger)
+                _logger->error("[PostPrintJobHttp::sendHttp] packed job " + String(id) + " is corrupt, dropping it");
+            return true;
+        }
+        _httpClient.post(_path, text);
+    }
     int status = _httpClient.lastStatusCode();
 
     if (_logger)
         _logger->info("[PostPrintJobHttp::sendHttp] HTTP POST completed, status code: " + String(status));
 
-    return (status >= 200 && status < 300);
+    if (status < 200 || status >= 300)
+        return false;
+
+    acknowledge(id);
+    return true;
+}
+
+bool PostPrintJobHttp::postCompressed(const String &job)
+{
+    size_t length = job.length();
+    size_t cap = LzCodec::maxCompressedSize(length);
+    std::unique_ptr<uint8_t[]> body(new uint8_t[cap]);
+    size_t n = LzCodec::compress(reinterpret_cast<const uint8_t *>(job.c_str()), length, body.get(), cap);
+    if (n == 0 || n >= length)
+        return false;
+
+    _httpClient.post(_path, body.get(), n, "application/json", LzCodec::CONTENT_ENCODING);
+    return true;
 }
 
 void PostPrintJobHttp::clearQueue()
@@ -104,7 +166,7 @@ void PostPrintJobHttp::clearQueue()
         _queue.pop();
 
     if (_storage)
-        _storage->clear();
+        compactStorage();
 }
 
 void PostPrintJobHttp::saveToStorage(const String &job)
@@ -112,18 +174,14 @@ void PostPrintJobHttp::saveToStorage(const String &job)
     if (!_queueFailedRequests || !_storage)
         return;
 
-    // Load current data
-    String stored = _storage->load();
-
-    if (stored.length() > 0)
-        stored += '\n';
-    stored += job;
-
-    // Optional trimming if your backend storage has limits
-    if (stored.length() > Storage::MAX_SIZE - 1)
-        stored = stored.substring(stored.length() - (Storage::MAX_SIZE - 1));
-
-    _storage->save(stored);
+    // Append in place; the oldest records are dropped when storage is full
+    if (!StorageRecords::append(*_storage, job, _storageEnd))
+    {
+        if (_logger)
+            _logger->warn("[PostPrintJobHttp] job larger than storage, not saved");
+        return;
+    }
+    _storedJobs++;
 
     if (_logger)
         _logger->debug("[PostPrintJobHttp] saved job to storage");
@@ -134,32 +192,154 @@ void PostPrintJobHttp::loadFromStorage()
     if (!_queueFailedRequests || !_storage)
         return;
 
-    String stored = _storage->load();
-    if (stored.length() == 0)
+    // First pass: recover the ID high-water marks
+    uint32_t acked = 0;
+    uint32_t highest = 0;
+    StorageRecords::forEach(*_storage, [&](const String &record)
+                            {
+        uint32_t id = 0;
+        String job;
+        char tag = parseRecord(record, id, job);
+        if (tag == ACK_TAG && id > acked)
+            acked = id;
+        if (tag != LEGACY_TAG && id > highest)
+            highest = id; });
+
+    _ackedJobId = acked;
+    _nextJobId = highest + 1;
+    _reservedJobId = _nextJobId;
+
+    // Second pass: queue jobs that were never acknowledged, oldest first.
+    // Legacy records written before IDs existed get a fresh ID; the
+    // reservation is persisted by compactStorage() below.
+    size_t corrupt = 0;
+    size_t loaded = StorageRecords::forEach(*_storage, [&](const String &record)
+                                            {
+        uint32_t id = 0;
+        String job;
+        char tag = parseRecord(record, id, job);
+        bool ok = true;
+        if ((tag == LEGACY_TAG || tag == JOB_TAG) && LzCodec::isPacked(job))
+            LzCodec::unpack(job, &ok);
+        if (!ok)
+            corrupt++;
+        else if (tag == LEGACY_TAG)
+            _queue.push(makeRecord(_nextJobId++, job));
+        else if (tag == JOB_TAG && id > _ackedJobId)
+            _queue.push(record); });
+    if (corrupt > 0 && _logger)
+        _logger->error("[PostPrintJobHttp] dropped " + String((unsigned long)corrupt) + " corrupt stored jobs");
+    if (loaded == 0)
         return;
 
-    int start = 0;
-    int end = stored.indexOf('\n');
-    while (end != -1)
+    // Rewrite storage with just the reservation and the pending jobs
+    compactStorage();
+
+    if (_logger)
+        _logger->debug("[PostPrintJobHttp] loaded queued jobs from storage");
+}
+
+void PostPrintJobHttp::setPath(const String &path)
+{
+    _path = path;
+}
+
+void PostPrintJobHttp::setCompression(bool enabled, bool onWire)
+{
+    _compress = enabled;
+    _compressOnWire = enabled && onWire;
+}
+
+void PostPrintJobHttp::setIdempotencyPrefix(const String &prefix)
+{
+    _idempotencyPrefix = prefix;
+}
+
+String PostPrintJobHttp::idempotencyKey(uint32_t id) const
+{
+    // Bare IDs start over after a reboot without storage and repeat
+    // across devices, so they would make the server drop real jobs
+    if (!persistsJobIds() || _idempotencyPrefix.length() == 0)
+        return String();
+    return _idempotencyPrefix + String(id, HEX);
+}
+
+bool PostPrintJobHttp::persistsJobIds() const
+{
+    return _storage && _queueFailedRequests;
+}
+
+uint32_t PostPrintJobHttp::allocateJobId()
+{
+    uint32_t id = _nextJobId++;
+
+    // Persist IDs in blocks so a reboot never hands out a used ID again
+    if (persistsJobIds() && _nextJobId > _reservedJobId)
     {
-        String line = stored.substring(start, end);
-        if (line.length() > 0)
-            _queue.push(line);
-        start = end + 1;
-        end = stored.indexOf('\n', start);
+        _reservedJobId = _nextJobId + JOB_ID_RESERVE_BLOCK;
+        StorageRecords::append(*_storage, String(RESERVE_TAG) + String(_reservedJobId, HEX), _storageEnd);
     }
+    return id;
+}
+
+void PostPrintJobHttp::acknowledge(uint32_t id)
+{
+    if (id > _ackedJobId)
+        _ackedJobId = id;
 
-    String lastLine = stored.substring(start);
-    if (lastLine.length() > 0)
-        _queue.push(lastLine);
+    // Only jobs that reached storage need a durable acknowledgement
+    if (_storage && _storedJobs > 0)
+        StorageRecords::append(*_storage, String(ACK_TAG) + String(id, HEX), _storageEnd);
+}
+
+void PostPrintJobHttp::compactStorage()
+{
+    if (!_storage)
+        return;
 
     _storage->clear();
+    _storageEnd = StorageRecords::UNKNOWN_END;
+    _storedJobs = 0;
+    if (_reservedJobId < _nextJobId)
+        _reservedJobId = _nextJobId + JOB_ID_RESERVE_BLOCK;
+    StorageRecords::append(*_storage, String(RESERVE_TAG) + String(_reservedJobId, HEX), _storageEnd);
+    if (_ackedJobId > 0)
+        StorageRecords::append(*_storage, String(ACK_TAG) + String(_ackedJobId, HEX), _storageEnd);
+
+    // The queue holds exactly the pending jobs, in order
+    int pending = _queue.count();
+    for (int i = 0; i < pending; i++)
+    {
+        String record = _queue.pop();
+        saveToStorage(record);
+        _queue.push(record);
+    }
+}
 
-    if (_logger)
-        _logger->debug("[PostPrintJobHttp] loaded queued jobs from storage");
+String PostPrintJobHttp::makeRecord(uint32_t id, const String &job)
+{
+    return String(JOB_TAG) + String(id, HEX) + ":" + job;
 }
 
-void PostPrintJobHttp::setPath(const String &path)
+char PostPrintJobHttp::parseRecord(const String &record, uint32_t &id, String &job)
 {
-    _path = path;
+    id = 0;
+    job = record;
+    char tag = record.length() > 0 ? record[0] : LEGACY_TAG;
+    if (tag != JOB_TAG && tag != ACK_TAG && tag != RESERVE_TAG)
+        return LEGACY_TAG;
+
+    // "<tag><1-8 hex digits>", then ":<payload>" for a job. Anything else is
+    // legacy text that happens to start with a tag letter ("John's latte").
+    unsigned int end = 1;
+    while (end < record.length() && end <= 8 && isxdigit((unsigned char)record[end]))
+        end++;
+    bool terminated = tag == JOB_TAG ? end < record.length() && record[end] == ':'
+                                     : end == record.length();
+    if (end == 1 || !terminated)
+        return LEGACY_TAG;
+
+    id = strtoul(record.substring(1, end).c_str(), nullptr, 16);
+    job = tag == JOB_TAG ? record.substring(end + 1) : String();
+    return tag;
 }
@@ -6,9 +6,10 @@
 #include "NetworkProtocol.h"  // Base interface for protocols
 #include "RumpusHttpClient.h" // Base HTTP client
 #include "RumpshiftLogger.h"
-#include "Storage.h"
+#include "StorageRecords.h"
 
 constexpr size_t PRINT_QUEUE_INITIAL_CAPACITY = 128;
+constexpr uint32_t JOB_ID_RESERVE_BLOCK = 16; ///< Job IDs persisted per storage write
 
 /**
  * @class PostPrintJobHttp
@@ -18,6 +19,17 @@ constexpr size_t PRINT_QUEUE_INITIAL_CAPACITY = 128;
  *  - Maintains a queue of print jobs for asynchronous posting.
  *  - Uses a RumpusHttpClient member to perform actual HTTP requests.
  *  - Handles retries if the network is temporarily unavailable.
+ *  - Tags every job with a monotonic ID sent as an "Idempotency-Key"
+ *    header, so a retry after a lost response is not printed twice.
+ *    The key needs storage (so IDs survive a reboot) and a device prefix.
+ *
+ * Stored records:
+ *  - "J<id>:<payload>" a queued job (payload may be LzCodec-packed).
+ *  - "A<id>" every job up to and including <id> was acknowledged.
+ *  - "N<id>" IDs below <id> may have been handed out already.
+ * IDs are reserved JOB_ID_RESERVE_BLOCK at a time, so allocating an ID
+ * only writes to storage once per block. Records from older firmware
+ * without a tag are queued again under a fresh ID.
  *
  * Notes:
  *  - Does not own the NetworkManager; it must remain valid during the lifetime.
@@ -52,8 +64,9 @@ public:
      * @brief Enqueue a print job to be posted asynchronously.
      * Non-blocking; processQueue() will attempt sending.
      * @param job JSON payload or string containing print instructions.
+     * @return Job ID; the request carries idempotencyKey(id).
      */
-    void enqueueJob(const String &job);
+    uint32_t enqueueJob(const String &job);
 
     /**
      * @brief Process queued jobs.
@@ -73,6 +86,34 @@ public:
      */
     void setPath(const String &path);
 
+    /**
+     * @brief Compress queued jobs with LzCodec.
+     *
+     * A job is packed only when it has to be queued, so more of them fit
+     * in RAM and storage; one sent straight away is never packed. With
+     * onWire, jobs are POSTed in compressed form with "Content-Encoding:
+     * x-rumpus-lz"; otherwise queued jobs are expanded before sending.
+     *
+     * @param enabled Compress jobs in the queue and storage.
+     * @param onWire Send the compressed bytes as the request body.
+     */
+    void setCompression(bool enabled, bool onWire = false);
+
+    /**
+     * @brief Prefix for Idempotency-Key values, e.g. a device ID.
+     * Keys are "<prefix><hex job id>"; the server should keep them unique
+     * per device. No key is sent until a prefix is set.
+     */
+    void setIdempotencyPrefix(const String &prefix);
+
+    /**
+     * @brief Idempotency-Key header value sent for a job ID.
+     * @return Empty (no header) unless IDs are persisted, i.e. storage is
+     * set and failed jobs are queued, and a prefix is set; otherwise the
+     * same key would come round again after a reboot.
+     */
+    String idempotencyKey(uint32_t id) const;
+
     void loadFromStorage();
     void saveToStorage(const String &job);
 
@@ -83,13 +124,49 @@ private:
     RumpusHttpClient _httpClient; ///< Internal HTTP client for sending jobs
     bool _queueFailedRequests;    ///< Whether failed jobs are queued
     Storage *_storage;
+    bool _compress = false;       ///< Pack queued jobs with LzCodec
+    bool _compressOnWire = false; ///< Send packed jobs with Content-Encoding
+    size_t _storageEnd = StorageRecords::UNKNOWN_END; ///< End of the stored records, saves a scan per append
+    String _idempotencyPrefix;    ///< Prepended to every Idempotency-Key
+    uint32_t _nextJobId = 1;      ///< Next job ID to hand out
+    uint32_t _reservedJobId = 0;  ///< IDs below this are persisted as used
+    uint32_t _ackedJobId = 0;     ///< Highest acknowledged job ID
+    size_t _storedJobs = 0;       ///< Job records in storage since last compaction
+
+    static constexpr char JOB_TAG = 'J';
+    static constexpr char ACK_TAG = 'A';
+    static constexpr char RESERVE_TAG = 'N';
+    static constexpr char LEGACY_TAG = '\0';
 
     /**
      * @brief Attempt to send a single print job via HTTP.
-     * @param job Job payload to send
+     * @param record Job record ("J<id>:<payload>") to send
      * @return true if successful, false if network unavailable
      */
-    bool sendHttp(const String &job);
+    bool sendHttp(const String &record);
+
+    /**
+     * @brief POST an unpacked job LZ-compressed with Content-Encoding.
+     * @return false, without sending, if it does not get smaller.
+     */
+    bool postCompressed(const String &job);
+
+    bool persistsJobIds() const;
+    uint32_t allocateJobId();
+    void acknowledge(uint32_t id);
+
+    /**
+     * @brief Rewrite storage as the ID reservation plus the pending queue.
+     */
+    void compactStorage();
+
+    static String makeRecord(uint32_t id, const String &job);
+
+    /**
+     * @brief Split a stored record into its tag, ID and payload.
+     * @return JOB_TAG, ACK_TAG, RESERVE_TAG or LEGACY_TAG.
+     */
+    static char parseRecord(const String &record, uint32_t &id, String &job);
 };
 
 #endif // POST_PRINT_JOB_HTTP_H
@@ -7,6 +7,8 @@
 #include "RumpshiftLogger.h"
 #include "HttpClient.h"
 #include <memory>
+#include <utility>
+#include <vector>
 
 #ifdef RUMPUS_USE_ARDUINO_HTTP_CLIENT
 #include "ArduinoHttpClientWrapper.h"
@@ -51,6 +53,106 @@ public:
         _sendRequest("POST", path, payload);
     }
 
+    /**
+     * @brief POST a binary body, e.g. a compressed payload.
+     * @param contentEncoding Optional Content-Encoding header value.
+     */
+    void post(const String &path, const uint8_t *body, size_t length,
+              const char *contentType = "application/json",
+              const char *contentEncoding = nullptr)
+    {
+        NetworkClient *client = _getValidClient("POST");
+        if (!client)
+            return;
+        _lazyInit(client);
+        if (!_httpClient)
+        {
+            _extraHeaders.clear();
+            return;
+        }
+
+        _httpClient->beginRequest();
+        _httpClient->post(path);
+        _sendExtraHeaders();
+        _httpClient->sendHeader("Content-Type", contentType);
+        if (contentEncoding)
+            _httpClient->sendHeader("Content-Encoding", contentEncoding);
+        _httpClient->sendHeader("Content-Length", (int)length);
+        _httpClient->beginBody();
+        _httpClient->write(body, length);
+        _httpClient->endRequest();
+        _lastStatusCode = _httpClient->responseStatusCode();
+    }
+
+    /**
+     * @brief POST a body written straight to the connection, no intermediate buffer.
+     * @param length Exact body length, e.g. from JsonStreamWriter::measure().
+     * @param writeBody Callable taking Print&; must write exactly length bytes.
+     */
+    template <typename BodyWriter>
+    void postStream(const String &path, size_t length, BodyWriter writeBody,
+                    const char *contentType = "application/json")
+    {
+        NetworkClient *client = _getValidClient("POST");
+        if (!client)
+            return;
+        _lazyInit(client);
+        if (!_httpClient)
+        {
+            _extraHeaders.clear();
+            return;
+        }
+
+        _httpClient->beginRequest();
+        _httpClient->post(path);
+        _sendExtraHeaders();
+        _httpClient->sendHeader("Content-Type", contentType);
+        Print *body = _httpClient->beginStreamBody(length);
+        if (body)
+            writeBody(*body);
+        _httpClient->endRequest();
+        _lastStatusCode = _httpClient->responseStatusCode();
+    }
+
+    /**
+     * @brief POST a document in its own format (doc.contentType()).
+     *
+     * Works with any RumpusJsonDocument. Binary formats such as
+     * application/msgpack are negotiated: if the server answers
+     * 415 Unsupported Media Type, the same request is repeated once as JSON
+     * (doc.serialize()) and later documents go straight to JSON until
+     * setBinaryBodies(true) is called again.
+     */
+    template <typename Document>
+    void postDocument(const String &path, Document &doc)
+    {
+        const char *type = doc.contentType();
+        bool binary = type && strcmp(type, "application/json") != 0;
+
+        if (binary && _binaryBodies)
+        {
+            // One-shot headers belong to the logical request, so keep them for a retry
+            std::vector<std::pair<String, String>> headers = _extraHeaders;
+            _lastStatusCode = -1;
+            postStream(path, doc.measure(), [&doc](Print &out) { doc.serializeTo(out); }, type);
+            if (_lastStatusCode != 415)
+                return;
+
+            _binaryBodies = false;
+            _extraHeaders = headers;
+            if (_logger)
+                _logger->warn(String("[RumpusHttpClient] Server rejected ") + type + ", falling back to JSON");
+        }
+
+        post(path, doc.serialize());
+    }
+
+    /**
+     * @brief Allow (default) or suppress binary bodies in postDocument().
+     */
+    void setBinaryBodies(bool enabled) { _binaryBodies = enabled; }
+    bool binaryBodies() const { return _binaryBodies; }
+
     String get(const String &path)
     {
         NetworkClient *client = _getValidClient("GET");
@@ -110,12 +212,30 @@ public:
 
     int lastStatusCode() const { return _lastStatusCode; }
 
+    /**
+     * @brief Add a header to the next request only (e.g. Idempotency-Key).
+     * Cleared once that request has been sent.
+     */
+    void addRequestHeader(const char *name, const String &value)
+    {
+        _extraHeaders.push_back(std::make_pair(String(name), value));
+    }
+
 private:
     NetworkManager &_network;
     RumpshiftLogger *_logger;
 
     std::unique_ptr<HttpClient> _httpClient;
     int _lastStatusCode;
+    std::vector<std::pair<String, String>> _extraHeaders; ///< One-shot headers for the next request
+    bool _binaryBodies = true;                            ///< postDocument() may send non-JSON formats
+
+    void _sendExtraHeaders()
+    {
+        for (const auto &header : _extraHeaders)
+            _httpClient->sendHeader(header.first.c_str(), header.second);
+        _extraHeaders.clear();
+    }
 
     void _lazyInit(NetworkClient *client)
     {
@@ -155,7 +275,10 @@ private:
     void _sendRequest(const String &method, const String &path, const String &payload = "")
     {
         if (!_httpClient)
+        {
+            _extraHeaders.clear();
             return;
+        }
 
         _httpClient->beginRequest();
         if (method == "POST")
@@ -166,6 +289,7 @@ private:
             _httpClient->del(path);
         else
             _httpClient->get(path);
+        _sendExtraHeaders();
 
         if (!payload.isEmpty())
         {
@@ -182,8 +306,13 @@ private:
     NetworkClient *_getValidClient(const String &action)
     {
         NetworkClient *client = _network.getClient();
-        if (!client && _logger)
-            _logger->error("[RumpusHttpClient] _getValidClient returned nullptr for " + action);
+        if (!client)
+        {
+            // The request is abandoned; its one-shot headers go with it
+            _extraHeaders.clear();
+            if (_logger)
+                _logger->error("[RumpusHttpClient] _getValidClient returned nullptr for " + action);
+        }
         return client;
     }
 };
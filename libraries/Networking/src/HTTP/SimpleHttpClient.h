@@ -28,12 +28,24 @@ public:
     {
         _headers = "";
         _body = "";
+        _rawBody = nullptr;
+        _rawLength = 0;
         if (_logger)
             _logger->debug("[SimpleHttpClient] beginRequest called");
     }
 
+    /**
+     * @brief Send the request assembled since beginRequest() and read the response.
+     */
     void endRequest() override
     {
+        if (_streaming)
+            _readResponse();
+        else if (_method.length() > 0)
+            _sendRequest(_method, _path);
+        _method = "";
+        _streaming = false;
+
         if (_client.connected())
         {
             _client.stop();
@@ -42,10 +54,11 @@ public:
         }
     }
 
-    void get(const String &path) override { _sendRequest("GET", path); }
-    void post(const String &path) override { _sendRequest("POST", path); }
-    void put(const String &path) override { _sendRequest("PUT", path); }
-    void del(const String &path) override { _sendRequest("DELETE", path); }
+    // Request line is recorded here; headers and body follow, endRequest() sends
+    void get(const String &path) override { _setRequest("GET", path); }
+    void post(const String &path) override { _setRequest("POST", path); }
+    void put(const String &path) override { _setRequest("PUT", path); }
+    void del(const String &path) override { _setRequest("DELETE", path); }
 
     void sendHeader(const char *name, const String &value) override
     {
@@ -74,6 +87,31 @@ public:
             _logger->debug("[SimpleHttpClient] Body set: " + data);
     }
 
+    void write(const uint8_t *data, size_t len) override
+    {
+        _rawBody = data;
+        _rawLength = len;
+        if (_logger)
+            _logger->debug("[SimpleHttpClient] Binary body set: " + String((unsigned long)len) + " bytes");
+    }
+
+    /**
+     * @brief Connect and send the request line and headers immediately.
+     * The returned Print is the TCP client itself, so the body is never buffered.
+     */
+    Print *beginStreamBody(size_t length) override
+    {
+        if (_method.length() == 0 || !_sendHead(_method, _path, length))
+        {
+            _method = ""; // nothing left for endRequest() to send
+            return nullptr;
+        }
+        _streaming = true;
+        if (_logger)
+            _logger->debug("[SimpleHttpClient] Streaming body: " + String((unsigned long)length) + " bytes");
+        return &_client;
+    }
+
     int responseStatusCode() override { return _statusCode; }
 
     String responseBody() override { return _response; }
@@ -86,12 +124,45 @@ private:
     uint16_t _port;
     RumpshiftLogger *_logger;
 
+    String _method;
+    String _path;
     String _headers;
     String _body;
+    const uint8_t *_rawBody = nullptr; ///< Binary body (not owned), overrides _body
+    size_t _rawLength = 0;
     String _response;
     int _statusCode;
+    bool _streaming = false; ///< Head already sent by beginStreamBody()
+
+    void _setRequest(const String &method, const String &path)
+    {
+        _method = method;
+        _path = path;
+    }
+
+    size_t _bodyLength() const { return _rawBody ? _rawLength : _body.length(); }
 
     void _sendRequest(const String &method, const String &path)
+    {
+        if (!_sendHead(method, path, _bodyLength()))
+            return;
+
+        // Send body
+        if (_bodyLength() > 0)
+        {
+            if (_rawBody)
+                _client.write(_rawBody, _rawLength);
+            else
+                _client.print(_body);
+            if (_logger)
+                _logger->debug("[SimpleHttpClient] Request body sent");
+        }
+
+        _readResponse();
+    }
+
+    // Connect and send request line, headers and Content-Length
+    bool _sendHead(const String &method, const String &path, size_t bodyLength)
     {
         if (_logger)
             _logger->info("[SimpleHttpClient] Sending " + method + " request to " + String(_host) + ":" + String(_port) + path);
@@ -101,7 +172,8 @@ private:
             _statusCode = 0;
             if (_logger)
                 _logger->warn("[SimpleHttpClient] Failed to connect to host");
-            return;
+            _clearRequest();
+            return false;
         }
 
         // Send request line and Host header
@@ -119,24 +191,20 @@ private:
                 _logger->debug("[SimpleHttpClient] Custom headers sent:\n" + _headers);
         }
 
-        // Send Content-Length header if body exists
-        if (_body.length() > 0)
+        // Send Content-Length header if body exists and the caller did not
+        if (bodyLength > 0 && _headers.indexOf("Content-Length:") < 0)
         {
-            _client.print("Content-Length: " + String(_body.length()) + "\r\n");
+            _client.print("Content-Length: " + String((unsigned long)bodyLength) + "\r\n");
             if (_logger)
-                _logger->debug("[SimpleHttpClient] Content-Length: " + String(_body.length()));
+                _logger->debug("[SimpleHttpClient] Content-Length: " + String((unsigned long)bodyLength));
         }
 
         _client.print("\r\n"); // End of headers
+        return true;
+    }
 
-        // Send body
-        if (_body.length() > 0)
-        {
-            _client.print(_body);
-            if (_logger)
-                _logger->debug("[SimpleHttpClient] Request body sent");
-        }
-
+    void _readResponse()
+    {
         // Read response
         _response = "";
         unsigned long start = millis();
@@ -175,9 +243,16 @@ private:
                 _logger->warn("[SimpleHttpClient] Failed to parse status code from response");
         }
 
-        // Clear headers and body for next request
+        _clearRequest();
+    }
+
+    // Clear headers and body for next request
+    void _clearRequest()
+    {
         _headers = "";
         _body = "";
+        _rawBody = nullptr;
+        _rawLength = 0;
     }
 };
 
@@ -1,6 +1,7 @@
 #pragma once
 #include <Arduino.h>
 #include <ArduinoJson.h>
+#include <JsonDocumentPool.h>
 
 // Custom libs
 #include <RumpshiftLogger.h>
@@ -43,8 +44,9 @@ public:
     PinManager *pinManager = nullptr;
     TimeHelper *timeHelper = nullptr;
 
-    // Shared JSON buffer for structured logs
-    StaticJsonDocument<512> logDoc;
+    // Recycled JSON documents for structured logs; lease one per message:
+    //   auto doc = core.jsonPool.lease(256);
+    JsonDocumentPool jsonPool;
 
     RumpusArduinoCore();
     ~RumpusArduinoCore();
@@ -29,6 +29,35 @@ public:
         EEPROM.commit();
     }
 
+    size_t size() const override
+    {
+        return EEPROM_SIZE;
+    }
+
+    size_t read(size_t offset, uint8_t *buf, size_t len) override
+    {
+        if (offset >= EEPROM_SIZE)
+            return 0;
+        len = min(len, (size_t)EEPROM_SIZE - offset);
+        for (size_t i = 0; i < len; i++)
+            buf[i] = EEPROM.read(offset + i);
+        return len;
+    }
+
+    size_t write(size_t offset, const uint8_t *buf, size_t len) override
+    {
+        if (offset >= EEPROM_SIZE)
+            return 0;
+        len = min(len, (size_t)EEPROM_SIZE - offset);
+        for (size_t i = 0; i < len; i++)
+        {
+            if (EEPROM.read(offset + i) != buf[i])
+                EEPROM.write(offset + i, buf[i]);
+        }
+        EEPROM.commit();
+        return len;
+    }
+
     String load() override
     {
         String result;
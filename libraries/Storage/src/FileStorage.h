@@ -0,0 +1,237 @@
+// FileStorage.h
+#pragma once
+#include "Storage.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @class FileStorage
+ * @brief Host-only Storage backend on a regular file, for simulation and load tests.
+ *
+ * The file is sized to the requested capacity and memory-mapped when
+ * possible; otherwise every access goes through pread/pwrite. Data
+ * survives across instances, so a test can "reboot" by opening the same
+ * path again.
+ *
+ * Fault injection for the queue's recovery paths:
+ *  - setWriteLatency(): sleep on every write() to mimic slow media.
+ *  - failAfterBytes(): a torn write. The write that crosses the budget is
+ *    cut short and later writes are dropped until resetFaults().
+ *  - setDiskFull(): only the first N bytes accept writes.
+ *
+ * Only built on Unix-like hosts; on boards this header is empty.
+ */
+class FileStorage : public Storage
+{
+public:
+    static constexpr size_t NO_LIMIT = (size_t)-1;
+
+    /**
+     * @param path File to use; created if missing.
+     * @param capacity Region size in bytes.
+     * @param useMmap Map the file; falls back to pread/pwrite on failure.
+     */
+    explicit FileStorage(const char *path, size_t capacity = MAX_SIZE, bool useMmap = true)
+        : _path(path), _capacity(capacity), _useMmap(useMmap)
+    {
+    }
+
+    ~FileStorage() override { close(); }
+
+    FileStorage(const FileStorage &) = delete;
+    FileStorage &operator=(const FileStorage &) = delete;
+
+    void begin() override
+    {
+        if (_fd >= 0)
+            return;
+
+        _fd = ::open(_path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (_fd < 0)
+            return;
+
+        // Grow (never shrink) to capacity; new bytes read as 0 = empty log
+        struct stat st;
+        if (fstat(_fd, &st) == 0 && (size_t)st.st_size < _capacity)
+            ftruncate(_fd, _capacity);
+        map();
+    }
+
+    /**
+     * @brief Unmap and close the file. begin() reopens it.
+     */
+    void close()
+    {
+        unmap();
+        if (_fd >= 0)
+            ::close(_fd);
+        _fd = -1;
+    }
+
+    void clear() override
+    {
+        if (_fd < 0 || _powerLost)
+            return;
+
+        // Truncate and regrow: zero-fills large files without touching every page
+        unmap();
+        ftruncate(_fd, 0);
+        ftruncate(_fd, _capacity);
+        map();
+    }
+
+    size_t size() const override
+    {
+        return _capacity;
+    }
+
+    size_t read(size_t offset, uint8_t *buf, size_t len) override
+    {
+        if (_fd < 0 || offset >= _capacity)
+            return 0;
+        len = min(len, _capacity - offset);
+
+        if (_map)
+        {
+            memcpy(buf, _map + offset, len);
+            return len;
+        }
+        ssize_t n = pread(_fd, buf, len, offset);
+        return n > 0 ? (size_t)n : 0;
+    }
+
+    size_t write(size_t offset, const uint8_t *buf, size_t len) override
+    {
+        if (_fd < 0 || offset >= _capacity)
+            return 0;
+        len = min(len, _capacity - offset);
+
+        if (_latencyMicros > 0)
+            sleepMicros(_latencyMicros);
+
+        // Fault injection: full disk, then torn write / power loss
+        if (offset >= _writableLimit)
+            return 0;
+        len = min(len, _writableLimit - offset);
+        if (_powerLost)
+            return 0;
+        if (_bytesUntilFailure != NO_LIMIT)
+        {
+            if (len >= _bytesUntilFailure)
+            {
+                len = _bytesUntilFailure;
+                _powerLost = true;
+            }
+            _bytesUntilFailure -= len;
+        }
+
+        size_t written = len;
+        if (_map)
+        {
+            memcpy(_map + offset, buf, len);
+        }
+        else if (len > 0)
+        {
+            ssize_t n = pwrite(_fd, buf, len, offset);
+            written = n > 0 ? (size_t)n : 0;
+        }
+
+        _writeCount++;
+        _bytesWritten += written;
+        return written;
+    }
+
+    /**
+     * @brief Flush mapped pages to the file.
+     */
+    void sync()
+    {
+        if (_map)
+            msync(_map, _capacity, MS_SYNC);
+        else if (_fd >= 0)
+            fsync(_fd);
+    }
+
+    // --- Fault injection ---
+
+    /**
+     * @brief Delay every write() by the given number of microseconds.
+     */
+    void setWriteLatency(uint32_t micros) { _latencyMicros = micros; }
+
+    /**
+     * @brief Let 'bytes' more bytes through, then tear the write in progress
+     * and drop all later writes (simulated power loss).
+     */
+    void failAfterBytes(size_t bytes) { _bytesUntilFailure = bytes; }
+
+    /**
+     * @brief Accept writes only below 'usableBytes'; later writes come back short.
+     */
+    void setDiskFull(size_t usableBytes) { _writableLimit = usableBytes; }
+
+    /**
+     * @brief Restore power and remove all injected faults and latency.
+     */
+    void resetFaults()
+    {
+        _latencyMicros = 0;
+        _bytesUntilFailure = NO_LIMIT;
+        _writableLimit = NO_LIMIT;
+        _powerLost = false;
+    }
+
+    bool powerLost() const { return _powerLost; }
+
+    // --- Statistics ---
+
+    bool isMapped() const { return _map != nullptr; }
+    size_t writeCount() const { return _writeCount; }
+    size_t bytesWritten() const { return _bytesWritten; }
+
+private:
+    String _path;
+    size_t _capacity;
+    bool _useMmap;
+    int _fd = -1;
+    uint8_t *_map = nullptr;
+
+    uint32_t _latencyMicros = 0;
+    size_t _bytesUntilFailure = NO_LIMIT;
+    size_t _writableLimit = NO_LIMIT;
+    bool _powerLost = false;
+
+    size_t _writeCount = 0;
+    size_t _bytesWritten = 0;
+
+    void map()
+    {
+        if (!_useMmap || _fd < 0 || _capacity == 0)
+            return;
+        void *p = mmap(nullptr, _capacity, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+        _map = p == MAP_FAILED ? nullptr : static_cast<uint8_t *>(p);
+    }
+
+    void unmap()
+    {
+        if (_map)
+            munmap(_map, _capacity);
+        _map = nullptr;
+    }
+
+    static void sleepMicros(uint32_t micros)
+    {
+        struct timespec ts;
+        ts.tv_sec = micros / 1000000UL;
+        ts.tv_nsec = (long)(micros % 1000000UL) * 1000L;
+        nanosleep(&ts, nullptr);
+    }
+};
+
+#endif // __unix__ || __APPLE__
@@ -1,13 +1,84 @@
 #pragma once
 #include <Arduino.h>
 
+/**
+ * @class Storage
+ * @brief Persistent byte region used to keep data across resets.
+ *
+ * Backends implement byte-range access (size/read/write). save() and load()
+ * are convenience wrappers that treat the region as a NUL-terminated string
+ * starting at offset 0; backends may override them with native versions.
+ *
+ * Offsets are size_t so large backends (SD, QSPI flash) can expose
+ * megabytes without copying the region into RAM. Use StorageStream for
+ * sequential access.
+ */
 class Storage
 {
 public:
     static constexpr int MAX_SIZE = 512;
     virtual void begin() = 0;
     virtual void clear() = 0;
-    virtual void save(const String &data) = 0;
-    virtual String load() = 0;
+
+    /**
+     * @brief Total number of addressable bytes.
+     */
+    virtual size_t size() const = 0;
+
+    /**
+     * @brief Read up to len bytes starting at offset.
+     * @return Number of bytes read (0 if offset is out of range).
+     */
+    virtual size_t read(size_t offset, uint8_t *buf, size_t len) = 0;
+
+    /**
+     * @brief Write len bytes starting at offset and persist them.
+     * @return Number of bytes written (may be short at the end of the region).
+     */
+    virtual size_t write(size_t offset, const uint8_t *buf, size_t len) = 0;
+
+    /**
+     * @brief Store a string at offset 0, truncated to size() - 1 bytes.
+     */
+    virtual void save(const String &data)
+    {
+        if (size() == 0)
+            return;
+        size_t len = min((size_t)data.length(), size() - 1);
+        // One write (and commit) when the string's own terminator fits
+        if (len == data.length())
+        {
+            write(0, reinterpret_cast<const uint8_t *>(data.c_str()), len + 1);
+            return;
+        }
+        write(0, reinterpret_cast<const uint8_t *>(data.c_str()), len);
+        const uint8_t terminator = 0;
+        write(len, &terminator, 1);
+    }
+
+    /**
+     * @brief Read the string stored at offset 0 (up to NUL or erased 0xFF).
+     */
+    virtual String load()
+    {
+        String result;
+        uint8_t chunk[32];
+        size_t offset = 0;
+        while (offset < size())
+        {
+            size_t n = read(offset, chunk, sizeof(chunk));
+            if (n == 0)
+                break;
+            for (size_t i = 0; i < n; i++)
+            {
+                if (chunk[i] == '\0' || chunk[i] == 0xFF)
+                    return result;
+                result += (char)chunk[i];
+            }
+            offset += n;
+        }
+        return result;
+    }
+
     virtual ~Storage() {}
 };
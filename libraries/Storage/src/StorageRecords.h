@@ -0,0 +1,188 @@
+// StorageRecords.h
+#pragma once
+#include "Storage.h"
+#include "StorageStream.h"
+#include <memory>
+#include <string.h>
+
+#ifndef STORAGE_RECORDS_MAX_BATCH
+#define STORAGE_RECORDS_MAX_BATCH 1024 ///< Largest compacted log rewritten with a single write()
+#endif
+
+/**
+ * @class StorageRecords
+ * @brief Newline-delimited record log on top of a Storage backend.
+ *
+ * Layout: "record\nrecord\n...record\0". This is the format the HTTP
+ * uploaders have always written, so existing stored data stays readable.
+ * Records are appended and iterated through byte-range access; the region
+ * is never loaded into a single String.
+ */
+class StorageRecords
+{
+public:
+    static constexpr size_t UNKNOWN_END = (size_t)-1; ///< No cached end: append() scans for it
+
+    /**
+     * @brief Number of bytes in use (offset of the terminator).
+     * An erased cell (0xFF) also terminates the log.
+     */
+    static size_t usedLength(Storage &storage)
+    {
+        StorageStream in(storage);
+        int c;
+        while ((c = in.read()) >= 0)
+        {
+            if (c == '\0' || c == 0xFF)
+                return in.position() - 1;
+        }
+        return in.position();
+    }
+
+    /**
+     * @brief Append a record, dropping the oldest records if it does not fit.
+     *
+     * The record, or the compacted region when records are dropped, is
+     * assembled in RAM and handed to the backend as a single write(), so
+     * page-committing backends (WearLevelStorage, EEPROMStorage) commit
+     * once per append and a power loss leaves either the old or the new log.
+     * Regions larger than STORAGE_RECORDS_MAX_BATCH are compacted in place
+     * in chunks first.
+     *
+     * Pass the same 'end' to every append to skip the usedLength() scan:
+     * it starts as UNKNOWN_END and is left at the new terminator offset.
+     * Reset it to UNKNOWN_END whenever the storage is written some other
+     * way (clear(), save(), begin()).
+     * @return false if the record alone is larger than the region or no
+     *         buffer could be allocated.
+     */
+    static bool append(Storage &storage, const uint8_t *data, size_t len, size_t &end)
+    {
+        size_t capacity = storage.size();
+        size_t used = end != UNKNOWN_END && end < capacity ? end : usedLength(storage);
+        end = UNKNOWN_END;
+        if (len + 1 > capacity)
+            return false;
+
+        size_t at = used; // where the write starts
+        size_t from = 0;  // older records carried into the write, and their length
+        size_t kept = 0;
+        if (used + (used > 0 ? 1 : 0) + len + 1 > capacity)
+        {
+            from = dropPoint(storage, used, used + 1 + len + 1 - capacity);
+            kept = used - from;
+            at = 0;
+            if (kept + 1 + len + 1 > STORAGE_RECORDS_MAX_BATCH)
+            {
+                // Too big to stage in RAM: shift the survivors down, then append
+                at = moveDown(storage, from, kept);
+                kept = 0;
+            }
+        }
+
+        // [older records]['\n']record'\0'
+        bool separator = at + kept > 0;
+        size_t total = kept + (separator ? 1 : 0) + len + 1;
+        std::unique_ptr<uint8_t[]> buf(new uint8_t[total]);
+        if (!buf)
+            return false;
+
+        size_t n = kept > 0 ? storage.read(from, buf.get(), kept) : 0;
+        if (separator)
+            buf[n++] = '\n';
+        memcpy(buf.get() + n, data, len);
+        n += len;
+        buf[n++] = '\0';
+
+        if (storage.write(at, buf.get(), n) != n)
+            return false;
+        end = at + n - 1;
+        return true;
+    }
+
+    static bool append(Storage &storage, const uint8_t *data, size_t len)
+    {
+        size_t end = UNKNOWN_END;
+        return append(storage, data, len, end);
+    }
+
+    static bool append(Storage &storage, const String &record, size_t &end)
+    {
+        return append(storage, reinterpret_cast<const uint8_t *>(record.c_str()), record.length(), end);
+    }
+
+    static bool append(Storage &storage, const String &record)
+    {
+        size_t end = UNKNOWN_END;
+        return append(storage, record, end);
+    }
+
+    /**
+     * @brief Invoke fn(const String &record) for every stored record, oldest first.
+     * Only one record is held in RAM at a time.
+     */
+    template <typename Fn>
+    static size_t forEach(Storage &storage, Fn fn)
+    {
+        StorageStream in(storage);
+        String line;
+        size_t count = 0;
+        int c;
+        while ((c = in.read()) >= 0 && c != '\0' && c != 0xFF)
+        {
+            if (c == '\n')
+            {
+                if (line.length() > 0)
+                {
+                    fn(line);
+                    count++;
+                }
+                line = "";
+                continue;
+            }
+            line += (char)c;
+        }
+        if (line.length() > 0)
+        {
+            fn(line);
+            count++;
+        }
+        return count;
+    }
+
+private:
+    /**
+     * @brief Offset of the first record boundary at or after 'bytes'
+     *        (used if there is none, i.e. every record must go).
+     */
+    static size_t dropPoint(Storage &storage, size_t used, size_t bytes)
+    {
+        StorageStream in(storage);
+        int c;
+        while ((c = in.read()) >= 0 && in.position() <= used)
+        {
+            if (c == '\n' && in.position() >= bytes)
+                return in.position();
+        }
+        return used;
+    }
+
+    /**
+     * @brief Shift 'length' bytes at 'from' down to offset 0 in small chunks.
+     * @return Bytes moved.
+     */
+    static size_t moveDown(Storage &storage, size_t from, size_t length)
+    {
+        uint8_t chunk[StorageStream::BUFFER_SIZE];
+        size_t moved = 0;
+        while (moved < length)
+        {
+            size_t n = storage.read(from + moved, chunk, min(sizeof(chunk), length - moved));
+            if (n == 0)
+                break;
+            storage.write(moved, chunk, n);
+            moved += n;
+        }
+        return moved;
+    }
+};
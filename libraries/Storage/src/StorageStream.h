@@ -0,0 +1,152 @@
+// StorageStream.h
+#pragma once
+#include "Storage.h"
+
+/**
+ * @class StorageStream
+ * @brief Stream cursor over a byte range of a Storage backend.
+ *
+ * Reads are served from a small internal buffer refilled with
+ * Storage::read(), so sequential parsing never copies the whole region.
+ * Single-byte writes are buffered and handed to Storage::write() on
+ * flush(), seek() or destruction; bulk writes go straight through.
+ */
+class StorageStream : public Stream
+{
+public:
+    static constexpr size_t BUFFER_SIZE = 32;
+
+    /**
+     * @param storage Backend to read from / write to.
+     * @param offset Start of the window (absolute offset in the backend).
+     * @param length Window length; clipped to the backend size.
+     */
+    explicit StorageStream(Storage &storage, size_t offset = 0, size_t length = (size_t)-1)
+        : _storage(storage),
+          _start(min(offset, storage.size())),
+          _end(_start + min(length, storage.size() - _start)),
+          _pos(_start)
+    {
+    }
+
+    ~StorageStream() { flush(); }
+
+    // --- Stream ---
+
+    int available() override
+    {
+        size_t left = _end - _pos;
+        return left > 0x7FFF ? 0x7FFF : (int)left;
+    }
+
+    int read() override
+    {
+        int c = peek();
+        if (c >= 0)
+            _pos++;
+        return c;
+    }
+
+    int peek() override
+    {
+        if (_pos >= _end)
+            return -1;
+        if (!fill())
+            return -1;
+        return _buffer[_pos - _bufferStart];
+    }
+
+    using Stream::readBytes;
+
+    /**
+     * @brief Read up to len bytes straight from the backend.
+     */
+    size_t readBytes(uint8_t *buf, size_t len)
+    {
+        flushWrites();
+        len = min(len, _end - _pos);
+        size_t n = _storage.read(_pos, buf, len);
+        _pos += n;
+        return n;
+    }
+
+    // --- Print ---
+
+    size_t write(uint8_t b) override
+    {
+        if (_pos >= _end)
+            return 0;
+        if (_pending > 0 && (_pending == BUFFER_SIZE || _pendingStart + _pending != _pos))
+            flushWrites();
+
+        invalidate();
+        if (_pending == 0)
+            _pendingStart = _pos;
+        _buffer[_pending++] = b;
+        _pos++;
+        return 1;
+    }
+
+    size_t write(const uint8_t *buf, size_t len) override
+    {
+        flushWrites();
+        invalidate();
+        len = min(len, _end - _pos);
+        size_t n = _storage.write(_pos, buf, len);
+        _pos += n;
+        return n;
+    }
+
+    void flush() override { flushWrites(); }
+
+    // --- Cursor ---
+
+    /**
+     * @brief Move the cursor to a position relative to the window start.
+     */
+    bool seek(size_t position)
+    {
+        flushWrites();
+        if (_start + position > _end)
+            return false;
+        _pos = _start + position;
+        return true;
+    }
+
+    size_t position() const { return _pos - _start; }
+    size_t size() const { return _end - _start; }
+
+private:
+    Storage &_storage;
+    size_t _start;
+    size_t _end;
+    size_t _pos;
+
+    uint8_t _buffer[BUFFER_SIZE];
+    size_t _bufferStart = 0;
+    size_t _bufferLen = 0; ///< Valid read-cache bytes in _buffer
+    size_t _pendingStart = 0;
+    size_t _pending = 0; ///< Buffered write bytes in _buffer
+
+    bool fill()
+    {
+        if (_pending > 0)
+            flushWrites();
+        if (_bufferLen > 0 && _pos >= _bufferStart && _pos < _bufferStart + _bufferLen)
+            return true;
+
+        _bufferStart = _pos;
+        _bufferLen = _storage.read(_pos, _buffer, min((size_t)BUFFER_SIZE, _end - _pos));
+        return _bufferLen > 0;
+    }
+
+    void invalidate() { _bufferLen = 0; }
+
+    void flushWrites()
+    {
+        if (_pending == 0)
+            return;
+        _storage.write(_pendingStart, _buffer, _pending);
+        _pending = 0;
+    }
+};
@@ -0,0 +1,298 @@
+// WearLevelStorage.h
+#pragma once
+#include "Storage.h"
+#include <EEPROM.h>
+
+#ifndef EEPROM_SIZE
+#define EEPROM_SIZE 512
+#endif
+
+/**
+ * @class WearLevelStorageT
+ * @brief Wear-levelled, CRC-protected Storage backend for EEPROM-like devices.
+ *
+ * The region is split into fixed-size pages. Every save() writes the next
+ * page in the ring instead of rewriting offset 0, so wear is spread evenly
+ * across all cells. Each page carries a header:
+ *
+ *   [0]      marker (PAGE_MAGIC once the slot has been written)
+ *   [1..4]   sequence number (little endian)
+ *   [5..6]   payload length (little endian)
+ *   [7..10]  CRC32 over sequence, length and payload
+ *
+ * A page only counts if its marker and CRC are valid. A recycled slot keeps
+ * the marker from its last use, so it is the CRC that rejects a write torn
+ * by a power loss, and begin() falls back to the newest intact page.
+ * Bytes that already hold the right value are not rewritten. Byte-range
+ * write() calls are copy-on-write: each one commits a new page.
+ *
+ * The device type is a template parameter so the same code runs against
+ * the board's EEPROM object or an in-memory mock on the host. It must
+ * provide begin(size), read(addr), write(addr, value) and commit().
+ */
+template <typename Eeprom>
+class WearLevelStorageT : public Storage
+{
+public:
+    static constexpr uint8_t PAGE_MAGIC = 0xA5;
+    static constexpr size_t HEADER_SIZE = 11;
+    static constexpr uint8_t DEFAULT_PAGES = 4;
+
+    /**
+     * @brief Construct a wear-levelled store.
+     * @param eeprom Underlying EEPROM-like device.
+     * @param regionSize Number of bytes of the device to use.
+     * @param pages Number of pages the region is divided into (>= 2).
+     */
+    explicit WearLevelStorageT(Eeprom &eeprom,
+                               size_t regionSize = EEPROM_SIZE,
+                               uint8_t pages = DEFAULT_PAGES)
+        : _eeprom(eeprom),
+          _regionSize(regionSize),
+          _pages(pages < 2 ? 2 : pages),
+          _pageSize(regionSize / (pages < 2 ? 2 : pages))
+    {
+    }
+
+    /**
+     * @brief Initialize the device and locate the newest valid page.
+     */
+    void begin() override
+    {
+        _eeprom.begin(_regionSize);
+
+        _current = -1;
+        _sequence = 0;
+        for (uint8_t page = 0; page < _pages; page++)
+        {
+            uint32_t seq;
+            uint16_t len;
+            if (validatePage(page, seq, len) && (_current < 0 || seq > _sequence))
+            {
+                _current = page;
+                _sequence = seq;
+                _length = len;
+            }
+        }
+    }
+
+    /**
+     * @brief Commit an empty page instead of erasing the whole region.
+     */
+    void clear() override
+    {
+        commitPage(nullptr, 0, 0, 0);
+    }
+
+    /**
+     * @brief Write data to the next page in the ring.
+     * Data longer than capacity() is truncated.
+     */
+    void save(const String &data) override
+    {
+        size_t len = min((size_t)data.length(), capacity());
+        commitPage(reinterpret_cast<const uint8_t *>(data.c_str()), 0, len, len);
+    }
+
+    /**
+     * @brief Read the payload of the newest valid page.
+     */
+    String load() override
+    {
+        String result;
+        if (_current < 0)
+            return result;
+
+        size_t base = pageBase(_current) + HEADER_SIZE;
+        result.reserve(_length);
+        for (size_t i = 0; i < _length; i++)
+        {
+            char c = (char)_eeprom.read(base + i);
+            if (c == '\0')
+                break;
+            result += c;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Addressable bytes; equal to the payload capacity of one page.
+     */
+    size_t size() const override { return capacity(); }
+
+    /**
+     * @brief Read from the newest page. Bytes past its payload read as 0.
+     */
+    size_t read(size_t offset, uint8_t *buf, size_t len) override
+    {
+        if (offset >= capacity())
+            return 0;
+        len = min(len, capacity() - offset);
+
+        size_t base = pageBase(_current < 0 ? 0 : _current) + HEADER_SIZE;
+        for (size_t i = 0; i < len; i++)
+        {
+            size_t pos = offset + i;
+            buf[i] = (_current >= 0 && pos < _length) ? readByte(base + pos) : 0;
+        }
+        return len;
+    }
+
+    /**
+     * @brief Copy the newest page into the next slot with [offset, offset + len)
+     *        replaced, then commit it. One page commit per call.
+     */
+    size_t write(size_t offset, const uint8_t *buf, size_t len) override
+    {
+        if (offset >= capacity())
+            return 0;
+        len = min(len, capacity() - offset);
+        commitPage(buf, offset, len, max((size_t)_length, offset + len));
+        return len;
+    }
+
+    /**
+     * @brief Maximum payload bytes a single page can hold.
+     */
+    size_t capacity() const { return _pageSize - HEADER_SIZE; }
+
+    /**
+     * @brief Sequence number of the newest valid page (0 if none).
+     */
+    uint32_t sequence() const { return _current < 0 ? 0 : _sequence; }
+
+    /**
+     * @brief Index of the newest valid page, or -1 if the region is blank.
+     */
+    int currentPage() const { return _current; }
+
+    /**
+     * @brief Bitwise CRC32 (IEEE 802.3), chainable via the crc argument.
+     */
+    static uint32_t crc32(const uint8_t *data, size_t len, uint32_t crc = 0)
+    {
+        crc = ~crc;
+        while (len--)
+        {
+            crc ^= *data++;
+            for (uint8_t bit = 0; bit < 8; bit++)
+                crc = (crc >> 1) ^ (0xEDB88320UL & (0 - (crc & 1)));
+        }
+        return ~crc;
+    }
+
+private:
+    Eeprom &_eeprom;
+    size_t _regionSize;
+    uint8_t _pages;
+    size_t _pageSize;
+
+    int _current = -1;      ///< Newest valid page index
+    uint32_t _sequence = 0; ///< Sequence number of _current
+    uint16_t _length = 0;   ///< Payload length of _current
+
+    size_t pageBase(uint8_t page) const { return (size_t)page * _pageSize; }
+
+    void updateByte(size_t addr, uint8_t value)
+    {
+        if (_eeprom.read(addr) != value)
+            _eeprom.write(addr, value);
+    }
+
+    uint8_t readByte(size_t addr) { return _eeprom.read(addr); }
+
+    bool validatePage(uint8_t page, uint32_t &seq, uint16_t &len)
+    {
+        size_t base = pageBase(page);
+        if (readByte(base) != PAGE_MAGIC)
+            return false;
+
+        uint8_t header[6];
+        for (uint8_t i = 0; i < sizeof(header); i++)
+            header[i] = readByte(base + 1 + i);
+
+        seq = (uint32_t)header[0] | ((uint32_t)header[1] << 8) |
+              ((uint32_t)header[2] << 16) | ((uint32_t)header[3] << 24);
+        len = (uint16_t)header[4] | ((uint16_t)header[5] << 8);
+        if (len > capacity())
+            return false;
+
+        uint32_t stored = 0;
+        for (uint8_t i = 0; i < 4; i++)
+            stored |= (uint32_t)readByte(base + 7 + i) << (8 * i);
+
+        uint32_t crc = crc32(header, sizeof(header));
+        for (size_t i = 0; i < len; i++)
+        {
+            uint8_t b = readByte(base + HEADER_SIZE + i);
+            crc = crc32(&b, 1, crc);
+        }
+        return crc == stored;
+    }
+
+    /**
+     * @brief Payload byte i of the page being written: patched bytes come
+     *        from the caller, the rest from the current page (0 past its end).
+     */
+    uint8_t pendingByte(size_t i, const uint8_t *patch, size_t patchOffset, size_t patchLen)
+    {
+        if (i >= patchOffset && i < patchOffset + patchLen)
+            return patch[i - patchOffset];
+        if (_current >= 0 && i < _length)
+            return readByte(pageBase(_current) + HEADER_SIZE + i);
+        return 0;
+    }
+
+    /**
+     * @brief Write a page into the next slot and make it current.
+     *
+     * The new payload is the current page with [patchOffset, patchOffset +
+     * patchLen) replaced, truncated or zero-extended to newLen. Payload,
+     * header and CRC go first, then the marker and a single commit(). The
+     * marker is not cleared beforehand (that would double the wear on its
+     * cell), so a torn page is rejected by its CRC alone.
+     */
+    void commitPage(const uint8_t *patch, size_t patchOffset, size_t patchLen, size_t newLen)
+    {
+        uint8_t page = _current < 0 ? 0 : (uint8_t)((_current + 1) % _pages);
+        uint32_t seq = _sequence + 1;
+        size_t base = pageBase(page);
+
+        uint8_t header[6] = {
+            (uint8_t)seq, (uint8_t)(seq >> 8), (uint8_t)(seq >> 16), (uint8_t)(seq >> 24),
+            (uint8_t)newLen, (uint8_t)(newLen >> 8)};
+        uint32_t crc = crc32(header, sizeof(header));
+        for (size_t i = 0; i < newLen; i++)
+        {
+            uint8_t b = pendingByte(i, patch, patchOffset, patchLen);
+            crc = crc32(&b, 1, crc);
+        }
+
+        for (size_t i = 0; i < newLen; i++)
+            updateByte(base + HEADER_SIZE + i, pendingByte(i, patch, patchOffset, patchLen));
+        for (uint8_t i = 0; i < sizeof(header); i++)
+            updateByte(base + 1 + i, header[i]);
+        for (uint8_t i = 0; i < 4; i++)
+            updateByte(base + 7 + i, (uint8_t)(crc >> (8 * i)));
+        updateByte(base, PAGE_MAGIC);
+        _eeprom.commit();
+
+        _current = page;
+        _sequence = seq;
+        _length = (uint16_t)newLen;
+    }
+};
+
+/**
+ * @class WearLevelStorage
+ * @brief WearLevelStorageT bound to the board's global EEPROM object.
+ */
+class WearLevelStorage : public WearLevelStorageT<decltype(EEPROM)>
+{
+public:
+    explicit WearLevelStorage(size_t regionSize = EEPROM_SIZE,
+                              uint8_t pages = DEFAULT_PAGES)
+        : WearLevelStorageT<decltype(EEPROM)>(EEPROM, regionSize, pages)
+    {
+    }
+};
@@ -0,0 +1,159 @@
+#include <unity.h>
+#include "LzCodec.h"
+
+// Representative offline-queue payloads
+static const char *const LZ_SAMPLE_RECORDS[] = {
+    "{\"level\":\"info\",\"message\":\"WiFi connected\",\"source\":\"coffee-bar\",\"timestamp\":\"2025-03-14T08:15:02Z\"}",
+    "{\"level\":\"warn\",\"message\":\"network unavailable, queuing message\",\"source\":\"coffee-bar\",\"uptime\":183022}",
+    "{\"user\":\"Chuck\",\"duration\":120,\"status\":\"ok\",\"timestamp\":\"2025-03-14T08:17:45Z\"}",
+    "{\"job\":\"Latte x2\",\"copies\":1,\"printer\":\"bar-1\",\"user\":\"Chuck\"}",
+    "{\"results\":[{\"id\":\"17\",\"name\":\"Chuck\"},{\"id\":\"18\",\"name\":\"Sam\"}]}",
+};
+static const size_t LZ_SAMPLE_COUNT = sizeof(LZ_SAMPLE_RECORDS) / sizeof(LZ_SAMPLE_RECORDS[0]);
+
+#ifndef LZ_BENCH_ITERATIONS
+#define LZ_BENCH_ITERATIONS 200
+#endif
+
+void test_lz_roundtrip();
+void test_lz_incompressible();
+void test_lz_packed_record_has_no_separators();
+void test_lz_unpack_reports_corrupt_records();
+void test_lz_benchmark();
+
+void run_lz_codec_tests()
+{
+    RUN_TEST(test_lz_roundtrip);
+    RUN_TEST(test_lz_incompressible);
+    RUN_TEST(test_lz_packed_record_has_no_separators);
+    RUN_TEST(test_lz_unpack_reports_corrupt_records);
+    RUN_TEST(test_lz_benchmark);
+}
+
+void test_lz_roundtrip()
+{
+    uint8_t packed[256];
+    uint8_t restored[256];
+    for (size_t r = 0; r < LZ_SAMPLE_COUNT; r++)
+    {
+        const uint8_t *in = reinterpret_cast<const uint8_t *>(LZ_SAMPLE_RECORDS[r]);
+        size_t len = strlen(LZ_SAMPLE_RECORDS[r]);
+
+        size_t n = LzCodec::compress(in, len, packed, sizeof(packed));
+        TEST_ASSERT_GREATER_THAN(0, n);
+        TEST_ASSERT_LESS_OR_EQUAL(len, n);
+        TEST_ASSERT_EQUAL(len, LzCodec::decompressedSize(packed, n));
+        TEST_ASSERT_EQUAL(len, LzCodec::decompress(packed, n, restored, sizeof(restored)));
+        TEST_ASSERT_EQUAL_MEMORY(in, restored, len);
+    }
+}
+
+void test_lz_incompressible()
+{
+    uint8_t in[64];
+    uint8_t packed[LzCodec::MAX_MATCH * 8];
+    uint8_t restored[64];
+    uint32_t x = 0x12345678;
+    for (size_t i = 0; i < sizeof(in); i++)
+    {
+        x = x * 1103515245UL + 12345;
+        in[i] = (uint8_t)(x >> 16);
+    }
+
+    size_t n = LzCodec::compress(in, sizeof(in), packed, sizeof(packed));
+    TEST_ASSERT_LESS_OR_EQUAL(LzCodec::maxCompressedSize(sizeof(in)), n);
+    TEST_ASSERT_EQUAL(sizeof(in), LzCodec::decompress(packed, n, restored, sizeof(restored)));
+    TEST_ASSERT_EQUAL_MEMORY(in, restored, sizeof(in));
+
+    // Too little room must fail cleanly instead of overrunning
+    TEST_ASSERT_EQUAL(0, LzCodec::compress(in, sizeof(in), packed, 8));
+    TEST_ASSERT_EQUAL(0, LzCodec::decompress(packed, n, restored, 8));
+}
+
+void test_lz_packed_record_has_no_separators()
+{
+    for (size_t r = 0; r < LZ_SAMPLE_COUNT; r++)
+    {
+        String text = LZ_SAMPLE_RECORDS[r];
+        String record = LzCodec::pack(text);
+        TEST_ASSERT_TRUE(LzCodec::isPacked(record));
+        TEST_ASSERT_TRUE(record.length() < text.length());
+        for (size_t i = 0; i < record.length(); i++)
+        {
+            uint8_t b = (uint8_t)record[i];
+            TEST_ASSERT_TRUE(b != 0x00 && b != '\n' && b != 0xFF);
+        }
+        TEST_ASSERT_EQUAL_STRING(text.c_str(), LzCodec::unpack(record).c_str());
+    }
+
+    // Short text that would not shrink stays plain
+    TEST_ASSERT_EQUAL_STRING("ok", LzCodec::pack("ok").c_str());
+}
+
+// A record that does not decode is reported, not turned into empty text
+void test_lz_unpack_reports_corrupt_records()
+{
+    bool ok = false;
+    TEST_ASSERT_EQUAL_STRING("", LzCodec::unpack("", &ok).c_str());
+    TEST_ASSERT_TRUE(ok);
+    TEST_ASSERT_EQUAL_STRING("plain", LzCodec::unpack("plain", &ok).c_str());
+    TEST_ASSERT_TRUE(ok);
+
+    String record = LzCodec::pack(LZ_SAMPLE_RECORDS[0]);
+    TEST_ASSERT_EQUAL_STRING(LZ_SAMPLE_RECORDS[0], LzCodec::unpack(record, &ok).c_str());
+    TEST_ASSERT_TRUE(ok);
+
+    // Marker, then: a lone flag byte; a back-reference cut after one byte;
+    // one reaching before the dictionary (0x00 and 0xFF escaped)
+    const char *corrupt[] = {"\x1A\x01", "\x1A\x1B\x20\x10", "\x1A\x1B\x20\x1B\xDF\xF0"};
+    for (const char *bad : corrupt)
+    {
+        ok = true;
+        TEST_ASSERT_EQUAL_STRING("", LzCodec::unpack(bad, &ok).c_str());
+        TEST_ASSERT_FALSE(ok);
+    }
+}
+
+// Reports compression ratio and CPU time per record for the sample set.
+void test_lz_benchmark()
+{
+    uint8_t packed[256];
+    uint8_t restored[256];
+    size_t rawBytes = 0;
+    size_t packedBytes = 0;
+    unsigned long encodeUs = 0;
+    unsigned long decodeUs = 0;
+
+    for (int iter = 0; iter < LZ_BENCH_ITERATIONS; iter++)
+    {
+        for (size_t r = 0; r < LZ_SAMPLE_COUNT; r++)
+        {
+            const uint8_t *in = reinterpret_cast<const uint8_t *>(LZ_SAMPLE_RECORDS[r]);
+            size_t len = strlen(LZ_SAMPLE_RECORDS[r]);
+
+            unsigned long t0 = micros();
+            size_t n = LzCodec::compress(in, len, packed, sizeof(packed));
+            unsigned long t1 = micros();
+            LzCodec::decompress(packed, n, restored, sizeof(restored));
+            unsigned long t2 = micros();
+
+            encodeUs += t1 - t0;
+            decodeUs += t2 - t1;
+            if (iter == 0)
+            {
+                rawBytes += len;
+                packedBytes += n;
+            }
+        }
+    }
+
+    unsigned long records = (unsigned long)LZ_BENCH_ITERATIONS * LZ_SAMPLE_COUNT;
+    String report = "raw=" + String((unsigned long)rawBytes) +
+                    " packed=" + String((unsigned long)packedBytes) +
+                    " ratio%=" + String((unsigned long)(packedBytes * 100 / rawBytes)) +
+                    " encodeUs/record=" + String(encodeUs / records) +
+                    " decodeUs/record=" + String(decodeUs / records);
+    TEST_MESSAGE(report.c_str());
+
+    TEST_ASSERT_LESS_OR_EQUAL(rawBytes * 6 / 10, packedBytes);
+}
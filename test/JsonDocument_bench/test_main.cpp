@@ -0,0 +1,403 @@
+// Host-side benchmarks for JsonDocument: time, heap traffic and peak heap per operation.
+// pio test -e JsonDocument_bench
+//
+//   JSON_BENCH_OUT=path        CSV results (default json_bench.csv)
+//   JSON_BENCH_BASELINE=path   CSV from an earlier run; fail on regressions
+//   JSON_BENCH_THRESHOLD=pct   Allowed slowdown over the baseline (default 15); heap may not grow
+#include <Arduino.h>
+#include <unity.h>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <string>
+
+#include "ArduinoJsonWrapper.h"
+#include "JsonArrayWrapper.h"
+
+#ifndef JSON_BENCH_OPS
+#define JSON_BENCH_OPS 2000
+#endif
+
+#ifndef JSON_BENCH_ROUNDS
+#define JSON_BENCH_ROUNDS 5 ///< Timed rounds of JSON_BENCH_OPS; the fastest is reported
+#endif
+
+#ifndef JSON_BENCH_WARMUP
+#define JSON_BENCH_WARMUP 200
+#endif
+
+// ---------------------------------------------------------------------------
+// Heap accounting. On glibc malloc itself is wrapped, so ArduinoJson pools
+// and String buffers are counted too; elsewhere only operator new is seen.
+// ---------------------------------------------------------------------------
+
+struct HeapCounters
+{
+    uint64_t bytes = 0;  ///< Bytes requested
+    uint64_t allocs = 0; ///< Allocation calls
+    int64_t live = 0;    ///< Bytes currently allocated
+    int64_t peak = 0;    ///< High-water mark of live
+};
+
+static HeapCounters heapCounters;
+
+static void countAlloc(size_t size)
+{
+    heapCounters.bytes += size;
+    heapCounters.allocs++;
+    heapCounters.live += size;
+    if (heapCounters.live > heapCounters.peak)
+        heapCounters.peak = heapCounters.live;
+}
+
+static void countFree(size_t size)
+{
+    heapCounters.live -= size;
+}
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+
+extern "C"
+{
+    void *__libc_malloc(size_t size);
+    void *__libc_calloc(size_t count, size_t size);
+    void *__libc_realloc(void *ptr, size_t size);
+    void __libc_free(void *ptr);
+
+    void *malloc(size_t size)
+    {
+        void *ptr = __libc_malloc(size);
+        if (ptr)
+            countAlloc(malloc_usable_size(ptr));
+        return ptr;
+    }
+
+    void *calloc(size_t count, size_t size)
+    {
+        void *ptr = __libc_calloc(count, size);
+        if (ptr)
+            countAlloc(malloc_usable_size(ptr));
+        return ptr;
+    }
+
+    void *realloc(void *ptr, size_t size)
+    {
+        size_t old = ptr ? malloc_usable_size(ptr) : 0;
+        void *moved = __libc_realloc(ptr, size);
+        if (moved)
+        {
+            countFree(old);
+            countAlloc(malloc_usable_size(moved));
+        }
+        return moved;
+    }
+
+    void free(void *ptr)
+    {
+        if (ptr)
+            countFree(malloc_usable_size(ptr));
+        __libc_free(ptr);
+    }
+}
+#else
+#include <new>
+
+// Size header in front of each block so delete knows what it frees
+static const size_t HEAP_HEADER = sizeof(max_align_t);
+
+void *operator new(size_t size)
+{
+    unsigned char *block = static_cast<unsigned char *>(malloc(size + HEAP_HEADER));
+    if (!block)
+        throw std::bad_alloc();
+    memcpy(block, &size, sizeof(size));
+    countAlloc(size);
+    return block + HEAP_HEADER;
+}
+
+void operator delete(void *ptr) noexcept
+{
+    if (!ptr)
+        return;
+    unsigned char *block = static_cast<unsigned char *>(ptr) - HEAP_HEADER;
+    size_t size;
+    memcpy(&size, block, sizeof(size));
+    countFree(size);
+    free(block);
+}
+
+void *operator new[](size_t size) { return operator new(size); }
+void operator delete[](void *ptr) noexcept { operator delete(ptr); }
+void operator delete(void *ptr, size_t) noexcept { operator delete(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { operator delete(ptr); }
+#endif
+
+// ---------------------------------------------------------------------------
+// Runner
+// ---------------------------------------------------------------------------
+
+struct BenchResult
+{
+    std::string name;
+    double nsPerOp;
+    double bytesPerOp;
+    double allocsPerOp;
+    long peakBytes; ///< Peak heap above the starting point
+};
+
+static std::vector<BenchResult> benchResults;
+static volatile size_t benchSink; // keeps results observable to the optimizer
+
+template <typename Op>
+static void bench(const char *name, Op op)
+{
+    for (int i = 0; i < JSON_BENCH_WARMUP; i++)
+        op();
+
+    // Heap figures are the same every round; time is the least disturbed round
+    HeapCounters start = heapCounters;
+    heapCounters.peak = heapCounters.live;
+    HeapCounters firstRound;
+    long long bestNs = -1;
+    for (int round = 0; round < JSON_BENCH_ROUNDS; round++)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < JSON_BENCH_OPS; i++)
+            op();
+        auto end = std::chrono::steady_clock::now();
+
+        long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+        if (bestNs < 0 || ns < bestNs)
+            bestNs = ns;
+        if (round == 0)
+            firstRound = heapCounters;
+    }
+
+    BenchResult result;
+    result.name = name;
+    result.nsPerOp = (double)bestNs / JSON_BENCH_OPS;
+    result.bytesPerOp = (double)(firstRound.bytes - start.bytes) / JSON_BENCH_OPS;
+    result.allocsPerOp = (double)(firstRound.allocs - start.allocs) / JSON_BENCH_OPS;
+    result.peakBytes = (long)(firstRound.peak - start.live);
+    benchResults.push_back(result);
+
+    printf("%-22s %10.0f ns/op %9.1f B/op %6.2f allocs/op %7ld B peak\n",
+           name, result.nsPerOp, result.bytesPerOp, result.allocsPerOp, result.peakBytes);
+}
+
+static bool readBaseline(const char *path, std::vector<BenchResult> &baseline)
+{
+    FILE *file = fopen(path, "r");
+    if (!file)
+        return false;
+
+    char line[160];
+    while (fgets(line, sizeof(line), file))
+    {
+        char name[64];
+        BenchResult row;
+        if (sscanf(line, "%63[^,],%lf,%lf,%lf,%ld", name, &row.nsPerOp, &row.bytesPerOp, &row.allocsPerOp,
+                   &row.peakBytes) != 5)
+            continue; // header or malformed
+        row.name = name;
+        baseline.push_back(row);
+    }
+    fclose(file);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Payloads
+// ---------------------------------------------------------------------------
+
+static const char *const USER_IDS[] = {
+    "u-01", "u-02", "u-03", "u-04", "u-05", "u-06", "u-07", "u-08", "u-09", "u-10",
+    "u-11", "u-12", "u-13", "u-14", "u-15", "u-16", "u-17", "u-18", "u-19", "u-20"};
+static const char *const USER_NAMES[] = {
+    "Chuck", "Renee", "Amara", "Jonas", "Priya", "Tomasz", "Lea", "Oskar", "Mei", "Dario",
+    "Ines", "Kofi", "Sanne", "Yusuf", "Greta", "Hugo", "Noor", "Pavel", "Aiko", "Luis"};
+static const uint8_t USER_COUNT = sizeof(USER_IDS) / sizeof(USER_IDS[0]);
+
+static void buildLog(RumpusJsonDocument &doc)
+{
+    doc.set("level", "info");
+    doc.set("source", "coffee-bar");
+    doc.set("message", "Brew cycle finished");
+    doc.set("uptime", 183022);
+    doc.set("heap", 21344);
+}
+
+static void buildPrintJob(RumpusJsonDocument &doc)
+{
+    doc.set("job", 42);
+    doc.set("printer", "kitchen");
+    doc.set("user", "Chuck");
+    doc.set("copies", 1);
+    RumpusJsonDocument *order = doc.getObject("order");
+    order->set("drink", "Cortado");
+    order->set("size", 8);
+    order->set("shots", 2);
+    order->set("milk", "oat");
+    delete order;
+}
+
+static void buildUsers(ArduinoJsonWrapper &doc)
+{
+    JsonArrayView results = doc.array("results");
+    for (uint8_t i = 0; i < USER_COUNT; i++)
+    {
+        JsonObjectView user = results.addObject();
+        user.set("id", USER_IDS[i]);
+        user.set("name", USER_NAMES[i]);
+    }
+    doc.set("count", USER_COUNT);
+}
+
+// device -> sensors -> probe, each level built as its own document
+static void buildTelemetry(ArduinoJsonWrapper &device)
+{
+    ArduinoJsonWrapper probe(ArduinoJsonWrapper::SMALL);
+    probe.set("id", "probe-1");
+    probe.set("celsius", 92);
+
+    ArduinoJsonWrapper sensors(ArduinoJsonWrapper::SMALL);
+    sensors.set("probe", &probe);
+    sensors.set("count", 1);
+
+    device.set("source", "coffee-bar");
+    device.set("sensors", &sensors);
+}
+
+// ---------------------------------------------------------------------------
+// Tests
+// ---------------------------------------------------------------------------
+
+void test_bench_log()
+{
+    bench("log.set", [] {
+        ArduinoJsonWrapper doc;
+        buildLog(doc);
+        benchSink = doc.memoryUsage();
+    });
+
+    ArduinoJsonWrapper doc;
+    buildLog(doc);
+    bench("log.serialize", [&] { benchSink = doc.serialize().length(); });
+}
+
+void test_bench_nested()
+{
+    bench("nested.set", [] {
+        ArduinoJsonWrapper device;
+        buildTelemetry(device);
+        benchSink = device.memoryUsage();
+    });
+
+    ArduinoJsonWrapper doc;
+    bench("nested.getObject", [&] {
+        RumpusJsonDocument *payload = doc.getObject("payload");
+        payload->set("user", "Chuck");
+        payload->set("duration", 120);
+        delete payload;
+    });
+
+    bench("nested.getArray", [] {
+        ArduinoJsonWrapper samples;
+        JsonArrayWrapper *values = static_cast<JsonArrayWrapper *>(samples.getArray("values"));
+        for (int i = 0; i < 8; i++)
+            values->add(900 + i);
+        delete values;
+        benchSink = samples.memoryUsage();
+    });
+}
+
+void test_bench_users()
+{
+    bench("users.build", [] {
+        ArduinoJsonWrapper doc(ArduinoJsonWrapper::LARGE);
+        buildUsers(doc);
+        benchSink = doc.memoryUsage();
+    });
+
+    ArduinoJsonWrapper doc(ArduinoJsonWrapper::LARGE);
+    buildUsers(doc);
+    bench("users.serialize", [&] { benchSink = doc.serialize().length(); });
+}
+
+void test_bench_print_job()
+{
+    bench("printJob.build", [] {
+        ArduinoJsonWrapper doc;
+        buildPrintJob(doc);
+        benchSink = doc.memoryUsage();
+    });
+
+    ArduinoJsonWrapper doc;
+    buildPrintJob(doc);
+    bench("printJob.serialize", [&] { benchSink = doc.serialize().length(); });
+}
+
+void test_bench_write_results()
+{
+    const char *path = getenv("JSON_BENCH_OUT");
+    if (!path)
+        path = "json_bench.csv";
+
+    FILE *file = fopen(path, "w");
+    TEST_ASSERT_NOT_NULL_MESSAGE(file, path);
+    fprintf(file, "name,ns_per_op,bytes_per_op,allocs_per_op,peak_bytes\n");
+    for (const BenchResult &r : benchResults)
+        fprintf(file, "%s,%.1f,%.1f,%.2f,%ld\n", r.name.c_str(), r.nsPerOp, r.bytesPerOp, r.allocsPerOp, r.peakBytes);
+    fclose(file);
+    printf("results written to %s\n", path);
+}
+
+void test_bench_against_baseline()
+{
+    const char *path = getenv("JSON_BENCH_BASELINE");
+    if (!path)
+        TEST_IGNORE_MESSAGE("JSON_BENCH_BASELINE not set");
+
+    std::vector<BenchResult> baseline;
+    TEST_ASSERT_TRUE_MESSAGE(readBaseline(path, baseline), path);
+
+    const char *threshold = getenv("JSON_BENCH_THRESHOLD");
+    double limit = 1.0 + (threshold ? atof(threshold) : 15.0) / 100.0;
+
+    // Heap figures are deterministic, so any growth counts; only time gets the threshold
+    int regressions = 0;
+    for (const BenchResult &base : baseline)
+    {
+        for (const BenchResult &now : benchResults)
+        {
+            if (now.name != base.name)
+                continue;
+            bool slower = now.nsPerOp > base.nsPerOp * limit;
+            bool heavier = now.bytesPerOp > base.bytesPerOp + 0.5 || now.allocsPerOp > base.allocsPerOp + 0.005;
+            bool bigger = now.peakBytes > base.peakBytes;
+            if (slower || heavier || bigger)
+            {
+                printf("REGRESSION %-22s ns %.0f -> %.0f, B/op %.1f -> %.1f, allocs %.2f -> %.2f, peak %ld -> %ld\n",
+                       now.name.c_str(), base.nsPerOp, now.nsPerOp, base.bytesPerOp, now.bytesPerOp,
+                       base.allocsPerOp, now.allocsPerOp, base.peakBytes, now.peakBytes);
+                regressions++;
+            }
+        }
+    }
+    TEST_ASSERT_EQUAL_MESSAGE(0, regressions, "benchmarks regressed against JSON_BENCH_BASELINE");
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_bench_log);
+    RUN_TEST(test_bench_nested);
+    RUN_TEST(test_bench_users);
+    RUN_TEST(test_bench_print_job);
+    RUN_TEST(test_bench_write_results);
+    RUN_TEST(test_bench_against_baseline);
+    return UNITY_END();
+}
@@ -0,0 +1,29 @@
+// Host-side runner: JSON document tests and benchmarks on Linux/macOS.
+// pio test -e JsonDocument_native
+#include <Arduino.h>
+#include <unity.h>
+
+#include "../JsonDocument_unit/test_json_copy.cpp"
+#include "../JsonDocument_unit/test_json_views.cpp"
+#include "../JsonDocument_unit/test_json_stream.cpp"
+#include "../JsonDocument_unit/test_json_pool.cpp"
+#include "../JsonDocument_unit/test_json_codec.cpp"
+#include "../JsonDocument_unit/test_msgpack.cpp"
+#include "../JsonDocument_unit/test_json_typed.cpp"
+#include "../JsonDocument_unit/test_json_selector.cpp"
+#include "../JsonDocument_unit/test_json_merge_patch.cpp"
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    run_json_copy_tests();
+    run_json_view_tests();
+    run_json_stream_tests();
+    run_json_pool_tests();
+    run_json_codec_tests();
+    run_msgpack_tests();
+    run_json_typed_tests();
+    run_json_selector_tests();
+    run_json_merge_patch_tests();
+    return UNITY_END();
+}
@@ -0,0 +1,220 @@
+#include <unity.h>
+#include "JsonCodec.h"
+#include "ArduinoJsonWrapper.h"
+
+// Uses jsonBenchMicros() / JSON_BENCH_ITERATIONS from test_json_copy.cpp
+
+struct CodecUser
+{
+    char id[40];
+    char name[12];
+};
+
+JSON_BINDING(CodecUser,
+             JSON_FIELD(CodecUser, id),
+             JSON_FIELD(CodecUser, name));
+
+struct CodecReading
+{
+    char probe[16];
+    int16_t offset;
+    uint32_t uptime;
+    float celsius;
+    double scale;
+    bool ok;
+};
+
+JSON_BINDING(CodecReading,
+             JSON_FIELD(CodecReading, probe),
+             JSON_FIELD(CodecReading, offset),
+             JSON_FIELD(CodecReading, uptime),
+             JSON_FIELD_KEY(CodecReading, celsius, "c"),
+             JSON_FIELD(CodecReading, scale),
+             JSON_FIELD(CodecReading, ok));
+
+static const char *CODEC_USERS_JSON =
+    "{\"count\":3,\"next\":null,\"meta\":{\"page\":[1,{\"x\":\"]\"}]},"
+    "\"results\":["
+    "{\"id\":\"0c8f2e1a-77d1-4c1e-9b9a-1f2e3d4c5b6a\",\"name\":\"Chuck\",\"roles\":[\"admin\"]},"
+    "{\"name\":\"Ren\\u00e9e \\\"R\\\"\",\"id\":42},"
+    "{\"id\":\"7\",\"name\":\"A very long name indeed\"}"
+    "]}";
+
+void test_json_codec_decodes_array();
+void test_json_codec_typed_fields();
+void test_json_codec_round_trip();
+void test_json_codec_rejects_malformed();
+void test_json_codec_benchmark();
+
+void run_json_codec_tests()
+{
+    RUN_TEST(test_json_codec_decodes_array);
+    RUN_TEST(test_json_codec_typed_fields);
+    RUN_TEST(test_json_codec_round_trip);
+    RUN_TEST(test_json_codec_rejects_malformed);
+    RUN_TEST(test_json_codec_benchmark);
+}
+
+void test_json_codec_decodes_array()
+{
+    CodecUser users[2];
+    TEST_ASSERT_EQUAL(2, JsonCodec<CodecUser>::decodeArray(CODEC_USERS_JSON, "results", users, 2));
+    TEST_ASSERT_EQUAL_STRING("0c8f2e1a-77d1-4c1e-9b9a-1f2e3d4c5b6a", users[0].id);
+    TEST_ASSERT_EQUAL_STRING("Chuck", users[0].name);
+
+    // Escapes decoded, numbers kept as text
+    TEST_ASSERT_EQUAL_STRING("Ren\xC3\xA9" "e \"R\"", users[1].name);
+    TEST_ASSERT_EQUAL_STRING("42", users[1].id);
+
+    // Truncated to the buffer, without a limit on how many are visited
+    int names = 0;
+    TEST_ASSERT_EQUAL(3, JsonCodec<CodecUser>::forEach(CODEC_USERS_JSON, "results", [&](const CodecUser &user) {
+        if (++names == 3)
+            TEST_ASSERT_EQUAL_STRING("A very long", user.name);
+        return true;
+    }));
+
+    TEST_ASSERT_EQUAL(0, JsonCodec<CodecUser>::decodeArray("{\"results\":null}", "results", users, 2));
+    TEST_ASSERT_EQUAL(0, JsonCodec<CodecUser>::decodeArray("{\"other\":[]}", "results", users, 2));
+    TEST_ASSERT_EQUAL(1, JsonCodec<CodecUser>::decodeArray("[1,{\"id\":\"x\"}]", nullptr, users, 2));
+}
+
+void test_json_codec_typed_fields()
+{
+    CodecReading r{};
+    TEST_ASSERT_TRUE(JsonCodec<CodecReading>::decode(
+        "{ \"probe\" : \"p1\", \"offset\": -3, \"uptime\": \"183022\", \"c\": 92.5,"
+        "  \"scale\": 1e3, \"ok\": true, \"unknown\": {\"deep\": [1, 2, {\"ok\": false}]} }",
+        r));
+    TEST_ASSERT_EQUAL_STRING("p1", r.probe);
+    TEST_ASSERT_EQUAL(-3, r.offset);
+    TEST_ASSERT_EQUAL(183022, r.uptime);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 92.5, r.celsius);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 1000.0, r.scale);
+    TEST_ASSERT_TRUE(r.ok);
+
+    // Wrong types leave the field alone, null clears it, missing keys are untouched
+    TEST_ASSERT_TRUE(JsonCodec<CodecReading>::decode("{\"offset\":\"abc\",\"uptime\":-1,\"probe\":null}", r));
+    TEST_ASSERT_EQUAL(-3, r.offset);
+    TEST_ASSERT_EQUAL(183022, r.uptime);
+    TEST_ASSERT_EQUAL_STRING("", r.probe);
+    TEST_ASSERT_TRUE(r.ok);
+
+    // Objects and arrays where a number or bool belongs are skipped too
+    TEST_ASSERT_TRUE(JsonCodec<CodecReading>::decode(
+        "{\"offset\":{\"v\":1},\"uptime\":[1,2],\"c\":{\"x\":[1]},\"scale\":[],\"ok\":{},\"probe\":\"p2\"}", r));
+    TEST_ASSERT_EQUAL(-3, r.offset);
+    TEST_ASSERT_EQUAL(183022, r.uptime);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 92.5, r.celsius);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 1000.0, r.scale);
+    TEST_ASSERT_TRUE(r.ok);
+    TEST_ASSERT_EQUAL_STRING("p2", r.probe);
+}
+
+void test_json_codec_round_trip()
+{
+    CodecReading r{};
+    strcpy(r.probe, "tab\there");
+    r.offset = -12;
+    r.uptime = 4000000000UL;
+    r.celsius = 21.25f;
+    r.scale = 0.5;
+    r.ok = false;
+
+    JsonCapturePrint out;
+    size_t written = JsonCodec<CodecReading>::encode(out, r);
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"probe\":\"tab\\there\",\"offset\":-12,\"uptime\":4000000000,\"c\":21.2500,\"scale\":0.5000,\"ok\":false}",
+        out.text.c_str());
+    TEST_ASSERT_EQUAL(out.text.length(), written);
+    TEST_ASSERT_EQUAL(written, JsonCodec<CodecReading>::measure(r));
+
+    CodecReading back{};
+    TEST_ASSERT_TRUE(JsonCodec<CodecReading>::decode(out.text.c_str(), back));
+    TEST_ASSERT_EQUAL_STRING(r.probe, back.probe);
+    TEST_ASSERT_EQUAL(r.offset, back.offset);
+    TEST_ASSERT_EQUAL(r.uptime, back.uptime);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, r.celsius, back.celsius);
+    TEST_ASSERT_FALSE(back.ok);
+
+    // A full buffer without a terminator is still written safely
+    CodecUser u;
+    memset(u.name, 'x', sizeof(u.name));
+    strcpy(u.id, "1");
+    JsonCapturePrint bounded;
+    JsonCodec<CodecUser>::encode(bounded, u);
+    TEST_ASSERT_EQUAL_STRING("{\"id\":\"1\",\"name\":\"xxxxxxxxxxxx\"}", bounded.text.c_str());
+
+    // Doubles past 32 bits keep their value instead of printing "ovf"
+    r.scale = 2.5e12;
+    JsonCapturePrint large;
+    JsonCodec<CodecReading>::encode(large, r);
+    TEST_ASSERT_TRUE(large.text.indexOf("\"scale\":2.5000e12") > 0);
+    TEST_ASSERT_TRUE(JsonCodec<CodecReading>::decode(large.text.c_str(), back));
+    TEST_ASSERT_TRUE(fabs(back.scale - 2.5e12) < 1.0);
+}
+
+void test_json_codec_rejects_malformed()
+{
+    CodecUser users[2];
+    TEST_ASSERT_EQUAL(-1, JsonCodec<CodecUser>::decodeArray("{\"results\":[{\"id\":\"1\"", "results", users, 2));
+    TEST_ASSERT_EQUAL(-1, JsonCodec<CodecUser>::decodeArray("{\"results\":[{\"id\" \"1\"}]}", "results", users, 2));
+    TEST_ASSERT_EQUAL(-1, JsonCodec<CodecUser>::decodeArray("{\"results\":[{},]}", "results", users, 2));
+    TEST_ASSERT_EQUAL(-1, JsonCodec<CodecUser>::decodeArray("", "results", users, 2));
+
+    // Bare words and numbers must be exact JSON literals
+    CodecReading r{};
+    TEST_ASSERT_FALSE(JsonCodec<CodecReading>::decode("{\"ok\":nope}", r));
+    TEST_ASSERT_FALSE(JsonCodec<CodecReading>::decode("{\"offset\":12abc}", r));
+    TEST_ASSERT_FALSE(JsonCodec<CodecReading>::decode("{\"scale\":1.}", r));
+    TEST_ASSERT_FALSE(JsonCodec<CodecReading>::decode("{\"other\":tru}", r));
+    TEST_ASSERT_FALSE(JsonCodec<CodecReading>::decode("{\"other\":-}", r));
+    TEST_ASSERT_TRUE(JsonCodec<CodecReading>::decode("{\"scale\":-1.5E-3,\"other\":null,\"ok\":false}", r));
+    TEST_ASSERT_TRUE(fabs(r.scale + 0.0015) < 1e-9);
+
+    JsonScanner in("{\"a\":\"bad\\q\"}");
+    TEST_ASSERT_TRUE(in.consume('{'));
+    TEST_ASSERT_FALSE(in.findMember("b"));
+    TEST_ASSERT_TRUE(in.failed());
+    TEST_ASSERT_EQUAL(10, in.offset());
+}
+
+// Codec straight into structs vs. a parsed document copied into Strings
+void test_json_codec_benchmark()
+{
+    struct StringUser
+    {
+        String id;
+        String name;
+    };
+
+    CodecUser users[3];
+    unsigned long start = jsonBenchMicros();
+    for (int i = 0; i < JSON_BENCH_ITERATIONS; i++)
+        JsonCodec<CodecUser>::decodeArray(CODEC_USERS_JSON, "results", users, 3);
+    unsigned long codecUs = jsonBenchMicros() - start;
+
+    StringUser stringUsers[3];
+    start = jsonBenchMicros();
+    for (int i = 0; i < JSON_BENCH_ITERATIONS; i++)
+    {
+        StaticJsonDocument<1024> doc;
+        deserializeJson(doc, CODEC_USERS_JSON);
+        int n = 0;
+        for (JsonObject obj : doc["results"].as<JsonArray>())
+        {
+            stringUsers[n].id = obj["id"].as<String>();
+            stringUsers[n].name = obj["name"].as<String>();
+            n++;
+        }
+    }
+    unsigned long documentUs = jsonBenchMicros() - start;
+
+    String report = "flat decode x" + String(JSON_BENCH_ITERATIONS) +
+                    " codec=" + String(codecUs) + "us" +
+                    " document=" + String(documentUs) + "us";
+    TEST_MESSAGE(report.c_str());
+
+    TEST_ASSERT_EQUAL_STRING(stringUsers[0].name.c_str(), users[0].name);
+    TEST_ASSERT_TRUE(codecUs <= documentUs);
+}
@@ -0,0 +1,192 @@
+#include <unity.h>
+#include "ArduinoJsonWrapper.h"
+#include "JsonArrayWrapper.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <chrono>
+static unsigned long jsonBenchMicros()
+{
+    using namespace std::chrono;
+    return (unsigned long)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+#else
+static unsigned long jsonBenchMicros() { return micros(); }
+#endif
+
+#ifndef JSON_BENCH_ITERATIONS
+#define JSON_BENCH_ITERATIONS 500
+#endif
+
+// Four-level telemetry payload: device -> sensors -> probe -> calibration
+static void buildTelemetry(ArduinoJsonWrapper &device)
+{
+    ArduinoJsonWrapper calibration(ArduinoJsonWrapper::SMALL);
+    calibration.set("offset", -3);
+    calibration.set("scale", 1000);
+    calibration.set("date", "2025-03-14");
+
+    ArduinoJsonWrapper probe(ArduinoJsonWrapper::SMALL);
+    probe.set("id", "probe-1");
+    probe.set("celsius", 92);
+    probe.set("calibration", &calibration);
+
+    ArduinoJsonWrapper sensors;
+    sensors.set("probe", &probe);
+    sensors.set("count", 1);
+
+    device.set("source", "coffee-bar");
+    device.set("uptime", 183022);
+    device.set("sensors", &sensors);
+}
+
+static const char *const TELEMETRY_JSON =
+    "{\"source\":\"coffee-bar\",\"uptime\":183022,\"sensors\":{\"probe\":{\"id\":\"probe-1\",\"celsius\":92,"
+    "\"calibration\":{\"offset\":-3,\"scale\":1000,\"date\":\"2025-03-14\"}},\"count\":1}}";
+
+// Another backend: only its text form is readable
+class TextOnlyDocument : public RumpusJsonDocument
+{
+public:
+    explicit TextOnlyDocument(const String &text) : _text(text) {}
+
+    bool set(const char *, const char *) override { return false; }
+    bool set(const char *, int) override { return false; }
+    bool set(const char *, bool) override { return false; }
+    bool set(const char *, float) override { return false; }
+    bool set(const char *, double) override { return false; }
+    bool set(const char *, int64_t) override { return false; }
+    bool set(const char *, uint32_t) override { return false; }
+    bool set(const char *, RumpusJsonDocument *) override { return false; }
+    bool getBool(const char *, bool fallback) const override { return fallback; }
+    int64_t getInt64(const char *, int64_t fallback) const override { return fallback; }
+    double getDouble(const char *, double fallback) const override { return fallback; }
+    String getString(const char *, const String &fallback) const override { return fallback; }
+    RumpusJsonDocument *getObject(const char *) override { return nullptr; }
+    RumpusJsonDocument *getArray(const char *) override { return nullptr; }
+    String serialize() override { return _text; }
+    void clear() override { _text = ""; }
+
+private:
+    String _text;
+};
+
+void test_json_set_nested_copies_tree();
+void test_json_set_grows_small_parent();
+void test_json_set_array();
+void test_json_set_foreign_document();
+void test_json_set_reports_full_document();
+void test_json_nested_copy_benchmark();
+
+void run_json_copy_tests()
+{
+    RUN_TEST(test_json_set_nested_copies_tree);
+    RUN_TEST(test_json_set_grows_small_parent);
+    RUN_TEST(test_json_set_array);
+    RUN_TEST(test_json_set_foreign_document);
+    RUN_TEST(test_json_set_reports_full_document);
+    RUN_TEST(test_json_nested_copy_benchmark);
+}
+
+void test_json_set_nested_copies_tree()
+{
+    ArduinoJsonWrapper device;
+    buildTelemetry(device);
+    TEST_ASSERT_EQUAL_STRING(TELEMETRY_JSON, device.serialize().c_str());
+}
+
+void test_json_set_grows_small_parent()
+{
+    static const char *const keys[] = {"k0", "k1", "k2", "k3", "k4", "k5", "k6", "k7", "k8", "k9", "k10", "k11"};
+    ArduinoJsonWrapper child(ArduinoJsonWrapper::LARGE);
+    for (int i = 0; i < 12; i++)
+        child.set(keys[i], i);
+
+    ArduinoJsonWrapper parent(ArduinoJsonWrapper::SMALL);
+    parent.set("child", &child);
+    TEST_ASSERT_TRUE(parent.capacity() >= parent.memoryUsage());
+    TEST_ASSERT_EQUAL_STRING(("{\"child\":" + child.serialize() + "}").c_str(), parent.serialize().c_str());
+}
+
+void test_json_set_array()
+{
+    ArduinoJsonWrapper source;
+    JsonArrayWrapper *values = static_cast<JsonArrayWrapper *>(source.getArray("values"));
+    values->add(1);
+    values->add("two");
+
+    ArduinoJsonWrapper target;
+    target.set("values", values);
+    delete values;
+    TEST_ASSERT_EQUAL_STRING("{\"values\":[1,\"two\"]}", target.serialize().c_str());
+}
+
+void test_json_set_foreign_document()
+{
+    TextOnlyDocument foreign("{\"id\":\"probe-1\",\"celsius\":92}");
+    ArduinoJsonWrapper target(ArduinoJsonWrapper::SMALL);
+    target.set("probe", &foreign);
+    TEST_ASSERT_EQUAL_STRING("{\"probe\":{\"id\":\"probe-1\",\"celsius\":92}}", target.serialize().c_str());
+
+    // Text needing more than JSON_PARSE_FOREIGN_MAX is not copied, rather
+    // than growing the scratch pool without bound
+    String huge = "[\"";
+    while (huge.length() < JSON_PARSE_FOREIGN_MAX)
+        huge += "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx";
+    huge += "\"]";
+    TextOnlyDocument oversized(huge);
+    TEST_ASSERT_TRUE(ArduinoJsonBacked::parseForeign(oversized).isNull());
+    TEST_ASSERT_FALSE(target.set("log", &oversized));
+    TEST_ASSERT_EQUAL_STRING("{\"probe\":{\"id\":\"probe-1\",\"celsius\":92}}", target.serialize().c_str());
+}
+
+// Once the largest size class is full, set() says so and keeps what is stored
+void test_json_set_reports_full_document()
+{
+    const char *value = "0123456789012345678901234567890123456789";
+    ArduinoJsonWrapper doc(ArduinoJsonWrapper::SMALL);
+
+    int stored = 0;
+    while (stored < 1000 && doc.set(("k" + String(stored)).c_str(), value))
+        stored++;
+
+    TEST_ASSERT_TRUE(stored > 10);
+    TEST_ASSERT_TRUE(stored < 1000);
+    TEST_ASSERT_EQUAL(JsonDocumentPool::classSize(JsonDocumentPool::CLASS_COUNT - 1), doc.capacity());
+    TEST_ASSERT_EQUAL_STRING(value, doc.getString("k0", "").c_str());
+    TEST_ASSERT_EQUAL_STRING(value, doc.getString(("k" + String(stored - 1)).c_str(), "").c_str());
+}
+
+// Direct copy vs. the old serialize -> parse -> copy path
+void test_json_nested_copy_benchmark()
+{
+    ArduinoJsonWrapper payload;
+    buildTelemetry(payload);
+    JsonVariantConst sensors = payload.variant()["sensors"];
+
+    unsigned long start = jsonBenchMicros();
+    for (int i = 0; i < JSON_BENCH_ITERATIONS; i++)
+    {
+        DynamicJsonDocument parent(512);
+        parent["sensors"].set(sensors);
+    }
+    unsigned long directUs = jsonBenchMicros() - start;
+
+    start = jsonBenchMicros();
+    for (int i = 0; i < JSON_BENCH_ITERATIONS; i++)
+    {
+        String text;
+        serializeJson(sensors, text);
+        DynamicJsonDocument temp(text.length() * 2 + JSON_OBJECT_SIZE(1));
+        deserializeJson(temp, text);
+        DynamicJsonDocument parent(512);
+        parent["sensors"].set(temp.as<JsonVariantConst>());
+    }
+    unsigned long textUs = jsonBenchMicros() - start;
+
+    String report = "nested copy x" + String(JSON_BENCH_ITERATIONS) +
+                    " direct=" + String(directUs) + "us" +
+                    " textRoundTrip=" + String(textUs) + "us";
+    TEST_MESSAGE(report.c_str());
+
+    TEST_ASSERT_TRUE(directUs <= textUs);
+}
@@ -0,0 +1,199 @@
+#include <unity.h>
+#include "JsonMergePatch.h"
+#include "JsonDeltaTracker.h"
+#include "ArduinoJsonWrapper.h"
+
+// Apply patch text to target text and return the result as text
+static String mergePatchText(const char *target, const char *patch)
+{
+    DynamicJsonDocument doc(512);
+    DynamicJsonDocument diff(512);
+    deserializeJson(doc, target);
+    deserializeJson(diff, patch);
+    JsonMergePatch::apply(doc.as<JsonVariant>(), diff.as<JsonVariantConst>());
+    String out;
+    serializeJson(doc, out);
+    return out;
+}
+
+// Device status as uploaded every cycle
+static void fillStatus(RumpusJsonDocument &status, uint32_t uptime, bool brewing)
+{
+    status.set("device", "brewer-02");
+    status.set("firmware", "1.8.3");
+    status.set("uptime", uptime);
+    status.set("brewing", brewing);
+    status.set("boilerC", 93.5f);
+    status.set("waterLevel", 74);
+    status.set("beansLevel", 51);
+    status.set("cupsToday", 12);
+    RumpusJsonDocument *wifi = status.getObject("wifi");
+    wifi->set("ssid", "rumpus-office");
+    wifi->set("rssi", -61);
+    wifi->set("ip", "10.0.4.27");
+    delete wifi;
+    RumpusJsonDocument *errors = status.getObject("errors");
+    errors->set("lastCode", 0);
+    errors->set("count", 0);
+    delete errors;
+}
+
+void test_json_merge_patch_apply();
+void test_json_merge_patch_diff_round_trip();
+void test_json_merge_patch_documents();
+void test_json_delta_tracker_cycle();
+void test_json_delta_tracker_bytes();
+
+void run_json_merge_patch_tests()
+{
+    RUN_TEST(test_json_merge_patch_apply);
+    RUN_TEST(test_json_merge_patch_diff_round_trip);
+    RUN_TEST(test_json_merge_patch_documents);
+    RUN_TEST(test_json_delta_tracker_cycle);
+    RUN_TEST(test_json_delta_tracker_bytes);
+}
+
+// Examples from RFC 7386, appendix A
+void test_json_merge_patch_apply()
+{
+    TEST_ASSERT_EQUAL_STRING("{\"a\":\"c\"}", mergePatchText("{\"a\":\"b\"}", "{\"a\":\"c\"}").c_str());
+    TEST_ASSERT_EQUAL_STRING("{\"a\":\"b\",\"b\":\"c\"}", mergePatchText("{\"a\":\"b\"}", "{\"b\":\"c\"}").c_str());
+    TEST_ASSERT_EQUAL_STRING("{}", mergePatchText("{\"a\":\"b\"}", "{\"a\":null}").c_str());
+    TEST_ASSERT_EQUAL_STRING("{\"b\":\"c\"}", mergePatchText("{\"a\":\"b\",\"b\":\"c\"}", "{\"a\":null}").c_str());
+    TEST_ASSERT_EQUAL_STRING("{\"a\":\"c\"}", mergePatchText("{\"a\":[\"b\"]}", "{\"a\":\"c\"}").c_str());
+    TEST_ASSERT_EQUAL_STRING("{\"a\":[\"b\"]}", mergePatchText("{\"a\":\"c\"}", "{\"a\":[\"b\"]}").c_str());
+    TEST_ASSERT_EQUAL_STRING("{\"a\":{\"b\":\"d\"}}",
+                             mergePatchText("{\"a\":{\"b\":\"c\"}}", "{\"a\":{\"b\":\"d\",\"c\":null}}").c_str());
+    TEST_ASSERT_EQUAL_STRING("{\"a\":[1]}", mergePatchText("{\"a\":[{\"b\":\"c\"}]}", "{\"a\":[1]}").c_str());
+    TEST_ASSERT_EQUAL_STRING("[\"c\",\"d\"]", mergePatchText("[\"a\",\"b\"]", "[\"c\",\"d\"]").c_str());
+    TEST_ASSERT_EQUAL_STRING("[\"c\"]", mergePatchText("{\"a\":\"b\"}", "[\"c\"]").c_str());
+    TEST_ASSERT_EQUAL_STRING("{\"e\":null,\"a\":1}", mergePatchText("{\"e\":null}", "{\"a\":1}").c_str());
+    TEST_ASSERT_EQUAL_STRING("{\"a\":{\"bb\":{}}}", mergePatchText("[1,2]", "{\"a\":{\"bb\":{\"ccc\":null}}}").c_str());
+}
+
+void test_json_merge_patch_diff_round_trip()
+{
+    DynamicJsonDocument from(512);
+    DynamicJsonDocument to(512);
+    DynamicJsonDocument patch(512);
+    deserializeJson(from, "{\"a\":1,\"b\":{\"c\":true,\"d\":[1,2],\"e\":\"x\"},\"gone\":\"y\",\"n\":null}");
+    deserializeJson(to, "{\"a\":1.0,\"b\":{\"c\":true,\"d\":[1,3],\"e\":\"x\"},\"new\":{\"k\":2},\"n\":null}");
+
+    TEST_ASSERT_TRUE(JsonMergePatch::diff(from, to, patch.as<JsonVariant>()));
+    String text;
+    serializeJson(patch, text);
+    TEST_ASSERT_EQUAL_STRING("{\"gone\":null,\"b\":{\"d\":[1,3]},\"new\":{\"k\":2}}", text.c_str());
+
+    JsonMergePatch::apply(from.as<JsonVariant>(), patch.as<JsonVariantConst>());
+    TEST_ASSERT_TRUE(JsonMergePatch::equal(from, to));
+
+    // Equal documents give an empty patch
+    TEST_ASSERT_FALSE(JsonMergePatch::diff(from, to, patch.as<JsonVariant>()));
+    TEST_ASSERT_EQUAL(0, patch.size());
+
+    TEST_ASSERT_FALSE(JsonMergePatch::equal(from["a"], from["b"]));
+    TEST_ASSERT_FALSE(JsonMergePatch::equal(to["b"]["d"], from["new"]));
+}
+
+void test_json_merge_patch_documents()
+{
+    ArduinoJsonWrapper before(ArduinoJsonWrapper::SMALL);
+    ArduinoJsonWrapper after(ArduinoJsonWrapper::SMALL);
+    fillStatus(before, 100, false);
+    fillStatus(after, 160, true);
+    after.set("firmware", "1.9.0");
+
+    RumpusJsonDocument *patch = new ArduinoJsonWrapper(ArduinoJsonWrapper::SMALL);
+    TEST_ASSERT_TRUE(patch->diff(&before, &after));
+    TEST_ASSERT_EQUAL_STRING("{\"firmware\":\"1.9.0\",\"uptime\":160,\"brewing\":true}", patch->serialize().c_str());
+
+    // The receiver's copy catches up; SMALL documents grow to fit
+    ArduinoJsonWrapper receiver(ArduinoJsonWrapper::SMALL);
+    TEST_ASSERT_TRUE(receiver.mergePatch(&before));
+    TEST_ASSERT_TRUE(receiver.mergePatch(patch));
+    TEST_ASSERT_EQUAL_STRING(after.serialize().c_str(), receiver.serialize().c_str());
+    delete patch;
+
+    TEST_ASSERT_FALSE(receiver.mergePatch(&receiver));
+    TEST_ASSERT_FALSE(receiver.mergePatch(nullptr));
+}
+
+void test_json_delta_tracker_cycle()
+{
+    JsonDeltaTracker delta(4);
+    ArduinoJsonWrapper status(ArduinoJsonWrapper::LARGE);
+    fillStatus(status, 10, false);
+
+    TEST_ASSERT_EQUAL(JsonDeltaTracker::FULL, delta.prepare(status));
+    TEST_ASSERT_EQUAL_STRING(status.serialize().c_str(), delta.body().serialize().c_str());
+
+    // Not acknowledged: still full, since the receiver may have nothing
+    TEST_ASSERT_EQUAL(JsonDeltaTracker::FULL, delta.prepare(status));
+    delta.acknowledge();
+    TEST_ASSERT_EQUAL(JsonDeltaTracker::UNCHANGED, delta.prepare(status));
+
+    status.set("uptime", 20);
+    TEST_ASSERT_EQUAL(JsonDeltaTracker::PATCH, delta.prepare(status));
+    TEST_ASSERT_EQUAL_STRING("{\"uptime\":20}", delta.body().serialize().c_str());
+
+    // A lost patch is folded into the next one
+    RumpusJsonDocument *wifi = status.getObject("wifi");
+    wifi->set("rssi", -70);
+    delete wifi;
+    TEST_ASSERT_EQUAL(JsonDeltaTracker::PATCH, delta.prepare(status));
+    TEST_ASSERT_EQUAL_STRING("{\"uptime\":20,\"wifi\":{\"rssi\":-70}}", delta.body().serialize().c_str());
+
+    // 4th cycle since the last full snapshot
+    TEST_ASSERT_EQUAL(JsonDeltaTracker::FULL, delta.prepare(status));
+    TEST_ASSERT_EQUAL_STRING("full", JsonDeltaTracker::kindName(JsonDeltaTracker::FULL));
+    delta.acknowledge();
+
+    status.set("uptime", 30);
+    wifi = status.getObject("wifi");
+    wifi->set("rssi", -72);
+    delete wifi;
+    TEST_ASSERT_EQUAL(JsonDeltaTracker::PATCH, delta.prepare(status));
+    TEST_ASSERT_EQUAL_STRING("{\"uptime\":30,\"wifi\":{\"rssi\":-72}}", delta.body().serialize().c_str());
+    delta.acknowledge();
+
+    delta.reset();
+    TEST_ASSERT_EQUAL(JsonDeltaTracker::FULL, delta.prepare(status));
+}
+
+// A mostly idle device: only uptime moves, plus an occasional brew
+void test_json_delta_tracker_bytes()
+{
+    const uint16_t CYCLES = 120;
+    const uint16_t FULL_EVERY = 60; // one hour of minute-by-minute uploads
+    JsonDeltaTracker delta(FULL_EVERY);
+    ArduinoJsonWrapper status(ArduinoJsonWrapper::LARGE);
+    ArduinoJsonWrapper receiver(ArduinoJsonWrapper::LARGE);
+
+    size_t fullBytes = 0;
+    size_t deltaBytes = 0;
+    uint16_t fulls = 0;
+    for (uint16_t cycle = 0; cycle < CYCLES; cycle++)
+    {
+        fillStatus(status, 60UL * cycle, cycle % 40 == 7);
+        fullBytes += status.measure();
+
+        JsonDeltaTracker::Kind kind = delta.prepare(status);
+        if (kind == JsonDeltaTracker::UNCHANGED)
+            continue;
+        deltaBytes += delta.body().measure();
+        if (kind == JsonDeltaTracker::FULL)
+        {
+            fulls++;
+            receiver.clear();
+        }
+        receiver.mergePatch(&delta.body());
+        delta.acknowledge();
+        TEST_ASSERT_EQUAL_STRING(status.serialize().c_str(), receiver.serialize().c_str());
+    }
+
+    String report = "status x" + String(CYCLES) + " full=" + String((unsigned long)fullBytes) +
+                    "B delta=" + String((unsigned long)deltaBytes) + "B (" + String(fulls) + " full snapshots)";
+    TEST_MESSAGE(report.c_str());
+    TEST_ASSERT_EQUAL(CYCLES / FULL_EVERY, fulls);
+    TEST_ASSERT_TRUE(deltaBytes * 10 <= fullBytes);
+}
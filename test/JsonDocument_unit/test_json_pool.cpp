@@ -0,0 +1,98 @@
+#include <unity.h>
+#include "JsonDocumentPool.h"
+#include "ArduinoJsonWrapper.h"
+
+void test_json_pool_reuses_documents();
+void test_json_pool_grow_and_stats();
+void test_json_wrapper_grows_on_overflow();
+void test_json_pooled_wrapper_returns_document();
+
+void run_json_pool_tests()
+{
+    RUN_TEST(test_json_pool_reuses_documents);
+    RUN_TEST(test_json_pool_grow_and_stats);
+    RUN_TEST(test_json_wrapper_grows_on_overflow);
+    RUN_TEST(test_json_pooled_wrapper_returns_document);
+}
+
+void test_json_pool_reuses_documents()
+{
+    JsonDocumentPool pool;
+    pool.reserve(200, 1);
+    TEST_ASSERT_EQUAL(1, pool.stats(1).allocations);
+
+    DynamicJsonDocument *first = pool.acquire(200);
+    TEST_ASSERT_EQUAL(256, first->capacity());
+    (*first)["level"] = "info";
+    pool.release(first);
+
+    // Same class, same document, and it comes back empty
+    DynamicJsonDocument *second = pool.acquire(256);
+    TEST_ASSERT_EQUAL_PTR(first, second);
+    TEST_ASSERT_TRUE(second->isNull());
+    pool.release(second);
+
+    TEST_ASSERT_EQUAL(1, pool.stats(1).allocations);
+    TEST_ASSERT_EQUAL(2, pool.stats(1).acquisitions);
+    TEST_ASSERT_EQUAL(1, pool.stats(1).peakInUse);
+    TEST_ASSERT_TRUE(pool.stats(1).peakUsage > 0);
+}
+
+void test_json_pool_grow_and_stats()
+{
+    JsonDocumentPool pool;
+    {
+        JsonDocumentPool::Lease a = pool.lease(100);
+        JsonDocumentPool::Lease b = pool.lease(100);
+        (*a)["message"] = "hello";
+        TEST_ASSERT_TRUE(a.grow());
+        TEST_ASSERT_EQUAL(256, a->capacity());
+        TEST_ASSERT_EQUAL_STRING("hello", (*a)["message"].as<const char *>());
+    }
+
+    TEST_ASSERT_EQUAL(2, pool.stats(0).peakInUse);
+    TEST_ASSERT_EQUAL(1, pool.stats(0).overflows);
+    TEST_ASSERT_EQUAL(0, pool.stats(0).inUse);
+    TEST_ASSERT_EQUAL(0, pool.stats(1).inUse);
+
+    DynamicJsonDocument *huge = pool.acquire(4096);
+    TEST_ASSERT_EQUAL(4096, huge->capacity());
+    pool.release(huge);
+    TEST_ASSERT_EQUAL(1, pool.oversizeAcquisitions());
+
+    // A document resized by the caller is freed, but still counts as returned
+    DynamicJsonDocument *shrunk = pool.acquire(100);
+    (*shrunk)["n"] = 1;
+    shrunk->shrinkToFit();
+    TEST_ASSERT_EQUAL(1, pool.stats(0).inUse);
+    pool.release(shrunk);
+    TEST_ASSERT_EQUAL(0, pool.stats(0).inUse);
+}
+
+void test_json_wrapper_grows_on_overflow()
+{
+    static const char *const keys[] = {"a", "b", "c", "d", "e", "f", "g", "h", "i", "j"};
+    ArduinoJsonWrapper doc(ArduinoJsonWrapper::SMALL);
+    for (int i = 0; i < 10; i++)
+        doc.set(keys[i], "a value long enough to need more than 128 bytes");
+
+    TEST_ASSERT_TRUE(doc.capacity() > 128);
+    TEST_ASSERT_EQUAL(10, doc.root().size());
+    TEST_ASSERT_EQUAL_STRING("a value long enough to need more than 128 bytes",
+                             doc.root().get("j").as<const char *>());
+}
+
+void test_json_pooled_wrapper_returns_document()
+{
+    JsonDocumentPool pool;
+    for (int message = 0; message < 3; message++)
+    {
+        ArduinoJsonWrapper log(pool, 128);
+        log.set("level", "info");
+        log.set("n", message);
+    }
+
+    TEST_ASSERT_EQUAL(1, pool.stats(0).allocations);
+    TEST_ASSERT_EQUAL(3, pool.stats(0).acquisitions);
+    TEST_ASSERT_EQUAL(0, pool.stats(0).inUse);
+}
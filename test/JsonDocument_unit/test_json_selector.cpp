@@ -0,0 +1,168 @@
+#include <unity.h>
+#include "JsonSelector.h"
+#include "ArduinoJsonWrapper.h"
+
+// Uses jsonBenchMicros() / JSON_BENCH_ITERATIONS from test_json_copy.cpp
+
+static const char *SELECTOR_JSON =
+    "{\"count\":3,\"meta\":{\"page\":2,\"tags\":[\"a\",\"b\"]},"
+    "\"results\":["
+    "{\"id\":\"u1\",\"name\":\"Chuck\",\"roles\":[{\"name\":\"admin\"}]},"
+    "{\"name\":\"Ren\\u00e9e\",\"id\":42,\"extra\":{\"name\":\"nested\"}},"
+    "{\"id\":null}"
+    "]}";
+
+void test_json_selector_compiles_paths();
+void test_json_selector_extracts_fields();
+void test_json_selector_wildcards_and_indices();
+void test_json_selector_stop_and_errors();
+void test_json_selector_large_list();
+
+void run_json_selector_tests()
+{
+    RUN_TEST(test_json_selector_compiles_paths);
+    RUN_TEST(test_json_selector_extracts_fields);
+    RUN_TEST(test_json_selector_wildcards_and_indices);
+    RUN_TEST(test_json_selector_stop_and_errors);
+    RUN_TEST(test_json_selector_large_list);
+}
+
+void test_json_selector_compiles_paths()
+{
+    JsonSelector sel;
+    TEST_ASSERT_TRUE(sel.add("results[*].name"));
+    TEST_ASSERT_TRUE(sel.add("$.meta.tags[1]"));
+    TEST_ASSERT_TRUE(sel.add("[0].*"));
+    TEST_ASSERT_EQUAL(3, sel.count());
+
+    JsonSelector bad;
+    TEST_ASSERT_FALSE(bad.add(""));
+    TEST_ASSERT_FALSE(bad.add("a..b"));
+    TEST_ASSERT_FALSE(bad.add("a."));
+    TEST_ASSERT_FALSE(bad.add("a[x]"));
+    TEST_ASSERT_FALSE(bad.add("a[-1]"));
+    TEST_ASSERT_FALSE(bad.add("a[0]b"));
+    TEST_ASSERT_FALSE(bad.add("a.b.c.d.e.f.g"));
+    TEST_ASSERT_EQUAL(0, bad.count());
+}
+
+void test_json_selector_extracts_fields()
+{
+    struct
+    {
+        char id[8];
+        char name[8];
+    } users[3] = {};
+
+    JsonSelector sel;
+    sel.add("results[*].id");
+    sel.add("results[*].name");
+    int matches = sel.run(SELECTOR_JSON, [&](const JsonMatch &m) {
+        if (m.index() < 3)
+            m.text(m.path == 0 ? users[m.index()].id : users[m.index()].name, 8);
+        return true;
+    });
+
+    // Only direct members match, not roles[].name or extra.name
+    TEST_ASSERT_EQUAL(5, matches);
+    TEST_ASSERT_EQUAL_STRING("u1", users[0].id);
+    TEST_ASSERT_EQUAL_STRING("Chuck", users[0].name);
+    TEST_ASSERT_EQUAL_STRING("42", users[1].id);
+    TEST_ASSERT_EQUAL_STRING("Ren\xC3\xA9" "e", users[1].name);
+    TEST_ASSERT_EQUAL_STRING("", users[2].id);
+}
+
+void test_json_selector_wildcards_and_indices()
+{
+    JsonSelector sel;
+    sel.add("meta.*");
+    sel.add("results[1].extra");
+    sel.add("meta.page");
+
+    String seen;
+    long page = 0;
+    sel.run(SELECTOR_JSON, [&](const JsonMatch &m) {
+        seen += String(m.path) + "=" + String(m.raw).substring(0, m.length) + ";";
+        if (m.path == 2)
+            m.toLong(page);
+        return true;
+    });
+    TEST_ASSERT_EQUAL(2, page);
+    TEST_ASSERT_EQUAL_STRING("0=2;2=2;0=[\"a\",\"b\"];1={\"name\":\"nested\"};", seen.c_str());
+
+    // Nested wildcards report every array index on the path
+    JsonSelector roles("results[*].roles[*].name");
+    uint16_t outer = 99;
+    uint8_t depth = 0;
+    TEST_ASSERT_EQUAL(1, roles.run(SELECTOR_JSON, [&](const JsonMatch &m) {
+        outer = m.indices[0];
+        depth = m.indexCount;
+        return m.isString();
+    }));
+    TEST_ASSERT_EQUAL(0, outer);
+    TEST_ASSERT_EQUAL(2, depth);
+}
+
+void test_json_selector_stop_and_errors()
+{
+    JsonSelector names("results[*].name");
+    int calls = 0;
+    TEST_ASSERT_EQUAL(1, names.run(SELECTOR_JSON, [&](const JsonMatch &) {
+        calls++;
+        return false;
+    }));
+    TEST_ASSERT_EQUAL(1, calls);
+
+    auto ignore = [](const JsonMatch &) { return true; };
+    size_t at = 0;
+    TEST_ASSERT_EQUAL(-1, names.run("{\"results\":[{\"name\":\"x\"}", ignore, &at));
+    TEST_ASSERT_EQUAL(24, at); // ran out of text
+    TEST_ASSERT_EQUAL(-1, names.run("{\"results\":[{\"name\" 1}]}", ignore, &at));
+    TEST_ASSERT_EQUAL(20, at);
+    TEST_ASSERT_EQUAL(0, names.run("{\"results\":{\"name\":\"x\"}}", ignore));
+    TEST_ASSERT_EQUAL(0, names.run("[]", ignore));
+}
+
+// A long list: selector pass vs. deserializing the whole document
+void test_json_selector_large_list()
+{
+    const int ITEMS = 200;
+    String json = "{\"results\":[";
+    for (int i = 0; i < ITEMS; i++)
+    {
+        if (i)
+            json += ",";
+        json += "{\"id\":" + String(i) + ",\"name\":\"coffee-" + String(i) +
+                "\",\"origin\":{\"country\":\"Ethiopia\",\"altitude\":2100},\"notes\":[\"citrus\",\"floral\"]}";
+    }
+    json += "]}";
+
+    JsonSelector names("results[*].name");
+    size_t longest = 0;
+    unsigned long start = jsonBenchMicros();
+    int found = 0;
+    for (int i = 0; i < JSON_BENCH_ITERATIONS / 50 + 1; i++)
+        found = names.run(json.c_str(), [&](const JsonMatch &m) {
+            if (m.length > longest)
+                longest = m.length;
+            return true;
+        });
+    unsigned long selectorUs = jsonBenchMicros() - start;
+    TEST_ASSERT_EQUAL(ITEMS, found);
+
+    size_t domBytes = 0;
+    start = jsonBenchMicros();
+    for (int i = 0; i < JSON_BENCH_ITERATIONS / 50 + 1; i++)
+    {
+        DynamicJsonDocument doc(json.length() * 2);
+        deserializeJson(doc, json);
+        domBytes = doc.memoryUsage();
+    }
+    unsigned long documentUs = jsonBenchMicros() - start;
+
+    String report = "select " + String(ITEMS) + " names from " + String(json.length()) + "B:" +
+                    " selector=" + String(selectorUs) + "us/" + String((unsigned long)sizeof(JsonSelector)) + "B" +
+                    " document=" + String(documentUs) + "us/" + String((unsigned long)domBytes) + "B";
+    TEST_MESSAGE(report.c_str());
+    TEST_ASSERT_TRUE(longest <= 16);
+}
@@ -0,0 +1,95 @@
+#include <unity.h>
+#include "JsonStreamWriter.h"
+#include "ArduinoJsonWrapper.h"
+
+// Print that captures output into a String
+class JsonCapturePrint : public Print
+{
+public:
+    String text;
+    size_t write(uint8_t c) override
+    {
+        text += (char)c;
+        return 1;
+    }
+};
+
+static void writeTelemetry(Print &out)
+{
+    JsonStreamWriter json(out);
+    json.beginObject();
+    json.member("source", "coffee-bar");
+    json.member("uptime", 183022L);
+    json.key("ok").value(true);
+    json.key("note").value("line1\n\"quoted\"");
+    json.key("readings").beginArray();
+    json.beginObject().member("celsius", 92).member("probe", "p1").endObject();
+    json.beginObject().endObject();
+    json.beginArray().endArray();
+    json.nullValue();
+    json.endArray();
+    json.endObject();
+}
+
+void test_json_stream_writer_output();
+void test_json_stream_writer_measure();
+void test_json_document_measure();
+void test_json_stream_writer_numbers();
+
+void run_json_stream_tests()
+{
+    RUN_TEST(test_json_stream_writer_output);
+    RUN_TEST(test_json_stream_writer_measure);
+    RUN_TEST(test_json_document_measure);
+    RUN_TEST(test_json_stream_writer_numbers);
+}
+
+void test_json_stream_writer_output()
+{
+    JsonCapturePrint out;
+    writeTelemetry(out);
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"source\":\"coffee-bar\",\"uptime\":183022,\"ok\":true,\"note\":\"line1\\n\\\"quoted\\\"\","
+        "\"readings\":[{\"celsius\":92,\"probe\":\"p1\"},{},[],null]}",
+        out.text.c_str());
+}
+
+void test_json_stream_writer_measure()
+{
+    JsonCapturePrint out;
+    writeTelemetry(out);
+    TEST_ASSERT_EQUAL(out.text.length(), JsonStreamWriter::measure(writeTelemetry));
+}
+
+void test_json_document_measure()
+{
+    ArduinoJsonWrapper doc;
+    doc.set("user", "Chuck");
+    doc.array("values").add(120);
+
+    JsonCapturePrint out;
+    size_t written = doc.serializeTo(out);
+    TEST_ASSERT_EQUAL_STRING(doc.serialize().c_str(), out.text.c_str());
+    TEST_ASSERT_EQUAL(written, doc.measure());
+}
+
+// Values Print alone gets wrong: 64-bit integers and doubles past 32 bits
+void test_json_stream_writer_numbers()
+{
+    JsonCapturePrint out;
+    JsonStreamWriter json(out);
+    json.beginArray();
+    json.value((int64_t)9007199254740993LL).value((int64_t)INT64_MIN).value((uint64_t)UINT64_MAX);
+    json.value(12.5).value(-0.75, 1).value(0.0).value(1.5e12).value(-4294967296.0, 0).value(0.004);
+    json.value(9.999e20).value(1e-310, 1).value(NAN).value(-INFINITY);
+    json.endArray();
+    TEST_ASSERT_EQUAL_STRING("[9007199254740993,-9223372036854775808,18446744073709551615,"
+                             "12.50,-0.8,0.00,1.50e12,-4e9,4.00e-3,1.00e21,1.0e-310,null,null]",
+                             out.text.c_str());
+    TEST_ASSERT_EQUAL(out.text.length(), json.bytesWritten());
+
+    // The output parses back
+    DynamicJsonDocument doc(512);
+    TEST_ASSERT_FALSE(deserializeJson(doc, out.text));
+    TEST_ASSERT_EQUAL(13, doc.size());
+}
@@ -0,0 +1,101 @@
+#include <unity.h>
+#include "ArduinoJsonWrapper.h"
+#include "JsonArrayWrapper.h"
+
+// Fills a document through the abstract interface only
+static void fillReading(RumpusJsonDocument &doc)
+{
+    doc.set("celsius", 92.5f);
+    doc.set("volume", 0.355);
+    doc.set("full", true);
+    doc.set("timestamp", (int64_t)1717171717123LL);
+    doc.set("uptime", (uint32_t)4000000000UL);
+    doc.set("probe", "p1");
+    doc.set("count", 3);
+    doc.set("shots", (uint8_t)2);  // routed to uint32_t
+    doc.set("offset", (long)-40); // routed to int64_t
+}
+
+void test_json_typed_setters();
+void test_json_typed_getters();
+void test_json_array_bulk_add();
+
+void run_json_typed_tests()
+{
+    RUN_TEST(test_json_typed_setters);
+    RUN_TEST(test_json_typed_getters);
+    RUN_TEST(test_json_array_bulk_add);
+}
+
+void test_json_typed_setters()
+{
+    ArduinoJsonWrapper doc(ArduinoJsonWrapper::LARGE);
+    fillReading(doc);
+
+    JsonVariantConst v = doc.variant();
+    TEST_ASSERT_TRUE(v["celsius"].is<float>());
+    TEST_ASSERT_FALSE(v["celsius"].is<const char *>());
+    TEST_ASSERT_TRUE(v["full"].is<bool>());
+    TEST_ASSERT_TRUE(v["timestamp"].is<long long>());
+    TEST_ASSERT_EQUAL(2, v["shots"].as<int>());
+    TEST_ASSERT_EQUAL(-40, v["offset"].as<int>());
+
+    // Same through a nested object adapter
+    RumpusJsonDocument *nested = doc.getObject("nested");
+    fillReading(*nested);
+    delete nested;
+    TEST_ASSERT_TRUE(doc.variant()["nested"]["full"].is<bool>());
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 0.355, doc.variant()["nested"]["volume"].as<double>());
+}
+
+void test_json_typed_getters()
+{
+    ArduinoJsonWrapper doc(ArduinoJsonWrapper::LARGE);
+    fillReading(doc);
+    const RumpusJsonDocument &read = doc;
+
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 92.5, read.getFloat("celsius"));
+    TEST_ASSERT_FLOAT_WITHIN(0.0001, 0.355, read.getDouble("volume"));
+    TEST_ASSERT_TRUE(read.getBool("full"));
+    TEST_ASSERT_TRUE(1717171717123LL == read.getInt64("timestamp"));
+    TEST_ASSERT_EQUAL_UINT32(4000000000UL, read.getUInt32("uptime"));
+    TEST_ASSERT_EQUAL(3, read.getInt("count"));
+    TEST_ASSERT_EQUAL_STRING("p1", read.getString("probe").c_str());
+
+    // Missing keys and other types give the fallback
+    TEST_ASSERT_EQUAL(7, read.getInt("missing", 7));
+    TEST_ASSERT_EQUAL(-1, read.getInt("probe", -1));
+    TEST_ASSERT_EQUAL(9, read.getInt("timestamp", 9));  // out of int range
+    TEST_ASSERT_EQUAL_UINT32(5, read.getUInt32("offset", 5)); // negative
+    TEST_ASSERT_FALSE(read.getBool("count"));
+    TEST_ASSERT_EQUAL_STRING("none", read.getString("count", "none").c_str());
+    TEST_ASSERT_EQUAL(92, read.getInt("celsius")); // truncated
+}
+
+void test_json_array_bulk_add()
+{
+    ArduinoJsonWrapper doc(ArduinoJsonWrapper::LARGE);
+    RumpusJsonDocument *samples = doc.getArray("samples");
+    JsonArrayWrapper *arr = static_cast<JsonArrayWrapper *>(samples);
+
+    const float temps[] = {91.5f, 92.0f, 92.25f};
+    const uint16_t raw[] = {512, 1023};
+    const char *const probes[] = {"p1", "p2"};
+    TEST_ASSERT_EQUAL(3, arr->add(temps, 3));
+    TEST_ASSERT_EQUAL(2, arr->add(raw, 2));
+    TEST_ASSERT_EQUAL(2, arr->add(probes, 2));
+    TEST_ASSERT_TRUE(arr->add(false));
+    delete samples;
+
+    JsonArrayView view = doc.array("samples");
+    TEST_ASSERT_EQUAL(8, view.size());
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 92.25, view.get(2).as<float>());
+    TEST_ASSERT_EQUAL(1023, view.get(4).as<int>());
+    TEST_ASSERT_EQUAL_STRING("p2", view.get(6).as<const char *>());
+
+    // A full document stops the bulk add instead of dropping values silently
+    ArduinoJsonWrapper small(ArduinoJsonWrapper::SMALL);
+    int32_t many[64] = {};
+    size_t added = small.array("many").add(many, 64);
+    TEST_ASSERT_TRUE(added > 0 && added < 64);
+}
@@ -0,0 +1,98 @@
+#include <unity.h>
+#include "ArduinoJsonWrapper.h"
+#include "JsonArrayWrapper.h"
+
+void test_json_views_write_into_parent();
+void test_json_views_reuse_existing_members();
+void test_json_adapters_write_into_parent();
+void test_json_adapters_survive_parent_growth();
+
+void run_json_view_tests()
+{
+    RUN_TEST(test_json_views_write_into_parent);
+    RUN_TEST(test_json_views_reuse_existing_members);
+    RUN_TEST(test_json_adapters_write_into_parent);
+    RUN_TEST(test_json_adapters_survive_parent_growth);
+}
+
+void test_json_views_write_into_parent()
+{
+    ArduinoJsonWrapper doc;
+    JsonObjectView payload = doc.object("payload");
+    payload.set("user", "Chuck");
+    payload.set("duration", 120);
+
+    JsonArrayView values = payload.array("values");
+    values.add(1);
+    values.addObject().set("id", 7);
+
+    TEST_ASSERT_EQUAL_STRING("{\"payload\":{\"user\":\"Chuck\",\"duration\":120,\"values\":[1,{\"id\":7}]}}",
+                             doc.serialize().c_str());
+}
+
+void test_json_views_reuse_existing_members()
+{
+    ArduinoJsonWrapper doc;
+    doc.object("payload").set("a", 1);
+    doc.object("payload").set("b", 2);
+    doc.array("list").add(1);
+    doc.array("list").add(2);
+
+    // A non-object value is replaced by a fresh object
+    doc.set("status", "ok");
+    doc.object("status").set("code", 200);
+
+    TEST_ASSERT_EQUAL(2, doc.object("payload").size());
+    TEST_ASSERT_EQUAL(2, doc.array("list").size());
+    TEST_ASSERT_EQUAL(200, doc.root().object("status").get("code").as<int>());
+}
+
+void test_json_adapters_write_into_parent()
+{
+    ArduinoJsonWrapper doc;
+    RumpusJsonDocument *nested = doc.getObject("payload");
+    nested->set("user", "Chuck");
+    RumpusJsonDocument *inner = nested->getObject("meta");
+    inner->set("v", 1);
+    delete inner;
+    delete nested;
+
+    TEST_ASSERT_EQUAL_STRING("{\"payload\":{\"user\":\"Chuck\",\"meta\":{\"v\":1}}}", doc.serialize().c_str());
+}
+
+void test_json_adapters_survive_parent_growth()
+{
+    static const char *const keys[] = {"k0", "k1", "k2", "k3", "k4", "k5", "k6", "k7", "k8", "k9", "k10", "k11"};
+    ArduinoJsonWrapper doc(ArduinoJsonWrapper::SMALL);
+    RumpusJsonDocument *payload = doc.getObject("payload");
+    JsonArrayWrapper *values = static_cast<JsonArrayWrapper *>(doc.getArray("values"));
+
+    // The parent moves to a bigger document under the adapters
+    for (int i = 0; i < 12; i++)
+        doc.set(keys[i], i);
+    TEST_ASSERT_TRUE(doc.capacity() > 128);
+
+    payload->set("user", "Chuck");
+    values->add(1);
+    TEST_ASSERT_EQUAL_STRING("{\"user\":\"Chuck\"}", payload->serialize().c_str());
+    TEST_ASSERT_EQUAL_STRING("[1]", values->serialize().c_str());
+
+    // Writes through the adapters grow the parent instead of being dropped
+    ArduinoJsonWrapper small(ArduinoJsonWrapper::SMALL);
+    RumpusJsonDocument *nested = small.getObject("nested");
+    JsonArrayWrapper *list = static_cast<JsonArrayWrapper *>(small.getArray("list"));
+    for (int i = 0; i < 12; i++)
+    {
+        nested->set(keys[i], "a value long enough to overflow");
+        TEST_ASSERT_TRUE(list->add("another value long enough to overflow"));
+    }
+    TEST_ASSERT_TRUE(small.capacity() > 128);
+    TEST_ASSERT_EQUAL(12, small.object("nested").size());
+    TEST_ASSERT_EQUAL(12, small.array("list").size());
+    TEST_ASSERT_EQUAL_STRING("a value long enough to overflow", small.object("nested").get("k11").as<const char *>());
+
+    delete list;
+    delete nested;
+    delete values;
+    delete payload;
+}
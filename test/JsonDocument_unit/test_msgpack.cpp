@@ -0,0 +1,123 @@
+#include <unity.h>
+#include "MsgPackDocument.h"
+#include "ArduinoJsonWrapper.h"
+
+// Uses jsonBenchMicros() / JSON_BENCH_ITERATIONS from test_json_copy.cpp
+
+// Print that keeps raw bytes (MessagePack may contain NULs)
+class ByteCapturePrint : public Print
+{
+public:
+    uint8_t bytes[128];
+    size_t length = 0;
+    size_t write(uint8_t c) override
+    {
+        if (length < sizeof(bytes))
+            bytes[length++] = c;
+        return 1;
+    }
+};
+
+// Representative payloads, built only through the abstract interface
+static void buildLogPayload(RumpusJsonDocument &doc)
+{
+    doc.set("level", "info");
+    doc.set("source", "coffee-bar");
+    doc.set("message", "Brew cycle finished");
+    doc.set("uptime", 183022);
+    doc.set("heap", 21344);
+}
+
+static void buildPrintJobPayload(RumpusJsonDocument &doc)
+{
+    doc.set("job", 42);
+    doc.set("printer", "kitchen");
+    doc.set("user", "Chuck");
+    doc.set("copies", 1);
+    RumpusJsonDocument *order = doc.getObject("order");
+    order->set("drink", "Cortado");
+    order->set("size", 8);
+    order->set("shots", 2);
+    order->set("milk", "oat");
+    delete order;
+}
+
+void test_msgpack_encoding();
+void test_msgpack_same_document_api();
+void test_msgpack_benchmark();
+
+void run_msgpack_tests()
+{
+    RUN_TEST(test_msgpack_encoding);
+    RUN_TEST(test_msgpack_same_document_api);
+    RUN_TEST(test_msgpack_benchmark);
+}
+
+void test_msgpack_encoding()
+{
+    MsgPackDocument doc(ArduinoJsonWrapper::SMALL);
+    doc.set("a", 1);
+    doc.set("b", "xy");
+
+    ByteCapturePrint out;
+    TEST_ASSERT_EQUAL(9, doc.serializeTo(out));
+    const uint8_t expected[] = {0x82, 0xA1, 'a', 0x01, 0xA1, 'b', 0xA2, 'x', 'y'};
+    TEST_ASSERT_EQUAL(sizeof(expected), out.length);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, out.bytes, sizeof(expected));
+    TEST_ASSERT_EQUAL(9, doc.measure());
+
+    TEST_ASSERT_EQUAL_STRING("application/msgpack", doc.contentType());
+    TEST_ASSERT_EQUAL_STRING("{\"a\":1,\"b\":\"xy\"}", doc.serialize().c_str());
+}
+
+void test_msgpack_same_document_api()
+{
+    ArduinoJsonWrapper json;
+    MsgPackDocument packed;
+    buildPrintJobPayload(json);
+    buildPrintJobPayload(packed);
+
+    TEST_ASSERT_EQUAL_STRING("application/json", json.contentType());
+    TEST_ASSERT_EQUAL_STRING(json.serialize().c_str(), packed.serialize().c_str());
+
+    // Nesting across formats copies the tree, not the wire bytes
+    ArduinoJsonWrapper parent;
+    parent.set("job", &packed);
+    TEST_ASSERT_EQUAL(42, parent.variant()["job"]["job"].as<int>());
+}
+
+// Size and encode time of each format for the same payloads
+void test_msgpack_benchmark()
+{
+    void (*const builders[])(RumpusJsonDocument &) = {buildLogPayload, buildPrintJobPayload};
+    const char *names[] = {"log", "printJob"};
+
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        ArduinoJsonWrapper json(ArduinoJsonWrapper::LARGE);
+        MsgPackDocument packed(ArduinoJsonWrapper::LARGE);
+        builders[i](json);
+        builders[i](packed);
+
+        JsonStreamWriter::Counter sink;
+        unsigned long start = jsonBenchMicros();
+        for (int n = 0; n < JSON_BENCH_ITERATIONS; n++)
+            json.serializeTo(sink);
+        unsigned long jsonUs = jsonBenchMicros() - start;
+
+        start = jsonBenchMicros();
+        for (int n = 0; n < JSON_BENCH_ITERATIONS; n++)
+            packed.serializeTo(sink);
+        unsigned long packedUs = jsonBenchMicros() - start;
+
+        size_t jsonBytes = json.measure();
+        size_t packedBytes = packed.measure();
+        String report = String(names[i]) + " x" + String(JSON_BENCH_ITERATIONS) +
+                        " json=" + String((unsigned long)jsonBytes) + "B/" + String(jsonUs) + "us" +
+                        " msgpack=" + String((unsigned long)packedBytes) + "B/" + String(packedUs) + "us";
+        TEST_MESSAGE(report.c_str());
+
+        // At least 20% smaller on these key-heavy payloads
+        TEST_ASSERT_TRUE(packedBytes * 10 <= jsonBytes * 8);
+    }
+}
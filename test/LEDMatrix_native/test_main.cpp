@@ -0,0 +1,407 @@
+// Host-side runner: LED renderers on a VirtualLEDMatrix, golden frames and render benchmarks.
+// pio test -e LEDMatrix_native
+//
+//   LED_CAPTURE_DIR=path   Also write the golden sequences as ASCII and PPM strips for a look
+#include <Arduino.h>
+#include <ArduinoFake.h>
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "platform/host/VirtualLEDMatrix.h"
+#include "renderer/DrawEngine.h"
+#include "renderer/ScrollEngine.h"
+#include "renderer/TextColumnStream.h"
+#include "renderer/TextLayout.h"
+#include "font/Default5x7.h"
+#include "Max7219Chain.h"
+
+#include "../LEDMatrix_unit/test_packed_frame.cpp"
+#include "../LEDMatrix_unit/test_scroll_engine.cpp"
+#include "../LEDMatrix_unit/test_text_column_stream.cpp"
+#include "../LEDMatrix_unit/test_font_table.cpp"
+#include "../LEDMatrix_unit/test_draw_engine.cpp"
+#include "../LEDMatrix_unit/test_animation.cpp"
+#include "../LEDMatrix_unit/test_text_layout.cpp"
+
+using namespace fakeit;
+
+#include <chrono>
+static unsigned long ledBenchMicros()
+{
+    using namespace std::chrono;
+    return (unsigned long)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+#ifndef LED_BENCH_TEXT_REPEAT
+#define LED_BENCH_TEXT_REPEAT 20 ///< Copies of the benchmark sentence to scroll
+#endif
+
+static const char *const LED_BENCH_TEXT = "The quick brown fox jumps over the lazy dog 0123456789 ";
+
+// Drive a scroller and the virtual clock together
+static void tick(VirtualLEDMatrix &matrix, ScrollEngine &scroller, uint32_t now)
+{
+    matrix.setTime(now);
+    scroller.update(now);
+}
+
+// Write strips next to the golden data when LED_CAPTURE_DIR is set
+static void exportCapture(const VirtualLEDMatrix &matrix, const char *name, size_t step = 1)
+{
+    const char *dir = getenv("LED_CAPTURE_DIR");
+    if (!dir)
+        return;
+    String base = String(dir) + "/" + name;
+    TEST_ASSERT_TRUE(matrix.writeAscii((base + ".txt").c_str(), 0, (size_t)-1, step));
+    TEST_ASSERT_TRUE(matrix.writePpm((base + ".ppm").c_str(), 0, (size_t)-1, step));
+}
+
+// ---------------------------------------------------------------------------
+// Golden frames
+// ---------------------------------------------------------------------------
+
+void test_golden_draw_text()
+{
+    VirtualLEDMatrix matrix;
+    DrawEngine engine(&matrix);
+    engine.setTargetFps(0);
+    engine.begin();
+
+    engine.drawText("Hi!", 1);
+    matrix.setTime(5);
+    TEST_ASSERT_TRUE(engine.present(5));
+
+    const char *golden =
+        ".#...#...#..\n"
+        ".#...#......\n"
+        ".#...#..##..\n"
+        ".#####...#..\n"
+        ".#...#...#..\n"
+        ".#...#...#..\n"
+        ".#...#..###.\n"
+        "............\n";
+    TEST_ASSERT_EQUAL_STRING(golden, VirtualLEDMatrix::toAscii(matrix.current()).c_str());
+
+    // '!' starts past the right edge; begin() blanked the display before the text
+    TEST_ASSERT_TRUE(matrix.capture(0).frame.isEmpty());
+    TEST_ASSERT_EQUAL(5, matrix.capture(matrix.captureCount() - 1).time);
+    exportCapture(matrix, "golden_draw_text");
+}
+
+void test_golden_scroll_sequence()
+{
+    VirtualLEDMatrix matrix;
+    ScrollEngine scroller(&matrix);
+    scroller.setSpeed(100);
+    scroller.setLoopCount(1);
+    scroller.start("Hi");
+
+    for (uint32_t now = 0; !scroller.isDone(); now += 50)
+        tick(matrix, scroller, now);
+
+    // One frame per 100 ms column step: blank, 12 columns of text in, 12 out
+    TEST_ASSERT_EQUAL(1 + 12 + 12, matrix.captureCount());
+    for (size_t i = 0; i < matrix.captureCount(); i++)
+        TEST_ASSERT_EQUAL(i * 100, matrix.capture(i).time);
+
+    // Every fourth frame: the text enters on the right and leaves on the left
+    const char *golden =
+        "............ ........#... ....#...#... #...#...#... #...#....... #........... ............\n"
+        "............ ........#... ....#...#... #...#....... #........... ............ ............\n"
+        "............ ........#... ....#...#..# #...#..##... #..##....... #........... ............\n"
+        "............ ........#### ....#####... #####...#... #...#....... #........... ............\n"
+        "............ ........#... ....#...#... #...#...#... #...#....... #........... ............\n"
+        "............ ........#... ....#...#... #...#...#... #...#....... #........... ............\n"
+        "............ ........#... ....#...#..# #...#..###.. #..###...... ##.......... ............\n"
+        "............ ............ ............ ............ ............ ............ ............\n";
+    String strip = matrix.asciiStrip(0, (size_t)-1, 4);
+    TEST_ASSERT_EQUAL_STRING(golden, strip.c_str());
+    exportCapture(matrix, "golden_scroll_hi");
+}
+
+void test_virtual_capture_limit()
+{
+    VirtualLEDMatrix matrix(3);
+    PackedFrame frame;
+    for (uint8_t c = 0; c < 5; c++)
+    {
+        frame.orColumn(c, 0xFF);
+        matrix.setTime(c * 10);
+        matrix.renderFrame(frame);
+    }
+
+    // Only the first three are kept, but everything is counted
+    TEST_ASSERT_EQUAL(3, matrix.captureCount());
+    TEST_ASSERT_EQUAL(5, matrix.framesPresented());
+    TEST_ASSERT_EQUAL(5 * 12, matrix.busBytes());
+    TEST_ASSERT_EQUAL_HEX8(0xFF, matrix.current().column(4));
+    TEST_ASSERT_EQUAL(20, matrix.capture(2).time);
+
+    matrix.reset();
+    TEST_ASSERT_EQUAL(0, matrix.captureCount());
+    TEST_ASSERT_EQUAL(0, matrix.framesPresented());
+    TEST_ASSERT_EQUAL_HEX8(0xFF, matrix.current().column(4));
+}
+
+void test_virtual_export()
+{
+    VirtualLEDMatrix matrix;
+    PackedFrame frame;
+    frame.set(0, 0, true);
+    matrix.renderFrame(frame);
+    frame.set(7, 11, true);
+    matrix.renderFrame(frame);
+
+    const char *ppm = "/tmp/virtual_led_matrix_test.ppm";
+    TEST_ASSERT_TRUE(matrix.writePpm(ppm, 0, 2, 1, 2));
+
+    // Two 12x8 frames with a one-LED gap, each LED 2x2 pixels
+    FILE *f = fopen(ppm, "rb");
+    TEST_ASSERT_NOT_NULL(f);
+    char header[32] = {0};
+    TEST_ASSERT_NOT_NULL(fgets(header, sizeof(header), f));
+    TEST_ASSERT_EQUAL_STRING("P6\n", header);
+    TEST_ASSERT_NOT_NULL(fgets(header, sizeof(header), f));
+    TEST_ASSERT_EQUAL_STRING("50 16\n", header);
+    TEST_ASSERT_NOT_NULL(fgets(header, sizeof(header), f));
+    uint8_t first[3];
+    TEST_ASSERT_EQUAL(3, fread(first, 1, 3, f)); // top-left LED is lit
+    TEST_ASSERT_EQUAL(255, first[0]);
+    fseek(f, 0, SEEK_END);
+    TEST_ASSERT_EQUAL((long)(strlen("P6\n50 16\n255\n") + 50 * 16 * 3), ftell(f));
+    fclose(f);
+    remove(ppm);
+
+    const char *txt = "/tmp/virtual_led_matrix_test.txt";
+    TEST_ASSERT_TRUE(matrix.writeAscii(txt));
+    remove(txt);
+
+    // Nothing to export
+    TEST_ASSERT_FALSE(matrix.writePpm(ppm, 5));
+    TEST_ASSERT_EQUAL_STRING("", matrix.asciiStrip(5).c_str());
+}
+
+// ---------------------------------------------------------------------------
+// Benchmarks
+// ---------------------------------------------------------------------------
+
+#ifndef LED_BENCH_SHIFT_STEPS
+#define LED_BENCH_SHIFT_STEPS 2000 ///< Scroll steps of the frame comparison
+#endif
+
+// One scroll step: packed shift against the old per-byte column copy
+void test_bench_packed_frame()
+{
+    uint8_t bytes[PackedFrame::ROWS][PackedFrame::COLUMNS] = {};
+    PackedFrame frame;
+
+    unsigned long start = ledBenchMicros();
+    for (uint16_t step = 0; step < LED_BENCH_SHIFT_STEPS; step++)
+    {
+        uint8_t incoming = step * 37;
+        for (uint8_t r = 0; r < PackedFrame::ROWS; r++)
+        {
+            for (uint8_t c = 0; c < PackedFrame::COLUMNS - 1; c++)
+                bytes[r][c] = bytes[r][c + 1];
+            bytes[r][PackedFrame::COLUMNS - 1] = (incoming >> r) & 1;
+        }
+    }
+    unsigned long bytesUs = ledBenchMicros() - start;
+
+    start = ledBenchMicros();
+    for (uint16_t step = 0; step < LED_BENCH_SHIFT_STEPS; step++)
+        frame.shiftLeft(step * 37);
+    unsigned long packedUs = ledBenchMicros() - start;
+    TEST_ASSERT_TRUE(PackedFrame::fromBytes(bytes) == frame);
+
+    char report[160];
+    snprintf(report, sizeof(report), "PackedFrame: %u shifts, bytes %lu us, packed %lu us; frame %u B -> %u B",
+             (unsigned)LED_BENCH_SHIFT_STEPS, bytesUs, packedUs, (unsigned)sizeof(bytes), (unsigned)sizeof(frame));
+    TEST_MESSAGE(report);
+}
+
+void test_bench_scroll_engine()
+{
+    String text;
+    for (int i = 0; i < LED_BENCH_TEXT_REPEAT; i++)
+        text += LED_BENCH_TEXT;
+
+    VirtualLEDMatrix matrix(0); // count frames, keep none
+    ScrollEngine scroller(&matrix);
+    scroller.setSpeed(1);
+    scroller.setLoopCount(1);
+    scroller.start(text);
+
+    uint32_t now = 0;
+    unsigned long start = ledBenchMicros();
+    while (!scroller.isDone())
+        scroller.update(now++);
+    unsigned long us = ledBenchMicros() - start;
+
+    uint32_t frames = matrix.framesPresented();
+    TEST_ASSERT_TRUE(frames > text.length());
+    double usPerFrame = frames ? (double)us / frames : 0;
+    char report[160];
+    snprintf(report, sizeof(report), "ScrollEngine: %lu frames in %lu us, %.3f us/frame (%.0f fps of CPU), %lu B to the matrix",
+             (unsigned long)frames, us, usPerFrame, usPerFrame > 0 ? 1e6 / usPerFrame : 0.0,
+             (unsigned long)matrix.busBytes());
+    TEST_MESSAGE(report);
+}
+
+#ifndef LED_BENCH_DRAW_TICKS
+#define LED_BENCH_DRAW_TICKS 1000 ///< 10 ms ticks of the DrawEngine clock loop
+#endif
+
+// A clock-style loop: redraw every tick, text changes once a second
+void test_bench_draw_engine()
+{
+    PresentCountingMatrix matrix;
+    DrawEngine engine(&matrix);
+    engine.begin();
+
+    unsigned long start = ledBenchMicros();
+    for (uint32_t tick = 0; tick < LED_BENCH_DRAW_TICKS; tick++)
+    {
+        uint32_t now = tick * 10;
+        char text[3] = {'0', (char)('0' + (now / 1000) % 10), '\0'};
+        engine.clear();
+        engine.drawText(text);
+        engine.present(now);
+    }
+    unsigned long us = ledBenchMicros() - start;
+
+    char report[160];
+    snprintf(report, sizeof(report), "DrawEngine: %u ticks in %lu us, presented %lu frames, %lu B to the matrix (every tick: %lu B)",
+             (unsigned)LED_BENCH_DRAW_TICKS, us, (unsigned long)matrix.frames, (unsigned long)matrix.bytes,
+             (unsigned long)LED_BENCH_DRAW_TICKS * PackedFrame::WORDS * sizeof(uint32_t));
+    TEST_MESSAGE(report);
+}
+
+#ifndef LED_BENCH_GLYPH_LOOKUPS
+#define LED_BENCH_GLYPH_LOOKUPS 20000 ///< getGlyph() calls timed
+#endif
+
+// Glyph lookups in Default5x7, and the flash its table takes
+void test_bench_font_table()
+{
+    const Default5x7 &font = Default5x7::shared();
+    const char *text = "Latte x2 for Chuck, 08:15!";
+    size_t len = strlen(text);
+
+    Glyph glyph;
+    uint32_t columns = 0;
+    unsigned long start = ledBenchMicros();
+    for (uint32_t i = 0; i < LED_BENCH_GLYPH_LOOKUPS; i++)
+        if (font.getGlyph(text[i % len], glyph))
+            columns += glyph.xAdvance;
+    unsigned long us = ledBenchMicros() - start;
+    TEST_ASSERT_TRUE(columns > 0);
+
+    // Read back from the table itself: the bitmap ends after its last glyph
+    const FontTable &table = font.table();
+    size_t bitmapBytes = 0;
+    for (uint16_t i = 0; i < table.count(); i++)
+    {
+        size_t end = pgm_read_word(&table.glyphs[i].offset) + pgm_read_byte(&table.glyphs[i].width);
+        if (end > bitmapBytes)
+            bitmapBytes = end;
+    }
+    size_t glyphBytes = table.count() * sizeof(GlyphEntry);
+    size_t kerningBytes = table.kerningCount * sizeof(KernPair);
+
+    char report[160];
+    snprintf(report, sizeof(report), "Default5x7: %u lookups in %lu us, %.3f us/lookup; flash bitmap %u B + glyphs %u B + kerning %u B",
+             (unsigned)LED_BENCH_GLYPH_LOOKUPS, us, (double)us / LED_BENCH_GLYPH_LOOKUPS, (unsigned)bitmapBytes,
+             (unsigned)glyphBytes, (unsigned)kerningBytes);
+    TEST_MESSAGE(report);
+}
+
+#ifndef LED_BENCH_LAYOUT_MEASURES
+#define LED_BENCH_LAYOUT_MEASURES 1000 ///< TextLayout::measure() calls timed
+#endif
+
+// Monospace against proportional width, and measuring with a warm cache
+void test_bench_text_layout()
+{
+    const char *text = "1.1 lit 11:11, till 1!";
+    TextLayout mono;
+    TextLayout proportional;
+    proportional.setProportional(true);
+
+    uint32_t columns = 0;
+    unsigned long start = ledBenchMicros();
+    for (uint32_t i = 0; i < LED_BENCH_LAYOUT_MEASURES; i++)
+        columns += proportional.measure(text);
+    unsigned long us = ledBenchMicros() - start;
+    TEST_ASSERT_EQUAL(proportional.measure(text) * (uint32_t)LED_BENCH_LAYOUT_MEASURES, columns);
+
+    char report[160];
+    snprintf(report, sizeof(report), "TextLayout: width %u -> %u columns, %u measures in %lu us, %.3f us/measure",
+             (unsigned)mono.measure(text), (unsigned)proportional.measure(text), (unsigned)LED_BENCH_LAYOUT_MEASURES, us,
+             (double)us / LED_BENCH_LAYOUT_MEASURES);
+    TEST_MESSAGE(report);
+}
+
+// Bytes clocked out by Max7219Chain, counted through the shiftOut() fake
+static uint32_t max7219BusBytes = 0;
+
+void test_bench_max7219_bus()
+{
+    When(Method(ArduinoFake(), pinMode)).AlwaysReturn();
+    When(Method(ArduinoFake(), digitalWrite)).AlwaysReturn();
+    When(Method(ArduinoFake(), shiftOut)).AlwaysDo([](uint8_t, uint8_t, uint8_t, uint8_t) { max7219BusBytes++; });
+
+    for (uint8_t devices = 4; devices <= 8; devices += 4)
+    {
+        Max7219Chain chain(11, 13, 10, devices);
+        chain.begin();
+
+        TextColumnStream stream;
+        stream.setText(LED_BENCH_TEXT);
+
+        max7219BusBytes = 0;
+        uint32_t frames = 0;
+        uint8_t bits;
+        unsigned long start = ledBenchMicros();
+        while (stream.next(bits))
+        {
+            chain.scrollLeft(bits);
+            chain.flush();
+            frames++;
+        }
+        unsigned long us = ledBenchMicros() - start;
+
+        // Never more than one shift per row: 8 rows x 2 bytes per device
+        TEST_ASSERT_TRUE(max7219BusBytes <= frames * 8 * 2 * devices);
+        char report[160];
+        snprintf(report, sizeof(report), "MAX7219 x%u: %lu frames, %.1f bus B/frame (full redraw %u B), %.3f us/frame",
+                 devices, (unsigned long)frames, (double)max7219BusBytes / frames, 8 * 2 * devices,
+                 (double)us / frames);
+        TEST_MESSAGE(report);
+    }
+    ArduinoFakeReset();
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    run_packed_frame_tests();
+    run_scroll_engine_tests();
+    run_text_column_stream_tests();
+    run_font_table_tests();
+    run_draw_engine_tests();
+    run_animation_tests();
+    run_text_layout_tests();
+    RUN_TEST(test_golden_draw_text);
+    RUN_TEST(test_golden_scroll_sequence);
+    RUN_TEST(test_virtual_capture_limit);
+    RUN_TEST(test_virtual_export);
+    RUN_TEST(test_bench_packed_frame);
+    RUN_TEST(test_bench_scroll_engine);
+    RUN_TEST(test_bench_draw_engine);
+    RUN_TEST(test_bench_font_table);
+    RUN_TEST(test_bench_text_layout);
+    RUN_TEST(test_bench_max7219_bus);
+    return UNITY_END();
+}
@@ -0,0 +1,207 @@
+#include <unity.h>
+#include "LEDMatrix.h"
+#include "anim/AnimationPlayer.h"
+#include "anim/BootSpinner.h"
+
+// Uses PresentCountingMatrix from test_draw_engine.cpp
+
+// Three frames, one per encoding, with a duration change on the last
+static const uint8_t TEST_ANIMATION_FRAMES[] PROGMEM = {
+    // All on, 100 ms: RLE, one run of 12 x 0xFF
+    ANIMATION_DURATION_FOLLOWS | (ANIMATION_RLE << 5), 100, 0x8B, 0xFF,
+    // Top-left 4 pixels off and bottom-right 4 off: mask for bytes 0 and 11
+    ANIMATION_MASK << 5, 0x01, 0x08, 0xF0, 0x0F,
+    // 300 ms (varint): turn the two corners back on
+    ANIMATION_DURATION_FOLLOWS | (ANIMATION_TOGGLES << 5) | 2, 0xAC, 0x02, 0, 95,
+};
+
+static const AnimationData TEST_ANIMATION = {TEST_ANIMATION_FRAMES, sizeof(TEST_ANIMATION_FRAMES), 3};
+
+void test_animation_decodes_spinner();
+void test_animation_encodings();
+void test_animation_timing_and_loops();
+void test_animation_catch_up();
+void test_animation_bad_data();
+void test_animation_through_draw_engine();
+void test_animation_flash_size();
+
+void run_animation_tests()
+{
+    RUN_TEST(test_animation_decodes_spinner);
+    RUN_TEST(test_animation_encodings);
+    RUN_TEST(test_animation_timing_and_loops);
+    RUN_TEST(test_animation_catch_up);
+    RUN_TEST(test_animation_bad_data);
+    RUN_TEST(test_animation_through_draw_engine);
+    RUN_TEST(test_animation_flash_size);
+}
+
+void test_animation_decodes_spinner()
+{
+    PresentCountingMatrix matrix;
+    AnimationPlayer player(&matrix);
+    player.start(BOOTSPINNER);
+
+    // Frame 0: the comet stands on column 3, rows 1-3
+    TEST_ASSERT_TRUE(player.update(0));
+    TEST_ASSERT_EQUAL_HEX8(0b00001110, matrix.last.column(3));
+    TEST_ASSERT_EQUAL_HEX8(0, matrix.last.column(4));
+
+    // Frame 1: its head has turned the corner onto row 1
+    TEST_ASSERT_FALSE(player.update(59));
+    TEST_ASSERT_TRUE(player.update(60));
+    TEST_ASSERT_EQUAL(1, player.frameIndex());
+    TEST_ASSERT_EQUAL_HEX8(0b00000110, matrix.last.column(3));
+    TEST_ASSERT_EQUAL_HEX8(0b00000010, matrix.last.column(4));
+
+    // Every frame is the three-pixel comet
+    for (uint32_t now = 120; player.frameIndex() != 0 || now == 120; now += 60)
+    {
+        player.update(now);
+        uint8_t lit = 0;
+        for (uint8_t r = 0; r < PackedFrame::ROWS; r++)
+            for (uint8_t c = 0; c < PackedFrame::COLUMNS; c++)
+                lit += matrix.last.get(r, c);
+        TEST_ASSERT_EQUAL(3, lit);
+    }
+}
+
+void test_animation_encodings()
+{
+    PresentCountingMatrix matrix;
+    AnimationPlayer player(&matrix);
+    player.start(TEST_ANIMATION);
+
+    TEST_ASSERT_TRUE(player.update(0));
+    for (uint8_t c = 0; c < PackedFrame::COLUMNS; c++)
+        TEST_ASSERT_EQUAL_HEX8(0xFF, matrix.last.column(c));
+
+    TEST_ASSERT_TRUE(player.update(100));
+    TEST_ASSERT_FALSE(matrix.last.get(0, 0));
+    TEST_ASSERT_FALSE(matrix.last.get(0, 3));
+    TEST_ASSERT_TRUE(matrix.last.get(0, 4));
+    TEST_ASSERT_TRUE(matrix.last.get(7, 7));
+    TEST_ASSERT_FALSE(matrix.last.get(7, 8));
+    TEST_ASSERT_FALSE(matrix.last.get(7, 11));
+
+    TEST_ASSERT_TRUE(player.update(200));
+    TEST_ASSERT_TRUE(matrix.last.get(0, 0));
+    TEST_ASSERT_FALSE(matrix.last.get(0, 1));
+    TEST_ASSERT_TRUE(matrix.last.get(7, 11));
+    TEST_ASSERT_FALSE(matrix.last.get(7, 10));
+}
+
+void test_animation_timing_and_loops()
+{
+    PresentCountingMatrix matrix;
+    AnimationPlayer player(&matrix);
+    player.setLoopCount(2);
+    player.start(TEST_ANIMATION);
+    TEST_ASSERT_FALSE(player.isDone());
+
+    // The clock starts on the first update, not at start()
+    TEST_ASSERT_TRUE(player.update(1000));
+    TEST_ASSERT_FALSE(player.update(1099));
+    TEST_ASSERT_TRUE(player.update(1100));
+    TEST_ASSERT_TRUE(player.update(1200));
+    TEST_ASSERT_EQUAL(2, player.frameIndex());
+
+    // The last frame holds its own 300 ms, then the loop starts over
+    TEST_ASSERT_FALSE(player.update(1499));
+    TEST_ASSERT_TRUE(player.update(1500));
+    TEST_ASSERT_EQUAL(0, player.frameIndex());
+    TEST_ASSERT_EQUAL(1, player.loopsDone());
+    TEST_ASSERT_EQUAL_HEX8(0xFF, matrix.last.column(0));
+
+    // Second loop plays out; the last frame stays on the display
+    player.update(1600);
+    player.update(1700);
+    TEST_ASSERT_FALSE(player.update(2000));
+    TEST_ASSERT_TRUE(player.isDone());
+    TEST_ASSERT_EQUAL(2, player.loopsDone());
+    TEST_ASSERT_EQUAL(2, player.frameIndex());
+    TEST_ASSERT_TRUE(matrix.last.get(7, 11));
+    TEST_ASSERT_EQUAL(6, matrix.frames);
+    TEST_ASSERT_FALSE(player.update(3000));
+
+    // Zero loops plays nothing
+    player.setLoopCount(0);
+    player.start(TEST_ANIMATION);
+    TEST_ASSERT_TRUE(player.isDone());
+}
+
+void test_animation_catch_up()
+{
+    PresentCountingMatrix matrix;
+    AnimationPlayer player(&matrix);
+    player.setLoopCount(1);
+    player.start(TEST_ANIMATION);
+    player.update(0);
+
+    // A late update decodes the frames it missed but pushes once
+    TEST_ASSERT_TRUE(player.update(250));
+    TEST_ASSERT_EQUAL(2, player.frameIndex());
+    TEST_ASSERT_EQUAL(2, matrix.frames);
+    TEST_ASSERT_TRUE(matrix.last.get(0, 0));
+
+    // Playback that ends inside a late update still shows its last frame
+    PresentCountingMatrix late;
+    AnimationPlayer lateShow(&late);
+    lateShow.setLoopCount(1);
+    lateShow.start(TEST_ANIMATION);
+    lateShow.update(0);
+    TEST_ASSERT_TRUE(lateShow.update(10000));
+    TEST_ASSERT_TRUE(lateShow.isDone());
+    TEST_ASSERT_TRUE(late.last.get(7, 11));
+}
+
+void test_animation_bad_data()
+{
+    // Mask record cut short: stops instead of reading past the end
+    static const uint8_t truncated[] PROGMEM = {ANIMATION_DURATION_FOLLOWS | (ANIMATION_MASK << 5), 10, 0xFF};
+    const AnimationData bad = {truncated, sizeof(truncated), 1};
+
+    PresentCountingMatrix matrix;
+    AnimationPlayer player(&matrix);
+    player.start(bad);
+    TEST_ASSERT_FALSE(player.update(0));
+    TEST_ASSERT_TRUE(player.isDone());
+    TEST_ASSERT_EQUAL(0, matrix.frames);
+
+    const AnimationData empty = {nullptr, 0, 0};
+    player.start(empty);
+    TEST_ASSERT_TRUE(player.isDone());
+}
+
+void test_animation_through_draw_engine()
+{
+    PresentCountingMatrix matrix;
+    DrawEngine engine(&matrix);
+    engine.setTargetFps(0);
+    engine.begin();
+
+    AnimationPlayer player(&engine);
+    player.setLoopCount(1);
+    player.start(BOOTSPINNER);
+    for (uint32_t now = 0; !player.isDone(); now += 10)
+        player.update(now);
+
+    // One present per spinner frame, nothing for the ticks in between
+    TEST_ASSERT_EQUAL(BOOTSPINNER.frames, matrix.frames);
+    TEST_ASSERT_TRUE(engine.frontBuffer() == player.frame());
+}
+
+void test_animation_flash_size()
+{
+    const size_t bytes = sizeof(BOOTSPINNER_FRAMES);
+    const size_t byteFrames = BOOTSPINNER.frames * PackedFrame::ROWS * PackedFrame::COLUMNS;
+    const size_t wordFrames = BOOTSPINNER.frames * 4 * sizeof(uint32_t);
+
+    // At least 5x smaller than the uint8_t[8][12] frames it replaces
+    TEST_ASSERT_TRUE(bytes * 5 <= byteFrames);
+
+    String report = "BootSpinner: " + String(BOOTSPINNER.frames) + " frames in " + String((unsigned long)bytes) +
+                    "B flash (uint8_t[8][12] frames " + String((unsigned long)byteFrames) + "B, uint32_t[4] frames " +
+                    String((unsigned long)wordFrames) + "B)";
+    TEST_MESSAGE(report.c_str());
+}
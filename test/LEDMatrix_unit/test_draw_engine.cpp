@@ -0,0 +1,141 @@
+#include <unity.h>
+#include "LEDMatrix.h"
+#include "renderer/DrawEngine.h"
+
+// Counts frames that reach the "hardware" and the bytes they would move
+class PresentCountingMatrix : public LEDMatrix
+{
+public:
+    using LEDMatrix::renderFrame;
+
+    void begin() override {}
+    void clear() override { last.clear(); }
+    void renderFrame(const PackedFrame &frame) override
+    {
+        last = frame;
+        frames++;
+        bytes += PackedFrame::WORDS * sizeof(uint32_t);
+    }
+    void setBrightness(uint8_t) override {}
+    void setTextSize(uint8_t) override {}
+
+    PackedFrame last;
+    uint32_t frames = 0;
+    uint32_t bytes = 0;
+};
+
+void test_draw_engine_presents_only_changes();
+void test_draw_engine_rate_limit();
+void test_draw_engine_draws_text();
+
+void run_draw_engine_tests()
+{
+    RUN_TEST(test_draw_engine_presents_only_changes);
+    RUN_TEST(test_draw_engine_rate_limit);
+    RUN_TEST(test_draw_engine_draws_text);
+}
+
+void test_draw_engine_presents_only_changes()
+{
+    PresentCountingMatrix matrix;
+    DrawEngine engine(&matrix);
+    engine.setTargetFps(0);
+    engine.begin();
+
+    // Nothing drawn, nothing sent
+    TEST_ASSERT_FALSE(engine.isDirty());
+    TEST_ASSERT_FALSE(engine.present(0));
+
+    engine.setPixel(2, 3);
+    engine.setPixel(9, 3); // off-screen, ignored
+    TEST_ASSERT_TRUE(engine.isDirty());
+    TEST_ASSERT_TRUE(engine.present(1));
+    TEST_ASSERT_EQUAL(1, matrix.frames);
+    TEST_ASSERT_TRUE(matrix.last.get(2, 3));
+    TEST_ASSERT_TRUE(engine.frontBuffer() == engine.backBuffer());
+
+    // Static content: no more traffic
+    TEST_ASSERT_FALSE(engine.present(2));
+    TEST_ASSERT_FALSE(engine.present(3));
+
+    // Redrawing the same frame is dirty but not different
+    engine.clear();
+    engine.setPixel(2, 3);
+    TEST_ASSERT_TRUE(engine.isDirty());
+    TEST_ASSERT_FALSE(engine.present(4));
+    TEST_ASSERT_FALSE(engine.isDirty());
+    TEST_ASSERT_EQUAL(1, matrix.frames);
+
+    // Many edits between presents go out as one frame
+    engine.drawColumn(0, 0xFF);
+    engine.drawColumn(11, 0x81);
+    engine.setPixel(2, 3, false);
+    TEST_ASSERT_TRUE(engine.present(5));
+    TEST_ASSERT_EQUAL(2, matrix.frames);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, matrix.last.column(0));
+    TEST_ASSERT_EQUAL_HEX8(0x81, matrix.last.column(11));
+    TEST_ASSERT_FALSE(matrix.last.get(2, 3));
+
+    // A clock redrawn every 10 ms tick whose text changes once a second:
+    // one frame per change, not one per tick
+    PresentCountingMatrix clock;
+    DrawEngine clockEngine(&clock);
+    clockEngine.begin();
+    for (uint32_t now = 0; now < 10000; now += 10)
+    {
+        char text[3] = {'0', (char)('0' + (now / 1000) % 10), '\0'};
+        clockEngine.clear();
+        clockEngine.drawText(text);
+        clockEngine.present(now);
+    }
+    TEST_ASSERT_EQUAL(10, clock.frames);
+}
+
+void test_draw_engine_rate_limit()
+{
+    PresentCountingMatrix matrix;
+    DrawEngine engine(&matrix);
+    engine.setTargetFps(20); // 50 ms per frame
+    engine.begin();
+
+    engine.setPixel(0, 0);
+    TEST_ASSERT_TRUE(engine.present(1000));
+
+    // Changed, but too soon: held back and still dirty
+    engine.setPixel(0, 1);
+    TEST_ASSERT_FALSE(engine.present(1020));
+    TEST_ASSERT_TRUE(engine.isDirty());
+    engine.setPixel(0, 2);
+    TEST_ASSERT_FALSE(engine.present(1049));
+
+    // Both edits go out together once the interval has passed
+    TEST_ASSERT_TRUE(engine.present(1050));
+    TEST_ASSERT_EQUAL(2, matrix.frames);
+    TEST_ASSERT_TRUE(matrix.last.get(0, 1));
+    TEST_ASSERT_TRUE(matrix.last.get(0, 2));
+}
+
+void test_draw_engine_draws_text()
+{
+    PresentCountingMatrix matrix;
+    DrawEngine engine(&matrix);
+    engine.setTargetFps(0);
+    engine.begin();
+
+    // Default5x7 'H' is 5 columns, then 1 blank
+    engine.drawText("HH", 1);
+    TEST_ASSERT_TRUE(engine.present(0));
+    TEST_ASSERT_EQUAL_HEX8(0, matrix.last.column(0));
+    TEST_ASSERT_EQUAL_HEX8(0b1111111, matrix.last.column(1));
+    TEST_ASSERT_EQUAL_HEX8(0b0001000, matrix.last.column(3));
+    TEST_ASSERT_EQUAL_HEX8(0, matrix.last.column(6));
+    TEST_ASSERT_EQUAL_HEX8(0b1111111, matrix.last.column(7));
+    TEST_ASSERT_EQUAL_HEX8(0b1111111, matrix.last.column(11));
+
+    // Negative offsets clip on the left
+    engine.clear();
+    engine.drawText("H", -4);
+    TEST_ASSERT_TRUE(engine.present(1));
+    TEST_ASSERT_EQUAL_HEX8(0b1111111, matrix.last.column(0));
+    TEST_ASSERT_EQUAL_HEX8(0, matrix.last.column(1));
+}
@@ -0,0 +1,155 @@
+#include <unity.h>
+#include "font/Default5x7.h"
+#include "renderer/TextColumnStream.h"
+
+void test_font_table_covers_printable_ascii();
+void test_font_table_glyphs();
+void test_font_table_layout();
+void test_font_table_rle();
+void test_font_table_rle_shared_streams();
+void test_font_table_kerning();
+
+void run_font_table_tests()
+{
+    RUN_TEST(test_font_table_covers_printable_ascii);
+    RUN_TEST(test_font_table_glyphs);
+    RUN_TEST(test_font_table_layout);
+    RUN_TEST(test_font_table_rle);
+    RUN_TEST(test_font_table_rle_shared_streams);
+    RUN_TEST(test_font_table_kerning);
+}
+
+// 'H', 'I' and 'L' as tools/fontc writes them with --proportional --rle
+static constexpr uint8_t RLE_BITMAP[] PROGMEM = {
+    0x00, 0x7F, 0x82, 0x08, 0x00, 0x7F, // 'H'
+    0x02, 0x41, 0x7F, 0x41,             // 'I'
+    0x00, 0x7F, 0x83, 0x40,             // 'L'
+};
+static constexpr GlyphEntry RLE_GLYPHS[] PROGMEM = {{0, 5}, {6, 3}, {0, 0}, {0, 0}, {10, 5}};
+static constexpr KernPair RLE_KERNING[] PROGMEM = {{'H', 'I', 1}, {'L', 'H', -2}, {'L', 'I', -1}};
+static constexpr FontTable RLE_TABLE = {'H', 'L', 8, 1, RLE_BITMAP, RLE_GLYPHS, RLE_KERNING, 3, FONT_TABLE_RLE};
+
+void test_font_table_covers_printable_ascii()
+{
+    const Default5x7 &font = Default5x7::shared();
+    Glyph glyph;
+    for (char c = ' '; c <= '~'; c++)
+    {
+        TEST_ASSERT_TRUE_MESSAGE(font.getGlyph(c, glyph), String(c).c_str());
+        TEST_ASSERT_NOT_NULL(glyph.bitmap);
+        TEST_ASSERT_EQUAL(glyph.width + 1, glyph.xAdvance);
+    }
+    TEST_ASSERT_FALSE(font.getGlyph('\x1f', glyph));
+    TEST_ASSERT_FALSE(font.getGlyph('\x7f', glyph));
+    TEST_ASSERT_FALSE(font.getGlyph('\n', glyph));
+}
+
+void test_font_table_glyphs()
+{
+    const Default5x7 &font = Default5x7::shared();
+    Glyph glyph;
+
+    const uint8_t A[] = {0x7C, 0x12, 0x11, 0x12, 0x7C};
+    TEST_ASSERT_TRUE(font.getGlyph('A', glyph));
+    TEST_ASSERT_EQUAL(5, glyph.width);
+    for (uint8_t col = 0; col < 5; col++)
+        TEST_ASSERT_EQUAL_HEX8(A[col], glyph.column(col));
+
+    // Descenders use row 7
+    TEST_ASSERT_TRUE(font.getGlyph('g', glyph));
+    TEST_ASSERT_EQUAL(8, glyph.height);
+    TEST_ASSERT_EQUAL_HEX8(0xA4, glyph.column(1));
+
+    // Space is narrower than the letters and blank
+    TEST_ASSERT_TRUE(font.getGlyph(' ', glyph));
+    TEST_ASSERT_EQUAL(3, glyph.width);
+    for (uint8_t col = 0; col < glyph.width; col++)
+        TEST_ASSERT_EQUAL_HEX8(0, glyph.column(col));
+}
+
+// Glyphs sit back to back in one bitmap, in character order
+void test_font_table_layout()
+{
+    const FontTable &table = Default5x7::shared().table();
+    TEST_ASSERT_EQUAL(95, table.count());
+
+    uint16_t next = 0;
+    for (uint16_t i = 0; i < table.count(); i++)
+    {
+        uint16_t offset = pgm_read_word(&table.glyphs[i].offset);
+        uint8_t width = pgm_read_byte(&table.glyphs[i].width);
+        TEST_ASSERT_EQUAL(next, offset);
+        next = offset + width;
+    }
+    TEST_ASSERT_EQUAL(3 + 94 * 5, next);
+}
+
+void test_font_table_rle()
+{
+    TableFont font(RLE_TABLE, 6);
+    Glyph glyph;
+
+    const uint8_t H[] = {0x7F, 0x08, 0x08, 0x08, 0x7F};
+    TEST_ASSERT_TRUE(font.getGlyph('H', glyph));
+    TEST_ASSERT_EQUAL(5, glyph.width);
+    TEST_ASSERT_EQUAL(6, glyph.xAdvance);
+    for (uint8_t col = 0; col < 5; col++)
+        TEST_ASSERT_EQUAL_HEX8(H[col], glyph.column(col));
+
+    // Literal run only
+    TEST_ASSERT_TRUE(font.getGlyph('I', glyph));
+    TEST_ASSERT_EQUAL(3, glyph.width);
+    TEST_ASSERT_EQUAL_HEX8(0x41, glyph.column(0));
+    TEST_ASSERT_EQUAL_HEX8(0x7F, glyph.column(1));
+    TEST_ASSERT_EQUAL_HEX8(0x41, glyph.column(2));
+
+    // Repeat run at the end
+    TEST_ASSERT_TRUE(font.getGlyph('L', glyph));
+    TEST_ASSERT_EQUAL_HEX8(0x7F, glyph.column(0));
+    for (uint8_t col = 1; col < 5; col++)
+        TEST_ASSERT_EQUAL_HEX8(0x40, glyph.column(col));
+
+    // Gaps in the range are missing, not empty
+    TEST_ASSERT_FALSE(font.getGlyph('J', glyph));
+    TEST_ASSERT_FALSE(font.getGlyph('M', glyph));
+}
+
+// Two streams on one RLE font: each keeps its glyph while the other decodes
+void test_font_table_rle_shared_streams()
+{
+    TableFont font(RLE_TABLE, 6);
+    TextColumnStream a(&font);
+    TextColumnStream b(&font);
+    a.setText("H");
+    b.setText("L");
+
+    uint8_t bits;
+    TEST_ASSERT_TRUE(a.next(bits));
+    TEST_ASSERT_EQUAL_HEX8(0x7F, bits);
+    TEST_ASSERT_TRUE(b.next(bits));
+    TEST_ASSERT_EQUAL_HEX8(0x7F, bits);
+    TEST_ASSERT_TRUE(a.next(bits));
+    TEST_ASSERT_EQUAL_HEX8(0x08, bits);
+    TEST_ASSERT_TRUE(b.next(bits));
+    TEST_ASSERT_EQUAL_HEX8(0x40, bits);
+
+    // Measuring an uncached character decodes into the font's buffer too
+    Glyph glyph;
+    TEST_ASSERT_TRUE(font.getGlyph('I', glyph));
+    TEST_ASSERT_TRUE(a.next(bits));
+    TEST_ASSERT_EQUAL_HEX8(0x08, bits);
+}
+
+void test_font_table_kerning()
+{
+    TableFont font(RLE_TABLE, 6);
+    TEST_ASSERT_EQUAL(1, font.kerning('H', 'I'));
+    TEST_ASSERT_EQUAL(-2, font.kerning('L', 'H'));
+    TEST_ASSERT_EQUAL(-1, font.kerning('L', 'I'));
+    TEST_ASSERT_EQUAL(0, font.kerning('I', 'L'));
+    TEST_ASSERT_EQUAL(0, font.kerning('H', 'H'));
+    TEST_ASSERT_EQUAL(0, font.kerning('A', 'V'));
+
+    // Tables without pairs never kern
+    TEST_ASSERT_EQUAL(0, Default5x7::shared().kerning('A', 'V'));
+}
@@ -0,0 +1,129 @@
+#include <unity.h>
+#include "PackedFrame.h"
+
+void test_packed_frame_layout();
+void test_packed_frame_columns();
+void test_packed_frame_shift();
+void test_packed_frame_bytes_round_trip();
+void test_packed_frame_matches_byte_scroll();
+
+void run_packed_frame_tests()
+{
+    RUN_TEST(test_packed_frame_layout);
+    RUN_TEST(test_packed_frame_columns);
+    RUN_TEST(test_packed_frame_shift);
+    RUN_TEST(test_packed_frame_bytes_round_trip);
+    RUN_TEST(test_packed_frame_matches_byte_scroll);
+}
+
+// Same bit order as the words loadFrame() takes
+void test_packed_frame_layout()
+{
+    PackedFrame frame;
+    TEST_ASSERT_TRUE(frame.isEmpty());
+
+    frame.set(0, 0);
+    TEST_ASSERT_EQUAL_HEX32(0x80000000UL, frame.word(0));
+
+    // Pixel 32 (row 2, column 8) starts word 1
+    frame.set(2, 8);
+    TEST_ASSERT_EQUAL_HEX32(0x80000000UL, frame.word(1));
+
+    // Last pixel is the LSB of word 2
+    frame.set(7, 11);
+    TEST_ASSERT_EQUAL_HEX32(0x00000001UL, frame.word(2));
+
+    TEST_ASSERT_TRUE(frame.get(2, 8));
+    TEST_ASSERT_FALSE(frame.get(2, 9));
+    frame.set(2, 8, false);
+    TEST_ASSERT_EQUAL_HEX32(0, frame.word(1));
+}
+
+void test_packed_frame_columns()
+{
+    PackedFrame frame;
+    frame.setColumn(5, 0xA5);
+    TEST_ASSERT_EQUAL_HEX8(0xA5, frame.column(5));
+    TEST_ASSERT_EQUAL_HEX8(0, frame.column(4));
+    TEST_ASSERT_EQUAL_HEX8(0, frame.column(6));
+
+    frame.orColumn(5, 0x5A);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, frame.column(5));
+    frame.setColumn(5, 0x01);
+    TEST_ASSERT_EQUAL_HEX8(0x01, frame.column(5));
+
+    // Every pixel belongs to exactly one column mask
+    uint32_t all[PackedFrame::WORDS] = {0, 0, 0};
+    for (uint8_t c = 0; c < PackedFrame::COLUMNS; c++)
+        for (uint8_t w = 0; w < PackedFrame::WORDS; w++)
+        {
+            TEST_ASSERT_EQUAL_HEX32(0, all[w] & PackedFrame::columnMask(c, w));
+            all[w] |= PackedFrame::columnMask(c, w);
+        }
+    for (uint8_t w = 0; w < PackedFrame::WORDS; w++)
+        TEST_ASSERT_EQUAL_HEX32(0xFFFFFFFFUL, all[w]);
+
+    frame.clearColumn(5);
+    TEST_ASSERT_TRUE(frame.isEmpty());
+}
+
+void test_packed_frame_shift()
+{
+    PackedFrame frame;
+    for (uint8_t c = 0; c < PackedFrame::COLUMNS; c++)
+        frame.setColumn(c, c + 1);
+
+    frame.shiftLeft(0x80);
+    for (uint8_t c = 0; c < PackedFrame::COLUMNS - 1; c++)
+        TEST_ASSERT_EQUAL_HEX8(c + 2, frame.column(c));
+    TEST_ASSERT_EQUAL_HEX8(0x80, frame.column(PackedFrame::COLUMNS - 1));
+
+    frame.shiftRight(0x7F);
+    TEST_ASSERT_EQUAL_HEX8(0x7F, frame.column(0));
+    for (uint8_t c = 1; c < PackedFrame::COLUMNS; c++)
+        TEST_ASSERT_EQUAL_HEX8(c + 1, frame.column(c));
+
+    // Twelve empty columns scroll everything out
+    for (uint8_t c = 0; c < PackedFrame::COLUMNS; c++)
+        frame.shiftLeft();
+    TEST_ASSERT_TRUE(frame.isEmpty());
+}
+
+void test_packed_frame_bytes_round_trip()
+{
+    uint8_t bytes[PackedFrame::ROWS][PackedFrame::COLUMNS];
+    for (uint8_t r = 0; r < PackedFrame::ROWS; r++)
+        for (uint8_t c = 0; c < PackedFrame::COLUMNS; c++)
+            bytes[r][c] = ((r * 7 + c * 3) % 5) == 0 ? 1 : 0;
+
+    PackedFrame frame = PackedFrame::fromBytes(bytes);
+    uint8_t back[PackedFrame::ROWS][PackedFrame::COLUMNS];
+    frame.toBytes(back);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&bytes[0][0], &back[0][0], sizeof(bytes));
+
+    PackedFrame copy(frame.word(0), frame.word(1), frame.word(2));
+    TEST_ASSERT_TRUE(copy == frame);
+    copy.set(0, 0, !copy.get(0, 0));
+    TEST_ASSERT_TRUE(copy != frame);
+}
+
+// Packed shifts give the same frame as the old per-byte column copy, in 12 bytes
+void test_packed_frame_matches_byte_scroll()
+{
+    uint8_t bytes[PackedFrame::ROWS][PackedFrame::COLUMNS] = {};
+    PackedFrame frame;
+
+    for (uint16_t step = 0; step < 40; step++)
+    {
+        uint8_t incoming = step * 37;
+        for (uint8_t r = 0; r < PackedFrame::ROWS; r++)
+        {
+            for (uint8_t c = 0; c < PackedFrame::COLUMNS - 1; c++)
+                bytes[r][c] = bytes[r][c + 1];
+            bytes[r][PackedFrame::COLUMNS - 1] = (incoming >> r) & 1;
+        }
+        frame.shiftLeft(incoming);
+        TEST_ASSERT_TRUE(PackedFrame::fromBytes(bytes) == frame);
+    }
+    TEST_ASSERT_EQUAL(12, sizeof(frame));
+}
@@ -0,0 +1,215 @@
+#include <unity.h>
+#include "LEDMatrix.h"
+#include "renderer/ScrollEngine.h"
+
+// Counts pushed frames and keeps the last one
+class RecordingMatrix : public LEDMatrix
+{
+public:
+    using LEDMatrix::renderFrame;
+
+    void begin() override {}
+    void clear() override { last.clear(); }
+    void renderFrame(const PackedFrame &frame) override
+    {
+        last = frame;
+        frames++;
+    }
+    void setBrightness(uint8_t) override {}
+    void setTextSize(uint8_t) override {}
+
+    PackedFrame last;
+    uint32_t frames = 0;
+};
+
+// Default5x7: 'H' and 'E' are 5 columns plus 1 of spacing
+static const uint8_t H_FIRST_COLUMN = 0b1111111;
+static const uint8_t E_LAST_COLUMN = 0b1000001;
+static const uint32_t HE_LOOP_STEPS = 12 + PackedFrame::COLUMNS; // text in, then out
+
+void test_scroll_engine_advances_by_time();
+void test_scroll_engine_loops_and_stops();
+void test_scroll_engine_catch_up();
+void test_scroll_engine_swap_text();
+void test_scroll_engine_long_text();
+void test_scroll_engine_scroll_length();
+
+void run_scroll_engine_tests()
+{
+    RUN_TEST(test_scroll_engine_advances_by_time);
+    RUN_TEST(test_scroll_engine_loops_and_stops);
+    RUN_TEST(test_scroll_engine_catch_up);
+    RUN_TEST(test_scroll_engine_swap_text);
+    RUN_TEST(test_scroll_engine_long_text);
+    RUN_TEST(test_scroll_engine_scroll_length);
+}
+
+void test_scroll_engine_advances_by_time()
+{
+    RecordingMatrix matrix;
+    ScrollEngine scroller(&matrix);
+    scroller.setSpeed(100);
+    TEST_ASSERT_TRUE(scroller.isDone());
+
+    scroller.start("HE");
+    TEST_ASSERT_FALSE(scroller.isDone());
+    TEST_ASSERT_TRUE(scroller.update(1000)); // blank first frame
+    TEST_ASSERT_TRUE(matrix.last.isEmpty());
+
+    TEST_ASSERT_FALSE(scroller.update(1099));
+    TEST_ASSERT_TRUE(scroller.update(1100));
+    TEST_ASSERT_EQUAL_HEX8(H_FIRST_COLUMN, matrix.last.column(PackedFrame::COLUMNS - 1));
+    TEST_ASSERT_EQUAL_HEX8(0, matrix.last.column(PackedFrame::COLUMNS - 2));
+
+    // 2.5 columns late: two steps, one push, remainder kept
+    uint32_t pushed = matrix.frames;
+    TEST_ASSERT_TRUE(scroller.update(1350));
+    TEST_ASSERT_EQUAL(pushed + 1, matrix.frames);
+    TEST_ASSERT_EQUAL_HEX8(H_FIRST_COLUMN, matrix.last.column(PackedFrame::COLUMNS - 3));
+    TEST_ASSERT_TRUE(scroller.update(1400));
+    TEST_ASSERT_EQUAL_HEX8(H_FIRST_COLUMN, matrix.last.column(PackedFrame::COLUMNS - 4));
+}
+
+void test_scroll_engine_loops_and_stops()
+{
+    RecordingMatrix matrix;
+    ScrollEngine scroller(&matrix);
+    scroller.setSpeed(100);
+    scroller.setLoopCount(2);
+    scroller.setStopTime(500);
+    scroller.start("HE");
+
+    const uint32_t t0 = 5000;
+    scroller.update(t0);
+
+    // Text fully in after 12 columns: last column of 'E', then its spacing
+    scroller.update(t0 + 1200);
+    TEST_ASSERT_EQUAL_HEX8(E_LAST_COLUMN, matrix.last.column(PackedFrame::COLUMNS - 2));
+
+    // First loop ends blank, then the pause holds the display
+    scroller.update(t0 + HE_LOOP_STEPS * 100);
+    TEST_ASSERT_TRUE(matrix.last.isEmpty());
+    TEST_ASSERT_EQUAL(1, scroller.loopsDone());
+    TEST_ASSERT_FALSE(scroller.update(t0 + HE_LOOP_STEPS * 100 + 499 + 100));
+    TEST_ASSERT_TRUE(scroller.update(t0 + HE_LOOP_STEPS * 100 + 500 + 100));
+    TEST_ASSERT_EQUAL_HEX8(H_FIRST_COLUMN, matrix.last.column(PackedFrame::COLUMNS - 1));
+
+    uint32_t end = t0 + 2 * HE_LOOP_STEPS * 100 + 500;
+    for (uint32_t t = t0 + HE_LOOP_STEPS * 100 + 600; t < end; t += 10)
+        scroller.update(t);
+    TEST_ASSERT_FALSE(scroller.isDone());
+    scroller.update(end);
+    TEST_ASSERT_TRUE(scroller.isDone());
+    TEST_ASSERT_EQUAL(2, scroller.loopsDone());
+    TEST_ASSERT_FALSE(scroller.update(end + 1000));
+
+    scroller.setLoopCount(0);
+    scroller.start("HE");
+    TEST_ASSERT_TRUE(scroller.isDone());
+}
+
+void test_scroll_engine_catch_up()
+{
+    RecordingMatrix matrix;
+    ScrollEngine scroller(&matrix);
+    scroller.setSpeed(50);
+    scroller.start("HELLO");
+    scroller.update(0);
+
+    // A ten second stall moves at most SCROLL_ENGINE_MAX_CATCH_UP columns
+    uint32_t pushed = matrix.frames;
+    TEST_ASSERT_TRUE(scroller.update(10000));
+    TEST_ASSERT_EQUAL(pushed + 1, matrix.frames);
+    TEST_ASSERT_EQUAL_HEX8(H_FIRST_COLUMN, matrix.last.column(PackedFrame::COLUMNS - SCROLL_ENGINE_MAX_CATCH_UP));
+
+    // and carries on from there at the normal rate
+    TEST_ASSERT_FALSE(scroller.update(10049));
+    TEST_ASSERT_TRUE(scroller.update(10050));
+}
+
+void test_scroll_engine_swap_text()
+{
+    RecordingMatrix matrix;
+    ScrollEngine scroller(&matrix);
+    scroller.setSpeed(10);
+    scroller.setLoopCount(1);
+    scroller.start("HE");
+    scroller.update(0);
+    scroller.update(80); // 8 columns in
+
+    PackedFrame before = matrix.last;
+    scroller.setText("OH");
+    TEST_ASSERT_TRUE(matrix.last == before);
+    TEST_ASSERT_EQUAL_STRING("OH", scroller.text().c_str());
+
+    // The screen keeps moving one column per step: a gap, then the new text
+    for (uint8_t gap = 1; gap <= SCROLL_ENGINE_SPACE_WIDTH; gap++)
+    {
+        scroller.update(80 + gap * 10);
+        PackedFrame expected = before;
+        for (uint8_t i = 0; i < gap; i++)
+            expected.shiftLeft(0);
+        TEST_ASSERT_TRUE(matrix.last == expected);
+    }
+    scroller.update(80 + (SCROLL_ENGINE_SPACE_WIDTH + 1) * 10);
+    TEST_ASSERT_EQUAL_HEX8(0b0111110, matrix.last.column(PackedFrame::COLUMNS - 1)); // 'O'
+
+    // The new text runs its own full loop
+    uint32_t t = 80 + (SCROLL_ENGINE_SPACE_WIDTH + 1) * 10;
+    while (!scroller.isDone() && t < 10000)
+        scroller.update(t += 10);
+    TEST_ASSERT_EQUAL(80 + (SCROLL_ENGINE_SPACE_WIDTH + HE_LOOP_STEPS) * 10, t);
+}
+
+// Columns come from the font on demand, so length costs no memory
+void test_scroll_engine_long_text()
+{
+    String text;
+    for (int i = 0; i < 60; i++)
+        text += "HELLO ";
+
+    RecordingMatrix matrix;
+    ScrollEngine scroller(&matrix);
+    scroller.setSpeed(1);
+    scroller.setLoopCount(1);
+    scroller.start(text);
+    scroller.update(0);
+
+    uint32_t t = 0;
+    while (!scroller.isDone() && t < 100000)
+        scroller.update(++t);
+
+    // 5 letters of 6 columns and a 3-column space plus spacing, then scrolled out
+    uint32_t width = 60 * (5 * 6 + 4);
+    TEST_ASSERT_EQUAL(width + PackedFrame::COLUMNS, t);
+    TEST_ASSERT_TRUE(matrix.last.isEmpty());
+
+    String report = "scrolled " + String(width) + " columns, engine " + String((unsigned long)sizeof(ScrollEngine)) + "B";
+    TEST_MESSAGE(report.c_str());
+}
+
+// The loop length is known up front and matches what update() does
+void test_scroll_engine_scroll_length()
+{
+    RecordingMatrix matrix;
+    ScrollEngine scroller(&matrix);
+    scroller.setSpeed(100);
+    scroller.setStopTime(500);
+    scroller.start("HE");
+    TEST_ASSERT_EQUAL(HE_LOOP_STEPS, scroller.scrollLength());
+    TEST_ASSERT_EQUAL(HE_LOOP_STEPS * 100 + 500, scroller.loopDuration());
+
+    // Proportional "1.5": 4 + 3 + 6 columns, then scrolled out
+    scroller.setProportional(true);
+    scroller.setSpeed(1);
+    scroller.setStopTime(0);
+    scroller.setLoopCount(1);
+    scroller.start("1.5");
+    TEST_ASSERT_EQUAL(13 + PackedFrame::COLUMNS, scroller.scrollLength());
+
+    scroller.update(0);
+    uint32_t t = 0;
+    while (!scroller.isDone() && t < 1000)
+        scroller.update(++t);
+    TEST_ASSERT_EQUAL(scroller.scrollLength(), t);
+}
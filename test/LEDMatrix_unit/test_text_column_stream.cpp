@@ -0,0 +1,98 @@
+#include <unity.h>
+#include "renderer/TextColumnStream.h"
+#include "font/Default5x7.h"
+
+// Collect up to max columns; returns how many the stream gave
+static size_t drainColumns(TextColumnStream &stream, uint8_t *out, size_t max)
+{
+    size_t n = 0;
+    uint8_t bits;
+    while (stream.next(bits))
+    {
+        if (n < max)
+            out[n] = bits;
+        n++;
+    }
+    return n;
+}
+
+void test_text_column_stream_glyphs();
+void test_text_column_stream_gaps();
+void test_text_column_stream_long_text();
+
+void run_text_column_stream_tests()
+{
+    RUN_TEST(test_text_column_stream_glyphs);
+    RUN_TEST(test_text_column_stream_gaps);
+    RUN_TEST(test_text_column_stream_long_text);
+}
+
+void test_text_column_stream_glyphs()
+{
+    Default5x7 font;
+    TextColumnStream stream(&font);
+    stream.setText("HE");
+
+    uint8_t columns[16];
+    TEST_ASSERT_EQUAL(12, drainColumns(stream, columns, sizeof(columns)));
+
+    // Each glyph column as stored, then one blank of spacing
+    const char *text = "HE";
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        Glyph glyph;
+        TEST_ASSERT_TRUE(font.getGlyph(text[i], glyph));
+        for (uint8_t col = 0; col < glyph.width; col++)
+            TEST_ASSERT_EQUAL_HEX8(glyph.column(col), columns[i * 6 + col]);
+        TEST_ASSERT_EQUAL_HEX8(0, columns[i * 6 + 5]);
+    }
+
+    // Rewinding replays the same columns
+    stream.rewind();
+    uint8_t again[16];
+    TEST_ASSERT_EQUAL(12, drainColumns(stream, again, sizeof(again)));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(columns, again, 12);
+}
+
+void test_text_column_stream_gaps()
+{
+    TextColumnStream stream;
+    uint8_t columns[32];
+
+    // Space is a narrow glyph; characters the font lacks take TEXT_COLUMN_SPACE_WIDTH blank columns
+    const size_t SPACE = 3 + 1;
+    stream.setText("H \x01H");
+    size_t n = drainColumns(stream, columns, sizeof(columns));
+    TEST_ASSERT_EQUAL(6 + SPACE + TEXT_COLUMN_SPACE_WIDTH + 6, n);
+    for (size_t i = 5; i < 6 + SPACE + TEXT_COLUMN_SPACE_WIDTH; i++)
+        TEST_ASSERT_EQUAL_HEX8(0, columns[i]);
+
+    stream.rewind();
+    stream.insertGap(4);
+    n = drainColumns(stream, columns, sizeof(columns));
+    TEST_ASSERT_EQUAL(4 + 6 + SPACE + TEXT_COLUMN_SPACE_WIDTH + 6, n);
+    TEST_ASSERT_EQUAL_HEX8(0, columns[3]);
+    TEST_ASSERT_EQUAL_HEX8(0b1111111, columns[4]);
+
+    stream.setText("");
+    TEST_ASSERT_EQUAL(0, drainColumns(stream, columns, sizeof(columns)));
+}
+
+// Far wider than the old 128-column render buffer
+void test_text_column_stream_long_text()
+{
+    String text;
+    for (int i = 0; i < 100; i++)
+        text += "HELLO ";
+
+    TextColumnStream stream;
+    stream.setText(text);
+
+    uint8_t last[1];
+    size_t n = drainColumns(stream, last, 0);
+    TEST_ASSERT_EQUAL(100 * (5 * 6 + 4), n);
+
+    String report = "streamed " + String((unsigned long)n) + " columns from " + String(text.length()) +
+                    " chars, stream " + String((unsigned long)sizeof(TextColumnStream)) + "B";
+    TEST_MESSAGE(report.c_str());
+}
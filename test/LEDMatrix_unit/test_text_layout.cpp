@@ -0,0 +1,247 @@
+#include <unity.h>
+#include "font/Default5x7.h"
+#include "font/TableFont.h"
+#include "renderer/DrawEngine.h"
+#include "renderer/TextColumnStream.h"
+#include "renderer/TextLayout.h"
+
+// Uses RLE_TABLE from test_font_table.cpp and PresentCountingMatrix from
+// test_draw_engine.cpp
+
+// Default5x7 with a count of glyph reads
+class CountingFont : public Font
+{
+public:
+    uint8_t lineHeight() const override { return Default5x7::shared().lineHeight(); }
+    uint8_t baseline() const override { return Default5x7::shared().baseline(); }
+    bool getGlyph(char c, Glyph &out) const override
+    {
+        lookups++;
+        return Default5x7::shared().getGlyph(c, out);
+    }
+
+    mutable uint32_t lookups = 0;
+};
+
+// Columns a TextColumnStream emits for text
+static uint16_t streamedColumns(TextColumnStream &stream, const char *text)
+{
+    stream.setText(text);
+    uint16_t columns = 0;
+    uint8_t bits;
+    while (stream.next(bits))
+        columns++;
+    return columns;
+}
+
+void test_text_layout_metrics();
+void test_text_layout_measure();
+void test_text_layout_kerning();
+void test_text_layout_matches_stream();
+void test_text_layout_cache();
+void test_text_layout_draw_engine();
+void test_text_layout_fits_more_proportional();
+
+void run_text_layout_tests()
+{
+    RUN_TEST(test_text_layout_metrics);
+    RUN_TEST(test_text_layout_measure);
+    RUN_TEST(test_text_layout_kerning);
+    RUN_TEST(test_text_layout_matches_stream);
+    RUN_TEST(test_text_layout_cache);
+    RUN_TEST(test_text_layout_draw_engine);
+    RUN_TEST(test_text_layout_fits_more_proportional);
+}
+
+void test_text_layout_metrics()
+{
+    TextLayout layout;
+
+    // Monospaced: every Default5x7 glyph is 5 columns plus 1 of spacing
+    GlyphMetrics m = layout.metrics('1');
+    TEST_ASSERT_EQUAL(0, m.left);
+    TEST_ASSERT_EQUAL(5, m.width);
+    TEST_ASSERT_EQUAL(6, m.advance);
+
+    // Proportional: '1' is inked in columns 1-3
+    layout.setProportional(true);
+    m = layout.metrics('1');
+    TEST_ASSERT_EQUAL(1, m.left);
+    TEST_ASSERT_EQUAL(3, m.width);
+    TEST_ASSERT_EQUAL(4, m.advance);
+
+    m = layout.metrics('!');
+    TEST_ASSERT_EQUAL(2, m.left);
+    TEST_ASSERT_EQUAL(1, m.width);
+    TEST_ASSERT_EQUAL(2, m.advance);
+
+    // Already full width
+    m = layout.metrics('W');
+    TEST_ASSERT_EQUAL(0, m.left);
+    TEST_ASSERT_EQUAL(5, m.width);
+
+    // Space keeps its width; characters the font lacks become a gap
+    m = layout.metrics(' ');
+    TEST_ASSERT_EQUAL(4, m.advance);
+    m = layout.metrics('\x01');
+    TEST_ASSERT_EQUAL(0, m.width);
+    TEST_ASSERT_EQUAL(TEXT_COLUMN_SPACE_WIDTH, m.advance);
+}
+
+void test_text_layout_measure()
+{
+    TextLayout layout;
+    TEST_ASSERT_EQUAL(0, layout.measure(""));
+    TEST_ASSERT_EQUAL(0, layout.measure((const char *)nullptr));
+    TEST_ASSERT_EQUAL(30, layout.measure("12:45"));
+    TEST_ASSERT_EQUAL(30, layout.measure(String("12:45")));
+
+    // 4 + 6 + 2 + 6 + 6
+    layout.setProportional(true);
+    TEST_ASSERT_EQUAL(24, layout.measure("12:45"));
+    TEST_ASSERT_EQUAL(16, layout.measure("1111"));
+
+#if defined(__unix__) || defined(__APPLE__)
+    // Past 16 bits of columns; too much RAM for the board
+    String longText;
+    longText.reserve(12000);
+    for (int i = 0; i < 12000; i++)
+        longText += 'W';
+    TEST_ASSERT_EQUAL(72000UL, layout.measure(longText));
+#endif
+}
+
+void test_text_layout_kerning()
+{
+    TableFont font(RLE_TABLE, 6);
+    TextLayout layout(&font);
+
+    // H+I kern +1; L+H would be -2 but glyphs never overlap; L+I -1
+    TEST_ASSERT_EQUAL(7, layout.advance('H', 'I'));
+    TEST_ASSERT_EQUAL(5, layout.advance('L', 'H'));
+    TEST_ASSERT_EQUAL(5, layout.advance('L', 'I'));
+    TEST_ASSERT_EQUAL(6, layout.advance('L', '\0'));
+    TEST_ASSERT_EQUAL(7 + 4, layout.measure("HI"));
+    TEST_ASSERT_EQUAL(5 + 6, layout.measure("LH"));
+
+    // The stream applies the same pairs: L's last column, then I at once
+    TextColumnStream stream(&font);
+    stream.setText("LI");
+    uint8_t bits;
+    for (uint8_t col = 0; col < 5; col++)
+        TEST_ASSERT_TRUE(stream.next(bits));
+    TEST_ASSERT_EQUAL_HEX8(0x40, bits);
+    TEST_ASSERT_TRUE(stream.next(bits));
+    TEST_ASSERT_EQUAL_HEX8(0x41, bits);
+}
+
+void test_text_layout_matches_stream()
+{
+    const char *texts[] = {"Hi!", "12:45", "a b\x01c", "The quick brown fox", "W"};
+
+    TextColumnStream stream;
+    for (int proportional = 0; proportional < 2; proportional++)
+    {
+        stream.setProportional(proportional);
+        for (const char *text : texts)
+            TEST_ASSERT_EQUAL(stream.layout().measure(text), streamedColumns(stream, text));
+    }
+
+    // Proportional columns are the inked ones: '1' then a blank, '!' then a blank
+    stream.setText("1!");
+    uint8_t expected[] = {0x42, 0x7F, 0x40, 0x00, 0x5F, 0x00};
+    uint8_t bits;
+    for (uint8_t col = 0; col < sizeof(expected); col++)
+    {
+        TEST_ASSERT_TRUE(stream.next(bits));
+        TEST_ASSERT_EQUAL_HEX8(expected[col], bits);
+    }
+    TEST_ASSERT_FALSE(stream.next(bits));
+}
+
+void test_text_layout_cache()
+{
+    CountingFont font;
+    TextLayout layout(&font);
+    layout.setProportional(true);
+
+    // One glyph read per distinct character, then none
+    layout.measure("abcabc");
+    TEST_ASSERT_EQUAL(3, font.lookups);
+    layout.measure("cab");
+    TEST_ASSERT_EQUAL(3, font.lookups);
+
+    // Characters outside the cached range are read every time
+    layout.measure("\x01\x01");
+    TEST_ASSERT_EQUAL(5, font.lookups);
+
+    // The cache belongs to the font: another layout on it reads nothing
+    TextLayout other(&font);
+    other.setProportional(true);
+    other.measure("abc");
+    TEST_ASSERT_EQUAL(5, font.lookups);
+    TEST_ASSERT_TRUE(sizeof(TextLayout) < sizeof(GlyphMetricsCache));
+
+    // One cache per layout mode, each kept when switching between them
+    layout.setProportional(false);
+    layout.measure("a");
+    TEST_ASSERT_EQUAL(6, font.lookups);
+    layout.setProportional(true);
+    layout.setFont(&font);
+    layout.measure("a");
+    TEST_ASSERT_EQUAL(6, font.lookups);
+
+    // A copy of the font fills its own
+    CountingFont copy(font);
+    TextLayout copied(&copy);
+    copied.measure("a");
+    TEST_ASSERT_EQUAL(7, copy.lookups);
+}
+
+void test_text_layout_draw_engine()
+{
+    PresentCountingMatrix matrix;
+    DrawEngine engine(&matrix);
+    engine.setTargetFps(0);
+    engine.setProportional(true);
+    engine.begin();
+
+    // Three '1's fit in 12 columns instead of two
+    engine.drawText("111");
+    TEST_ASSERT_TRUE(engine.present(0));
+    TEST_ASSERT_EQUAL_HEX8(0x7F, matrix.last.column(1));
+    TEST_ASSERT_EQUAL_HEX8(0, matrix.last.column(3));
+    TEST_ASSERT_EQUAL_HEX8(0x7F, matrix.last.column(5));
+    TEST_ASSERT_EQUAL_HEX8(0x7F, matrix.last.column(9));
+    TEST_ASSERT_EQUAL(12, engine.layout().measure("111"));
+
+    // Characters the font lacks leave a gap, as in the stream
+    engine.clear();
+    engine.drawText("\x01" "1");
+    TEST_ASSERT_TRUE(engine.present(1));
+    TEST_ASSERT_EQUAL_HEX8(0x42, matrix.last.column(TEXT_COLUMN_SPACE_WIDTH));
+}
+
+// Proportional spacing puts more characters on the display at once
+void test_text_layout_fits_more_proportional()
+{
+    const char *text = "1.1 lit 11:11, till 1!";
+    TextLayout mono;
+    TextLayout proportional;
+    proportional.setProportional(true);
+
+    // Longest prefix whose inked columns fit on the display; the last
+    // character's spacing may fall off the edge
+    uint8_t fitMono = 0;
+    uint8_t fitProportional = 0;
+    char prefix[32] = {0};
+    for (uint8_t n = 1; text[n - 1] && n < sizeof(prefix); n++)
+    {
+        prefix[n - 1] = text[n - 1];
+        if (mono.measure(prefix) - 1 <= PackedFrame::COLUMNS)
+            fitMono = n;
+        if (proportional.measure(prefix) - 1 <= PackedFrame::COLUMNS)
+            fitProportional = n;
+    }
+    TEST_ASSERT_TRUE(fitProportional > fitMono);
+}
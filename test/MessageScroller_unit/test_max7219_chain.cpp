@@ -0,0 +1,117 @@
+#include <unity.h>
+#include "Max7219Chain.h"
+
+// Pins the chain toggles; nothing needs to be attached
+static const uint8_t CHAIN_DIN = 11;
+static const uint8_t CHAIN_CLK = 13;
+static const uint8_t CHAIN_CS = 10;
+
+void test_max7219_chain_columns();
+void test_max7219_chain_scroll_carries_across_devices();
+void test_max7219_chain_flush_sends_changed_rows();
+void test_max7219_chain_scroll_sends_changed_rows();
+
+void run_max7219_chain_tests()
+{
+    RUN_TEST(test_max7219_chain_columns);
+    RUN_TEST(test_max7219_chain_scroll_carries_across_devices);
+    RUN_TEST(test_max7219_chain_flush_sends_changed_rows);
+    RUN_TEST(test_max7219_chain_scroll_sends_changed_rows);
+}
+
+void test_max7219_chain_columns()
+{
+    Max7219Chain chain(CHAIN_DIN, CHAIN_CLK, CHAIN_CS, 4);
+    TEST_ASSERT_EQUAL(32, chain.width());
+
+    chain.setColumn(0, 0x81);
+    chain.setColumn(9, 0x7E);
+    chain.setColumn(31, 0xFF);
+    chain.setColumn(32, 0xFF); // off the chain
+    TEST_ASSERT_EQUAL_HEX8(0x81, chain.column(0));
+    TEST_ASSERT_EQUAL_HEX8(0x7E, chain.column(9));
+    TEST_ASSERT_EQUAL_HEX8(0xFF, chain.column(31));
+    TEST_ASSERT_EQUAL_HEX8(0, chain.column(1));
+    TEST_ASSERT_EQUAL_HEX8(0, chain.column(32));
+
+    chain.setPixel(0, 9, true);
+    chain.setPixel(1, 9, false);
+    TEST_ASSERT_EQUAL_HEX8(0x7D, chain.column(9));
+
+    chain.clear();
+    TEST_ASSERT_EQUAL_HEX8(0, chain.column(31));
+}
+
+void test_max7219_chain_scroll_carries_across_devices()
+{
+    Max7219Chain chain(CHAIN_DIN, CHAIN_CLK, CHAIN_CS, 3);
+
+    chain.scrollLeft(0xA5);
+    TEST_ASSERT_EQUAL_HEX8(0xA5, chain.column(23));
+
+    // Eight more steps move it onto the middle device, eight after that onto the first
+    for (int i = 0; i < 8; i++)
+        chain.scrollLeft(0);
+    TEST_ASSERT_EQUAL_HEX8(0xA5, chain.column(15));
+    TEST_ASSERT_EQUAL_HEX8(0, chain.column(23));
+    for (int i = 0; i < 15; i++)
+        chain.scrollLeft(0);
+    TEST_ASSERT_EQUAL_HEX8(0xA5, chain.column(0));
+
+    chain.scrollLeft(0);
+    for (int col = 0; col < chain.width(); col++)
+        TEST_ASSERT_EQUAL_HEX8(0, chain.column(col));
+}
+
+void test_max7219_chain_flush_sends_changed_rows()
+{
+    Max7219Chain chain(CHAIN_DIN, CHAIN_CLK, CHAIN_CS, 8);
+    chain.begin();
+    TEST_ASSERT_EQUAL(8, chain.transfers()); // blank frame, one shift per row
+
+    // Static content costs nothing
+    TEST_ASSERT_EQUAL(0, chain.flush());
+
+    // One pixel: one row, for all eight devices in a single shift
+    chain.setPixel(3, 60);
+    TEST_ASSERT_EQUAL(1, chain.flush());
+    TEST_ASSERT_EQUAL(0, chain.flush());
+
+    // Touching every row of several devices is still one shift per row
+    chain.setColumn(0, 0xFF);
+    chain.setColumn(20, 0xFF);
+    chain.setColumn(63, 0x0F);
+    TEST_ASSERT_EQUAL(8, chain.flush());
+
+    // Setting what is already shown sends nothing
+    chain.setColumn(0, 0xFF);
+    TEST_ASSERT_EQUAL(0, chain.flush());
+
+    chain.invalidate();
+    TEST_ASSERT_EQUAL(8, chain.flush());
+}
+
+// Scrolling text-like columns: each flush sends exactly the rows the step changed
+void test_max7219_chain_scroll_sends_changed_rows()
+{
+    Max7219Chain chain(CHAIN_DIN, CHAIN_CLK, CHAIN_CS, 8);
+    chain.begin();
+
+    uint8_t before[8 * MAX7219_MAX_DEVICES];
+    for (uint32_t i = 0; i < 96; i++)
+    {
+        for (int col = 0; col < chain.width(); col++)
+            before[col] = chain.column(col);
+
+        chain.scrollLeft(i % 6 == 5 ? 0 : (uint8_t)(0x3E + i)); // glyph columns, blank every sixth
+
+        uint8_t changed = 0;
+        for (int col = 0; col < chain.width(); col++)
+            changed |= before[col] ^ chain.column(col);
+        uint8_t rows = 0;
+        for (uint8_t r = 0; r < 8; r++)
+            rows += (changed >> r) & 1;
+
+        TEST_ASSERT_EQUAL(rows, chain.flush());
+    }
+}
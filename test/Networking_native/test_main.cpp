@@ -0,0 +1,16 @@
+// Host-side runner: the uploaders against a fake network and FileStorage.
+// pio test -e Networking_native
+#include <Arduino.h>
+#include <unity.h>
+
+#include "../Storage_unit/test_records.cpp"
+#include "../Networking_unit/test_post_print_job.cpp"
+#include "../Networking_unit/test_post_log_backlog.cpp"
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    run_post_print_job_tests();
+    run_post_log_backlog_tests();
+    return UNITY_END();
+}
@@ -0,0 +1,87 @@
+#include <unity.h>
+#include "HTTP/PostLogHttp.h"
+#include "FileStorage.h"
+#include "StorageStream.h"
+
+// Uses ReplayNetwork from test_post_print_job.cpp
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <chrono>
+
+// Records in the replayed backlog. Kept small so every native run stays
+// quick; build with -DPOST_LOG_BACKLOG_RECORDS=1000000 for the full load test
+#ifndef POST_LOG_BACKLOG_RECORDS
+#define POST_LOG_BACKLOG_RECORDS 1000UL
+#endif
+
+#ifndef POST_LOG_BACKLOG_DIR
+#define POST_LOG_BACKLOG_DIR "/tmp"
+#endif
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Offline backlog replay: PostLogHttp loads POST_LOG_BACKLOG_RECORDS queued
+// messages from a file at boot and uploads them once the network is up.
+void test_post_log_backlog_replay()
+{
+    const char *record = "{\"level\":\"info\",\"message\":\"queued while offline\",\"source\":\"load\"}";
+    const size_t recordLen = strlen(record);
+    const size_t capacity = POST_LOG_BACKLOG_RECORDS * (recordLen + 1) + 1;
+
+    String path = String(POST_LOG_BACKLOG_DIR) + "/rumpus_backlog.bin";
+    unlink(path.c_str());
+    FileStorage storage(path.c_str(), capacity);
+    storage.begin();
+
+    // The backlog as an offline PostLogHttp leaves it
+    {
+        StorageStream out(storage);
+        for (unsigned long i = 0; i < POST_LOG_BACKLOG_RECORDS; i++)
+        {
+            if (i > 0)
+                out.write('\n');
+            out.write(reinterpret_cast<const uint8_t *>(record), recordLen);
+        }
+        out.write((uint8_t)'\0');
+        out.flush();
+    }
+
+    ReplayNetwork network;
+    network.client->capture = false;
+    PostLogHttp uploader(network, nullptr, "/log", true, &storage);
+
+    auto start = std::chrono::steady_clock::now();
+    uploader.begin();
+    double loadSeconds = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    uploader.processQueue();
+    double replaySeconds = secondsSince(start);
+
+    String report = "records=" + String(POST_LOG_BACKLOG_RECORDS) +
+                    " mapped=" + String(storage.isMapped()) +
+                    " loadRecords/s=" + String((unsigned long)(POST_LOG_BACKLOG_RECORDS / loadSeconds)) +
+                    " replayRecords/s=" + String((unsigned long)(POST_LOG_BACKLOG_RECORDS / replaySeconds));
+    TEST_MESSAGE(report.c_str());
+
+    // Every record went out once and nothing is left queued
+    TEST_ASSERT_EQUAL(POST_LOG_BACKLOG_RECORDS, network.client->requests);
+    TEST_ASSERT_EQUAL(0, StorageRecords::usedLength(storage));
+    storage.close();
+    unlink(path.c_str());
+}
+
+void run_post_log_backlog_tests()
+{
+    RUN_TEST(test_post_log_backlog_replay);
+}
+
+#else
+
+// FileStorage needs a POSIX host; nothing to run on the board
+void run_post_log_backlog_tests() {}
+
+#endif
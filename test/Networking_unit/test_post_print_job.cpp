@@ -0,0 +1,222 @@
+#include <unity.h>
+#include "HTTP/PostPrintJobHttp.h"
+#include "StorageRecords.h"
+
+// Uses RamStorage from test_records.cpp
+
+// RamStorage that keeps its contents across begin(), like EEPROM across a reboot
+class RebootRamStorage : public RamStorage
+{
+public:
+    RebootRamStorage() { clear(); }
+    void begin() override {}
+};
+
+// Records the request bytes and answers every request with a canned reply;
+// "connected" while the network is up
+class ReplayClient : public NetworkClient
+{
+public:
+    String sent;
+    String reply = "HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n";
+    bool up = true;
+    bool capture = true;  ///< Keep the request bytes in sent
+    size_t requests = 0;  ///< Connections opened, one per request
+
+    int connect(IPAddress, uint16_t) override { return open(); }
+    int connect(const char *, uint16_t) override { return open(); }
+    size_t write(uint8_t c) override
+    {
+        if (capture)
+            sent += (char)c;
+        return 1;
+    }
+    size_t write(const uint8_t *buf, size_t len) override
+    {
+        for (size_t i = 0; capture && i < len; i++)
+            sent += (char)buf[i];
+        return len;
+    }
+    int available() override { return _open ? reply.length() - _pos : 0; }
+    int read() override
+    {
+        if (!_open || _pos >= reply.length())
+            return -1;
+        int c = (uint8_t)reply[_pos++];
+        _closing = _pos == reply.length();
+        return c;
+    }
+    int read(uint8_t *buf, size_t len) override
+    {
+        size_t n = 0;
+        int c;
+        while (n < len && (c = read()) >= 0)
+            buf[n++] = c;
+        return n;
+    }
+    int peek() override { return _open && _pos < reply.length() ? (uint8_t)reply[_pos] : -1; }
+    void flush() override {}
+    void stop() override { _open = false; }
+    uint8_t connected() override
+    {
+        // The server closes after its reply; reported once, then idle again
+        if (_closing)
+        {
+            _closing = false;
+            _open = false;
+            return 0;
+        }
+        return up;
+    }
+    operator bool() override { return up; }
+
+private:
+    bool _open = false;
+    bool _closing = false;
+    size_t _pos = 0;
+
+    int open()
+    {
+        if (!up)
+            return 0;
+        _open = true;
+        _pos = 0;
+        requests++;
+        return 1;
+    }
+};
+
+class ReplayNetwork : public NetworkManager
+{
+public:
+    ReplayClient *client = new ReplayClient();
+
+    ReplayNetwork()
+    {
+        client->setRemote("printer.local", 80);
+        setClient(client);
+    }
+    void begin() override {}
+    void maintainConnection() override {}
+    void printStatus() override {}
+    int getStatus() const override { return client->up; }
+    bool isConnected() override { return client->up; }
+    void setRemote(const char *host, uint16_t port) override { client->setRemote(host, port); }
+    void setRemote(IPAddress ip, uint16_t port) override { client->setRemote(ip, port); }
+};
+
+// Idempotency-Key header values in the requests sent so far
+static String sentKeys(ReplayClient &client)
+{
+    const String header = "Idempotency-Key: ";
+    String keys;
+    for (int at = client.sent.indexOf(header); at >= 0; at = client.sent.indexOf(header, at + 1))
+    {
+        int start = at + header.length();
+        keys += client.sent.substring(start, client.sent.indexOf('\r', start)) + "|";
+    }
+    return keys;
+}
+
+void test_print_job_keys_unique_across_restart();
+void test_print_job_no_key_without_persisted_ids();
+void test_print_job_legacy_records();
+void test_print_job_drops_corrupt_records();
+
+void run_post_print_job_tests()
+{
+    RUN_TEST(test_print_job_keys_unique_across_restart);
+    RUN_TEST(test_print_job_no_key_without_persisted_ids);
+    RUN_TEST(test_print_job_legacy_records);
+    RUN_TEST(test_print_job_drops_corrupt_records);
+}
+
+void test_print_job_keys_unique_across_restart()
+{
+    RebootRamStorage storage;
+    String keys;
+
+    // Two boots on the same storage
+    for (int boot = 0; boot < 2; boot++)
+    {
+        ReplayNetwork network;
+        PostPrintJobHttp jobs(network, nullptr, "/print", true, &storage);
+        jobs.setIdempotencyPrefix("dev1-");
+        jobs.begin();
+        for (int i = 0; i < 3; i++)
+            jobs.enqueueJob("{\"job\":" + String(i) + "}");
+        keys += sentKeys(*network.client);
+    }
+
+    TEST_ASSERT_EQUAL_STRING("dev1-1|dev1-2|dev1-3|dev1-13|dev1-14|dev1-15|", keys.c_str());
+}
+
+void test_print_job_no_key_without_persisted_ids()
+{
+    // IDs restart at 1 on every boot: no key rather than a repeated one
+    ReplayNetwork network;
+    PostPrintJobHttp jobs(network);
+    jobs.setIdempotencyPrefix("dev1-");
+    jobs.begin();
+    jobs.enqueueJob("{\"job\":1}");
+    TEST_ASSERT_EQUAL_STRING("", sentKeys(*network.client).c_str());
+    TEST_ASSERT_EQUAL_STRING("", jobs.idempotencyKey(1).c_str());
+
+    // Persisted IDs without a prefix would still collide across devices
+    RebootRamStorage storage;
+    PostPrintJobHttp unprefixed(network, nullptr, "/print", true, &storage);
+    unprefixed.begin();
+    unprefixed.enqueueJob("{\"job\":2}");
+    TEST_ASSERT_EQUAL_STRING("", sentKeys(*network.client).c_str());
+}
+
+void test_print_job_legacy_records()
+{
+    RebootRamStorage storage;
+
+    // Untagged records from older firmware, two starting with tag letters
+    StorageRecords::append(storage, "John's latte");
+    StorageRecords::append(storage, "Add:2");
+    StorageRecords::append(storage, "N");
+
+    ReplayNetwork network;
+    network.client->up = false;
+    PostPrintJobHttp jobs(network, nullptr, "/print", true, &storage);
+    jobs.setIdempotencyPrefix("dev1-");
+    jobs.begin();
+
+    // All three are queued again under fresh IDs and delivered in order
+    network.client->up = true;
+    jobs.processQueue();
+    String &sent = network.client->sent;
+    int latte = sent.indexOf("\r\n\r\nJohn's latte");
+    int add = sent.indexOf("\r\n\r\nAdd:2");
+    int n = sent.indexOf("\r\n\r\nN");
+    TEST_ASSERT_TRUE(latte >= 0);
+    TEST_ASSERT_TRUE(add > latte);
+    TEST_ASSERT_TRUE(n > add);
+    TEST_ASSERT_EQUAL_STRING("dev1-1|dev1-2|dev1-3|", sentKeys(*network.client).c_str());
+}
+
+void test_print_job_drops_corrupt_records()
+{
+    RebootRamStorage storage;
+
+    // A packed record whose stream ends after its flag byte, between two good ones
+    StorageRecords::append(storage, "John's latte");
+    StorageRecords::append(storage, "\x1A\x01");
+    StorageRecords::append(storage, "Add:2");
+
+    ReplayNetwork network;
+    network.client->up = false;
+    PostPrintJobHttp jobs(network, nullptr, "/print", true, &storage);
+    jobs.setIdempotencyPrefix("dev1-");
+    jobs.begin();
+
+    // Only the two good jobs are sent; no empty post for the corrupt one
+    network.client->up = true;
+    jobs.processQueue();
+    TEST_ASSERT_EQUAL(2, network.client->requests);
+    TEST_ASSERT_EQUAL_STRING("dev1-1|dev1-2|", sentKeys(*network.client).c_str());
+    TEST_ASSERT_EQUAL(-1, network.client->sent.indexOf("\r\n\r\n\x1A"));
+}
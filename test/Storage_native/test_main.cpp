@@ -0,0 +1,15 @@
+// Host-side runner: FileStorage and the record log on Linux/macOS.
+// pio test -e Storage_native
+#include <Arduino.h>
+#include <unity.h>
+
+#include "../Storage_unit/test_records.cpp"
+#include "../Storage_unit/test_file_storage.cpp"
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    run_storage_record_tests();
+    run_file_storage_tests();
+    return UNITY_END();
+}
@@ -0,0 +1,89 @@
+#include <unity.h>
+#include "FileStorage.h"
+#include "StorageRecords.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#ifndef FILE_STORAGE_TEST_DIR
+#define FILE_STORAGE_TEST_DIR "/tmp"
+#endif
+
+static String testPath(const char *name)
+{
+    String path = String(FILE_STORAGE_TEST_DIR) + "/rumpus_" + name + ".bin";
+    unlink(path.c_str());
+    return path;
+}
+
+void test_file_storage_persists()
+{
+    String path = testPath("persist");
+    for (int mapped = 0; mapped < 2; mapped++)
+    {
+        {
+            FileStorage storage(path.c_str(), 4096, mapped);
+            storage.begin();
+            storage.clear();
+            TEST_ASSERT_EQUAL(mapped == 1, storage.isMapped());
+            StorageRecords::append(storage, "alpha");
+            StorageRecords::append(storage, "beta");
+        }
+
+        FileStorage reopened(path.c_str(), 4096, mapped);
+        reopened.begin();
+        TEST_ASSERT_EQUAL_STRING("alpha\nbeta", reopened.load().c_str());
+        TEST_ASSERT_EQUAL(4096, reopened.size());
+    }
+}
+
+void test_file_storage_torn_write()
+{
+    String path = testPath("torn");
+    FileStorage storage(path.c_str(), 256);
+    storage.begin();
+    StorageRecords::append(storage, "first");
+
+    // Power fails three bytes into the next append
+    storage.failAfterBytes(3);
+    StorageRecords::append(storage, "second");
+    TEST_ASSERT_TRUE(storage.powerLost());
+    StorageRecords::append(storage, "third");
+    storage.close();
+
+    FileStorage reopened(path.c_str(), 256);
+    reopened.begin();
+    String first;
+    size_t count = StorageRecords::forEach(reopened, [&](const String &record)
+                                           { if (first.length() == 0) first = record; });
+    TEST_ASSERT_EQUAL_STRING("first", first.c_str());
+    TEST_ASSERT_EQUAL(2, count); // "first" plus the torn "se"
+}
+
+void test_file_storage_disk_full()
+{
+    String path = testPath("full");
+    FileStorage storage(path.c_str(), 256, false);
+    storage.begin();
+    storage.setDiskFull(8);
+
+    const uint8_t data[16] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
+    TEST_ASSERT_EQUAL(8, storage.write(0, data, sizeof(data)));
+    TEST_ASSERT_EQUAL(0, storage.write(8, data, sizeof(data)));
+
+    storage.resetFaults();
+    TEST_ASSERT_EQUAL(16, storage.write(8, data, sizeof(data)));
+    TEST_ASSERT_EQUAL(24, storage.bytesWritten());
+}
+
+void run_file_storage_tests()
+{
+    RUN_TEST(test_file_storage_persists);
+    RUN_TEST(test_file_storage_torn_write);
+    RUN_TEST(test_file_storage_disk_full);
+}
+
+#else
+
+// FileStorage needs a POSIX host; nothing to run on the board
+void run_file_storage_tests() {}
+
+#endif
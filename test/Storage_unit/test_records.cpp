@@ -0,0 +1,147 @@
+#include <unity.h>
+#include "StorageRecords.h"
+
+// Plain RAM backend; exercises the byte-range interface directly.
+class RamStorage : public Storage
+{
+public:
+    static const size_t SIZE = 64;
+    uint8_t bytes[SIZE];
+    size_t writes = 0;    ///< write() calls, i.e. commits on a page-based backend
+    size_t bytesRead = 0; ///< Bytes handed out by read()
+
+    void begin() override { clear(); }
+    void clear() override { memset(bytes, 0, SIZE); }
+    size_t size() const override { return SIZE; }
+
+    size_t read(size_t offset, uint8_t *buf, size_t len) override
+    {
+        if (offset >= SIZE)
+            return 0;
+        len = min(len, SIZE - offset);
+        memcpy(buf, bytes + offset, len);
+        bytesRead += len;
+        return len;
+    }
+
+    size_t write(size_t offset, const uint8_t *buf, size_t len) override
+    {
+        if (offset >= SIZE)
+            return 0;
+        len = min(len, SIZE - offset);
+        memcpy(bytes + offset, buf, len);
+        writes++;
+        return len;
+    }
+};
+
+static String joinRecords(Storage &storage)
+{
+    String joined;
+    StorageRecords::forEach(storage, [&joined](const String &record)
+                            { joined += record + "|"; });
+    return joined;
+}
+
+void test_records_append_and_iterate();
+void test_records_drop_oldest_when_full();
+void test_records_one_write_per_append();
+void test_records_cached_end();
+
+void run_storage_record_tests()
+{
+    RUN_TEST(test_records_append_and_iterate);
+    RUN_TEST(test_records_drop_oldest_when_full);
+    RUN_TEST(test_records_one_write_per_append);
+    RUN_TEST(test_records_cached_end);
+}
+
+void test_records_append_and_iterate()
+{
+    RamStorage storage;
+    storage.begin();
+
+    StorageRecords::append(storage, "alpha");
+    StorageRecords::append(storage, "beta");
+    TEST_ASSERT_EQUAL_STRING("alpha\nbeta", storage.load().c_str());
+    TEST_ASSERT_EQUAL_STRING("alpha|beta|", joinRecords(storage).c_str());
+    TEST_ASSERT_EQUAL(10, StorageRecords::usedLength(storage));
+}
+
+void test_records_drop_oldest_when_full()
+{
+    RamStorage storage;
+    storage.begin();
+
+    // 20-byte records; the 64-byte region holds three of them
+    StorageRecords::append(storage, "record-0000000000001");
+    StorageRecords::append(storage, "record-0000000000002");
+    StorageRecords::append(storage, "record-0000000000003");
+    StorageRecords::append(storage, "record-0000000000004");
+
+    TEST_ASSERT_EQUAL_STRING("record-0000000000002|record-0000000000003|record-0000000000004|",
+                             joinRecords(storage).c_str());
+
+    String oversized;
+    for (size_t i = 0; i < RamStorage::SIZE; i++)
+        oversized += 'x';
+    TEST_ASSERT_FALSE(StorageRecords::append(storage, oversized));
+}
+
+// Appending, with or without dropping records, is a single write() so a
+// page-committing backend commits once per record
+void test_records_one_write_per_append()
+{
+    RamStorage storage;
+    storage.begin();
+
+    for (int i = 0; i < 10; i++)
+    {
+        size_t before = storage.writes;
+        TEST_ASSERT_TRUE(StorageRecords::append(storage, String("record-000000000000") + String(i)));
+        TEST_ASSERT_EQUAL(1, storage.writes - before);
+    }
+    TEST_ASSERT_EQUAL_STRING("record-0000000000007|record-0000000000008|record-0000000000009|",
+                             joinRecords(storage).c_str());
+
+    // A record that needs every older one dropped
+    String big;
+    for (size_t i = 0; i < RamStorage::SIZE - 1; i++)
+        big += 'y';
+    size_t before = storage.writes;
+    TEST_ASSERT_TRUE(StorageRecords::append(storage, big));
+    TEST_ASSERT_EQUAL(1, storage.writes - before);
+    TEST_ASSERT_EQUAL_STRING((big + "|").c_str(), joinRecords(storage).c_str());
+}
+
+// With the end cached, an append that drops nothing reads nothing back
+void test_records_cached_end()
+{
+    RamStorage storage;
+    storage.begin();
+
+    size_t end = StorageRecords::UNKNOWN_END;
+    TEST_ASSERT_TRUE(StorageRecords::append(storage, "alpha", end));
+    TEST_ASSERT_EQUAL(StorageRecords::usedLength(storage), end);
+
+    size_t before = storage.bytesRead;
+    TEST_ASSERT_TRUE(StorageRecords::append(storage, "beta", end));
+    TEST_ASSERT_EQUAL(0, storage.bytesRead - before);
+    TEST_ASSERT_EQUAL(10, end);
+
+    // Dropping records still lands on the right end
+    for (int i = 0; i < 5; i++)
+    {
+        TEST_ASSERT_TRUE(StorageRecords::append(storage, String("record-000000000000") + String(i), end));
+        TEST_ASSERT_EQUAL(StorageRecords::usedLength(storage), end);
+    }
+    TEST_ASSERT_EQUAL_STRING("record-0000000000002|record-0000000000003|record-0000000000004|",
+                             joinRecords(storage).c_str());
+
+    // A failed append forgets the end rather than trusting it
+    String oversized;
+    for (size_t i = 0; i < RamStorage::SIZE; i++)
+        oversized += 'x';
+    TEST_ASSERT_FALSE(StorageRecords::append(storage, oversized, end));
+    TEST_ASSERT_EQUAL(StorageRecords::UNKNOWN_END, end);
+}
@@ -0,0 +1,217 @@
+#include <unity.h>
+#include "WearLevelStorage.h"
+#include "StorageRecords.h"
+
+#ifndef WEAR_SIM_OPERATIONS
+#define WEAR_SIM_OPERATIONS 1000000UL
+#endif
+
+// In-memory EEPROM with per-cell wear counters. A write that needs to set
+// a bit that is currently 0 is counted as an erase as well (flash/EEPROM
+// cells can only clear bits without an erase cycle).
+struct MockEeprom
+{
+    static const size_t SIZE = 512;
+    uint8_t cells[SIZE];
+    uint32_t writes[SIZE];
+    uint32_t erases[SIZE];
+    long writesUntilPowerLoss = -1; // -1 = never
+
+    MockEeprom() { reset(); }
+
+    void reset()
+    {
+        for (size_t i = 0; i < SIZE; i++)
+        {
+            cells[i] = 0xFF;
+            writes[i] = 0;
+            erases[i] = 0;
+        }
+        writesUntilPowerLoss = -1;
+    }
+
+    void begin(size_t) {}
+    uint8_t read(size_t addr) { return cells[addr]; }
+    bool commit() { return true; }
+
+    void write(size_t addr, uint8_t value)
+    {
+        if (writesUntilPowerLoss == 0)
+            return; // power is gone, nothing reaches the cells
+        if (writesUntilPowerLoss > 0)
+            writesUntilPowerLoss--;
+
+        if ((cells[addr] & value) != value)
+            erases[addr]++;
+        writes[addr]++;
+        cells[addr] = value;
+    }
+};
+
+static MockEeprom mockEeprom;
+
+void test_wear_level_roundtrip();
+void test_wear_level_clear();
+void test_wear_level_torn_write();
+void test_wear_level_torn_recycled_page();
+void test_wear_level_simulation();
+void test_wear_level_record_log();
+
+void run_storage_tests()
+{
+    RUN_TEST(test_wear_level_roundtrip);
+    RUN_TEST(test_wear_level_clear);
+    RUN_TEST(test_wear_level_torn_write);
+    RUN_TEST(test_wear_level_torn_recycled_page);
+    RUN_TEST(test_wear_level_simulation);
+    RUN_TEST(test_wear_level_record_log);
+}
+
+void test_wear_level_roundtrip()
+{
+    mockEeprom.reset();
+    WearLevelStorageT<MockEeprom> storage(mockEeprom, MockEeprom::SIZE);
+    storage.begin();
+    TEST_ASSERT_EQUAL(0, storage.load().length());
+
+    storage.save("first");
+    storage.save("second");
+
+    WearLevelStorageT<MockEeprom> reopened(mockEeprom, MockEeprom::SIZE);
+    reopened.begin();
+    TEST_ASSERT_EQUAL_STRING("second", reopened.load().c_str());
+    TEST_ASSERT_EQUAL_UINT32(2, reopened.sequence());
+}
+
+void test_wear_level_clear()
+{
+    mockEeprom.reset();
+    WearLevelStorageT<MockEeprom> storage(mockEeprom, MockEeprom::SIZE);
+    storage.begin();
+    storage.save("queued");
+
+    uint32_t before = 0;
+    for (size_t i = 0; i < MockEeprom::SIZE; i++)
+        before += mockEeprom.writes[i];
+
+    storage.clear();
+
+    uint32_t after = 0;
+    for (size_t i = 0; i < MockEeprom::SIZE; i++)
+        after += mockEeprom.writes[i];
+
+    TEST_ASSERT_EQUAL(0, storage.load().length());
+    TEST_ASSERT_LESS_OR_EQUAL(WearLevelStorageT<MockEeprom>::HEADER_SIZE, after - before);
+}
+
+void test_wear_level_torn_write()
+{
+    mockEeprom.reset();
+    WearLevelStorageT<MockEeprom> storage(mockEeprom, MockEeprom::SIZE);
+    storage.begin();
+    storage.save("committed");
+
+    // Lose power part-way through the payload of the next page
+    mockEeprom.writesUntilPowerLoss = 5;
+    storage.save("this write never completes");
+    mockEeprom.writesUntilPowerLoss = -1;
+
+    WearLevelStorageT<MockEeprom> reopened(mockEeprom, MockEeprom::SIZE);
+    reopened.begin();
+    TEST_ASSERT_EQUAL_STRING("committed", reopened.load().c_str());
+
+    // The next save must still succeed and win over the torn page
+    reopened.save("recovered");
+    WearLevelStorageT<MockEeprom> again(mockEeprom, MockEeprom::SIZE);
+    again.begin();
+    TEST_ASSERT_EQUAL_STRING("recovered", again.load().c_str());
+}
+
+// A recycled slot still carries its old marker; the CRC must reject it
+void test_wear_level_torn_recycled_page()
+{
+    typedef WearLevelStorageT<MockEeprom> Store;
+    mockEeprom.reset();
+    Store storage(mockEeprom, MockEeprom::SIZE);
+    storage.begin();
+    for (uint8_t i = 0; i < Store::DEFAULT_PAGES; i++)
+        storage.save(String("page ") + i);
+
+    mockEeprom.writesUntilPowerLoss = 5;
+    storage.save("this write never completes");
+    mockEeprom.writesUntilPowerLoss = -1;
+    TEST_ASSERT_EQUAL(Store::PAGE_MAGIC, mockEeprom.read(0));
+
+    Store reopened(mockEeprom, MockEeprom::SIZE);
+    reopened.begin();
+    TEST_ASSERT_EQUAL_STRING("page 3", reopened.load().c_str());
+}
+
+// Replays the offline queue pattern (append record, trim, save) and reports
+// per-cell wear. Every cell in use should see roughly 1/pages of the saves.
+void test_wear_level_simulation()
+{
+    mockEeprom.reset();
+    WearLevelStorageT<MockEeprom> storage(mockEeprom, MockEeprom::SIZE);
+    storage.begin();
+
+    for (unsigned long op = 0; op < WEAR_SIM_OPERATIONS; op++)
+    {
+        if (op % 8 == 0)
+        {
+            storage.clear(); // queue drained
+            continue;
+        }
+
+        String stored = storage.load();
+        if (stored.length() > 0)
+            stored += '\n';
+        stored += "{\"level\":\"info\",\"n\":";
+        stored += String(op);
+        stored += "}";
+        if (stored.length() > storage.capacity())
+            stored = stored.substring(stored.length() - storage.capacity());
+        storage.save(stored);
+    }
+
+    uint32_t maxWrites = 0, maxErases = 0, touched = 0;
+    for (size_t i = 0; i < MockEeprom::SIZE; i++)
+    {
+        if (mockEeprom.writes[i] > 0)
+            touched++;
+        maxWrites = max(maxWrites, mockEeprom.writes[i]);
+        maxErases = max(maxErases, mockEeprom.erases[i]);
+    }
+
+    String report = "ops=" + String(WEAR_SIM_OPERATIONS) +
+                    " cellsTouched=" + String(touched) +
+                    " maxWritesPerCell=" + String(maxWrites) +
+                    " maxErasesPerCell=" + String(maxErases);
+    TEST_MESSAGE(report.c_str());
+
+    // The busiest cell must not carry more than its page's share of the load
+    TEST_ASSERT_LESS_OR_EQUAL(WEAR_SIM_OPERATIONS / WearLevelStorageT<MockEeprom>::DEFAULT_PAGES + 1, maxWrites);
+    WearLevelStorageT<MockEeprom> reopened(mockEeprom, MockEeprom::SIZE);
+    reopened.begin();
+    TEST_ASSERT_EQUAL_STRING(storage.load().c_str(), reopened.load().c_str());
+}
+
+// The record log on top: one page commit per append, also once records drop
+void test_wear_level_record_log()
+{
+    mockEeprom.reset();
+    WearLevelStorageT<MockEeprom> storage(mockEeprom, MockEeprom::SIZE);
+    storage.begin();
+
+    for (int i = 0; i < 40; i++)
+        TEST_ASSERT_TRUE(StorageRecords::append(storage, String("{\"n\":") + String(i) + "}"));
+    TEST_ASSERT_EQUAL_UINT32(40, storage.sequence());
+
+    // The newest records survive a reboot
+    WearLevelStorageT<MockEeprom> reopened(mockEeprom, MockEeprom::SIZE);
+    reopened.begin();
+    String last;
+    StorageRecords::forEach(reopened, [&last](const String &record)
+                            { last = record; });
+    TEST_ASSERT_EQUAL_STRING("{\"n\":39}", last.c_str());
+}
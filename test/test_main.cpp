@@ -3,12 +3,58 @@
 
 #include "RumpshiftLogger_unit/test_logger.cpp"
 #include "WiFiNetworkManager_unit/test_wifi.cpp"
+#include "Storage_unit/test_wear_level.cpp"
+#include "Storage_unit/test_records.cpp"
+#include "Storage_unit/test_file_storage.cpp"
+#include "Networking_unit/test_post_print_job.cpp"
+#include "Networking_unit/test_post_log_backlog.cpp"
+#include "Compression_unit/test_lz_codec.cpp"
+#include "JsonDocument_unit/test_json_copy.cpp"
+#include "JsonDocument_unit/test_json_views.cpp"
+#include "JsonDocument_unit/test_json_stream.cpp"
+#include "JsonDocument_unit/test_json_pool.cpp"
+#include "JsonDocument_unit/test_json_codec.cpp"
+#include "JsonDocument_unit/test_msgpack.cpp"
+#include "JsonDocument_unit/test_json_typed.cpp"
+#include "JsonDocument_unit/test_json_selector.cpp"
+#include "JsonDocument_unit/test_json_merge_patch.cpp"
+#include "LEDMatrix_unit/test_packed_frame.cpp"
+#include "LEDMatrix_unit/test_scroll_engine.cpp"
+#include "LEDMatrix_unit/test_text_column_stream.cpp"
+#include "LEDMatrix_unit/test_font_table.cpp"
+#include "LEDMatrix_unit/test_draw_engine.cpp"
+#include "LEDMatrix_unit/test_animation.cpp"
+#include "LEDMatrix_unit/test_text_layout.cpp"
+#include "MessageScroller_unit/test_max7219_chain.cpp"
 
 void setup()
 {
     UNITY_BEGIN();
     run_logger_tests();
     run_wifi_tests();
+    run_storage_tests();
+    run_storage_record_tests();
+    run_file_storage_tests();
+    run_post_print_job_tests();
+    run_post_log_backlog_tests();
+    run_lz_codec_tests();
+    run_json_copy_tests();
+    run_json_view_tests();
+    run_json_stream_tests();
+    run_json_pool_tests();
+    run_json_codec_tests();
+    run_msgpack_tests();
+    run_json_typed_tests();
+    run_json_selector_tests();
+    run_json_merge_patch_tests();
+    run_packed_frame_tests();
+    run_scroll_engine_tests();
+    run_text_column_stream_tests();
+    run_font_table_tests();
+    run_draw_engine_tests();
+    run_animation_tests();
+    run_text_layout_tests();
+    run_max7219_chain_tests();
     UNITY_END();
 }
 
@@ -0,0 +1,375 @@
+#!/usr/bin/env python3
+"""animc - compile a sprite sheet into a compressed LEDMatrix animation.
+
+Reads 12x8 frames from a sprite sheet and writes a header with an
+AnimationData asset for AnimationPlayer (libraries/LEDMatrix/src/anim).
+Each frame is stored as the change from the previous one, in whichever
+of three encodings is smallest (see AnimationData.h):
+
+  toggles   list of pixels that flip
+  mask      12-bit mask of changed bytes, then those bytes XORed
+  rle       run-length coded XOR of the whole frame
+
+Durations are stored only when they change, and identical consecutive
+frames are merged into one longer frame.
+
+Sheets:
+  .txt      '#' = lit, anything else = off; frames side by side separated
+            by one column, rows of frames separated by blank lines, lines
+            starting "# " are comments. This is the strip
+            VirtualLEDMatrix::writeAscii() writes, and its
+            "# N frames: t0 t1 ... ms" line supplies the durations.
+  .pbm/.pgm/.ppm  Netpbm (P1-P6), frames laid out on a grid
+  .png etc. Any format Pillow can read (pip install pillow)
+
+Examples:
+    animc.py sheets/boot_spinner.txt --name BootSpinner --duration 60 \\
+        -o ../../libraries/LEDMatrix/src/anim/BootSpinner.h
+    animc.py status.png --name Status --gap 1 --durations 200,200,600
+"""
+
+import argparse
+import os
+import re
+import sys
+
+COLUMNS = 12
+ROWS = 8
+FRAME_BYTES = COLUMNS * ROWS // 8
+
+MODE_TOGGLES = 0
+MODE_MASK = 1
+MODE_RLE = 2
+DURATION_FOLLOWS = 0x80
+MAX_TOGGLES = 31
+
+
+class SheetError(Exception):
+    pass
+
+
+# --------------------------------------------------------------------------
+# Sheets -> list of frames (each a list of ROWS strings of '#'/'.')
+# --------------------------------------------------------------------------
+
+def load_text(path):
+    """Frames and timestamps (or None) from an ASCII strip."""
+    times = None
+    blocks = []
+    block = []
+    with open(path, "r", encoding="utf-8") as f:
+        for line in f:
+            line = line.rstrip("\n")
+            if line.startswith("//"):
+                continue
+            header = re.match(r"# \d+ frames:(.*)", line)
+            if header:
+                # writeAscii()'s timestamp line; any other '#' line is pixels
+                times = [int(t) for t in re.findall(r"-?\d+", header.group(1))]
+                continue
+            if not line.strip():
+                if block:
+                    blocks.append(block)
+                    block = []
+                continue
+            block.append(line)
+    if block:
+        blocks.append(block)
+
+    frames = []
+    for block in blocks:
+        if len(block) != ROWS:
+            raise SheetError("%s: frame rows must come in blocks of %d lines (got %d)" % (path, ROWS, len(block)))
+        width = max(len(line) for line in block)
+        for x in range(0, width, COLUMNS + 1):
+            frame = []
+            for line in block:
+                cells = line[x:x + COLUMNS].ljust(COLUMNS, ".")
+                frame.append("".join("#" if ch == "#" else "." for ch in cells))
+            frames.append(frame)
+    return frames, times
+
+
+def read_netpbm(path):
+    """(width, height, pixel(x, y) -> lit) for P1-P6."""
+    with open(path, "rb") as f:
+        data = f.read()
+
+    pos = 0
+
+    def token():
+        nonlocal pos
+        while pos < len(data):
+            ch = data[pos:pos + 1]
+            if ch == b"#":
+                while pos < len(data) and data[pos:pos + 1] not in (b"\n", b"\r"):
+                    pos += 1
+            elif ch.isspace():
+                pos += 1
+            else:
+                break
+        start = pos
+        while pos < len(data) and not data[pos:pos + 1].isspace():
+            pos += 1
+        return data[start:pos].decode("ascii")
+
+    magic = token()
+    if magic not in ("P1", "P2", "P3", "P4", "P5", "P6"):
+        raise SheetError("%s: not a Netpbm file" % path)
+    width, height = int(token()), int(token())
+    maxval = 1 if magic in ("P1", "P4") else int(token())
+    pos += 1  # single whitespace before binary data
+
+    lit = [[False] * width for _ in range(height)]
+    if magic == "P1":
+        bits = [c for c in data[pos:].decode("ascii") if c in "01"]
+        for i in range(width * height):
+            lit[i // width][i % width] = bits[i] == "1"
+    elif magic == "P4":
+        stride = (width + 7) // 8
+        for y in range(height):
+            row = data[pos + y * stride:pos + (y + 1) * stride]
+            for x in range(width):
+                lit[y][x] = bool(row[x // 8] & (0x80 >> (x % 8)))
+    else:
+        channels = 3 if magic in ("P3", "P6") else 1
+        if magic in ("P2", "P3"):
+            values = [int(v) for v in data[pos:].split()]
+        else:
+            step = 2 if maxval > 255 else 1
+            raw = data[pos:]
+            values = [int.from_bytes(raw[i:i + step], "big") for i in range(0, len(raw), step)]
+        for y in range(height):
+            for x in range(width):
+                i = (y * width + x) * channels
+                level = max(values[i:i + channels]) if channels == 3 else values[i]
+                lit[y][x] = level * 2 > maxval
+    return width, height, lambda x, y: lit[y][x]
+
+
+def read_image(path, threshold):
+    try:
+        from PIL import Image
+    except ImportError:
+        raise SheetError("%s needs Pillow (pip install pillow); or use a .txt or Netpbm sheet" % path)
+    image = Image.open(path).convert("L")
+    pixels = image.load()
+    return image.size[0], image.size[1], lambda x, y: pixels[x, y] >= threshold
+
+
+def load_grid(width, height, lit, gap, invert):
+    frames = []
+    step_x = COLUMNS + gap
+    step_y = ROWS + gap
+    for top in range(0, height - ROWS + 1, step_y):
+        for left in range(0, width - COLUMNS + 1, step_x):
+            frame = []
+            for y in range(ROWS):
+                frame.append("".join("#" if lit(left + x, top + y) != invert else "." for x in range(COLUMNS)))
+            frames.append(frame)
+    return frames
+
+
+def to_bytes(frame):
+    """PackedFrame stream order: pixel (r, c) is bit r*12+c from the MSB."""
+    out = [0] * FRAME_BYTES
+    for r, row in enumerate(frame):
+        for c, ch in enumerate(row):
+            if ch == "#":
+                i = r * COLUMNS + c
+                out[i // 8] |= 0x80 >> (i % 8)
+    return out
+
+
+# --------------------------------------------------------------------------
+# Encoding
+# --------------------------------------------------------------------------
+
+def varint(value):
+    out = []
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return out
+
+
+def rle_encode(data):
+    """Same scheme as FONT_TABLE_RLE glyphs: n < 0x80 = n + 1 literals, n >= 0x80 = repeat."""
+    out = []
+    i = 0
+    n = len(data)
+    while i < n:
+        run = 1
+        while i + run < n and data[i + run] == data[i] and run < 128:
+            run += 1
+        if run >= 2:
+            out += [0x80 | (run - 1), data[i]]
+            i += run
+            continue
+        start = i
+        while i < n and i - start < 128:
+            if i + 1 < n and data[i + 1] == data[i]:
+                break
+            i += 1
+        out += [i - start - 1] + data[start:i]
+    return out
+
+
+def encode_frame(prev, cur):
+    """Smallest (header, payload) for the change from prev to cur."""
+    xor = [a ^ b for a, b in zip(prev, cur)]
+    options = []
+
+    flips = [i * 8 + b for i, byte in enumerate(xor) for b in range(8) if byte & (0x80 >> b)]
+    if len(flips) <= MAX_TOGGLES:
+        options.append(((MODE_TOGGLES << 5) | len(flips), flips))
+
+    mask = sum(1 << i for i, byte in enumerate(xor) if byte)
+    options.append((MODE_MASK << 5, [mask & 0xFF, mask >> 8] + [byte for byte in xor if byte]))
+    options.append((MODE_RLE << 5, rle_encode(xor)))
+
+    return min(options, key=lambda o: len(o[1]))
+
+
+def compile_frames(frames, durations):
+    """Merged frames and the encoded byte stream."""
+    merged = []
+    for frame, duration in zip(frames, durations):
+        data = to_bytes(frame)
+        if merged and merged[-1][0] == data:
+            merged[-1][1] += duration
+        else:
+            merged.append([data, duration])
+
+    stream = []
+    prev = [0] * FRAME_BYTES
+    current = None
+    for data, duration in merged:
+        header, payload = encode_frame(prev, data)
+        if duration != current:
+            stream.append(header | DURATION_FOLLOWS)
+            stream += varint(duration)
+            current = duration
+        else:
+            stream.append(header)
+        stream += payload
+        prev = data
+    return merged, stream
+
+
+# --------------------------------------------------------------------------
+# Output
+# --------------------------------------------------------------------------
+
+def identifier(name):
+    return re.sub(r"[^A-Za-z0-9]", "_", name).upper()
+
+
+def render(args, merged, stream):
+    prefix = identifier(args.name)
+    count = len(merged)
+    raw_bytes = count * ROWS * COLUMNS         # uint8_t[8][12] per frame
+    packed_bytes = count * 4 * 4               # uint32_t[4]: three frame words + duration
+    total_ms = sum(duration for _, duration in merged)
+
+    options = ["--name %s" % args.name, "--duration %d" % args.duration]
+    if args.durations:
+        options.append("--durations %s" % args.durations)
+    if args.gap != 1:
+        options.append("--gap %d" % args.gap)
+    if args.invert:
+        options.append("--invert")
+
+    lines = []
+    lines.append("// Generated by tools/animc/animc.py - do not edit; regenerate instead.")
+    lines.append("// Source: %s" % os.path.basename(args.sheet))
+    lines.append("// Options: %s" % " ".join(options))
+    lines.append("// %d frames, %d ms per loop, %d B (byte frames %d B = %.1fx, uint32_t[4] frames %d B = %.1fx)"
+                 % (count, total_ms, len(stream), raw_bytes, raw_bytes / len(stream), packed_bytes,
+                    packed_bytes / len(stream)))
+    lines.append("#pragma once")
+    lines.append('#include "anim/AnimationData.h"')
+    lines.append("#include <avr/pgmspace.h>")
+    lines.append("")
+    lines.append("static constexpr uint8_t %s_FRAMES[] PROGMEM = {" % prefix)
+    for i in range(0, len(stream), 12):
+        lines.append("    " + ", ".join("0x%02X" % b for b in stream[i:i + 12]) + ",")
+    lines.append("};")
+    lines.append("")
+    lines.append("static constexpr AnimationData %s = {%s_FRAMES, sizeof(%s_FRAMES), %d};"
+                 % (prefix, prefix, prefix, count))
+    return "\n".join(lines) + "\n", raw_bytes, packed_bytes
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description="Compile a sprite sheet into a LEDMatrix AnimationData header.")
+    parser.add_argument("sheet", help=".txt strip, Netpbm (.pbm/.pgm/.ppm) or image sheet of 12x8 frames")
+    parser.add_argument("--name", required=True, help="asset name; the generated identifier is its upper case")
+    parser.add_argument("-o", "--output", help="header to write (default: stdout)")
+    parser.add_argument("--duration", type=int, default=100, help="ms per frame (default 100)")
+    parser.add_argument("--durations", help="comma-separated ms per frame; overrides --duration and sheet times")
+    parser.add_argument("--gap", type=int, default=1, help="pixels between frames in image sheets (default 1)")
+    parser.add_argument("--threshold", type=int, default=128, help="lit level for image sheets (default 128)")
+    parser.add_argument("--invert", action="store_true", help="dark pixels are lit (image sheets)")
+    parser.add_argument("--check", action="store_true", help="exit 1 if --output is missing or stale")
+    args = parser.parse_args(argv)
+
+    try:
+        times = None
+        ext = os.path.splitext(args.sheet)[1].lower()
+        if ext == ".txt":
+            frames, times = load_text(args.sheet)
+        elif ext in (".pbm", ".pgm", ".ppm", ".pnm"):
+            frames = load_grid(*read_netpbm(args.sheet), gap=args.gap, invert=args.invert)
+        else:
+            frames = load_grid(*read_image(args.sheet, args.threshold), gap=args.gap, invert=args.invert)
+        if not frames:
+            raise SheetError("%s: no %dx%d frames found" % (args.sheet, COLUMNS, ROWS))
+
+        if args.durations:
+            durations = [int(v) for v in args.durations.split(",")]
+            if len(durations) != len(frames):
+                raise SheetError("%d durations for %d frames" % (len(durations), len(frames)))
+        elif times and len(times) == len(frames):
+            durations = [b - a for a, b in zip(times, times[1:])] + [args.duration]
+        else:
+            durations = [args.duration] * len(frames)
+        if any(d <= 0 or d > 0xFFFF for d in durations):
+            raise SheetError("durations must be 1-65535 ms")
+
+        merged, stream = compile_frames(frames, durations)
+        if len(merged) > 0xFFFF or len(stream) > 0xFFFF:
+            raise SheetError("animation too large for 16-bit sizes")
+        text, raw_bytes, packed_bytes = render(args, merged, stream)
+    except (SheetError, OSError, ValueError) as e:
+        print("animc: %s" % e, file=sys.stderr)
+        return 2
+
+    if args.check:
+        try:
+            with open(args.output, "r", encoding="utf-8") as f:
+                current = f.read()
+        except (OSError, TypeError):
+            current = None
+        if current != text:
+            print("animc: %s is out of date" % args.output, file=sys.stderr)
+            return 1
+        return 0
+
+    if args.output:
+        with open(args.output, "w", encoding="utf-8", newline="\n") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+    print("animc: %s: %d frames (%d in sheet), %d B; %.1fx smaller than byte frames, %.1fx than uint32_t[4] frames"
+          % (args.name, len(merged), len(frames), len(stream), raw_bytes / len(stream), packed_bytes / len(stream)),
+          file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,466 @@
+#!/usr/bin/env python3
+"""fontc - compile a bitmap font into a LEDMatrix FontTable header.
+
+Reads a BDF font (or rasterizes a TTF/OTF at a pixel size, if Pillow is
+installed) and writes the FontTable format used by libraries/LEDMatrix:
+column-major glyph bitmaps (one byte per column, bit r = row r), a
+GlyphEntry table indexed by c - first, optional kerning pairs and
+optional run-length coding.
+
+The output depends only on the input font and the options, so
+regenerating a font gives a byte-identical file and diffs stay
+reviewable. Use --check in CI to fail when a header is stale.
+
+Examples:
+    fontc.py fonts/default5x7.bdf --name Default5x7 --space-width 3 \\
+        -o ../../libraries/LEDMatrix/src/font/Default5x7Table.h
+    fontc.py fonts/6x8.bdf --name Narrow --range 32-126 --proportional --auto-kern
+    fontc.py DejaVuSans.ttf --size 8 --name Sans8 --range 0-9 --range A-Z --proportional --rle
+"""
+
+import argparse
+import os
+import re
+import sys
+
+MAX_ROWS = 8  # one byte per column
+GLYPH_ENTRY_SIZE = 4  # sizeof(GlyphEntry): uint16_t + uint8_t, padded to 4 on ARM and x86
+
+
+class Glyph:
+    def __init__(self, code, columns, advance):
+        self.code = code
+        self.columns = columns  # list of ints, bit r = row r
+        self.advance = advance  # source advance in pixels
+
+    def blank(self):
+        return not any(self.columns)
+
+
+class FontError(Exception):
+    pass
+
+
+# --------------------------------------------------------------------------
+# Sources
+# --------------------------------------------------------------------------
+
+def load_bdf(path):
+    """Parse a BDF file into (glyphs by code, cell width, cell height)."""
+    with open(path, "r", encoding="latin-1") as f:
+        lines = [line.rstrip("\n") for line in f]
+
+    bbox = None
+    ascent = descent = None
+    glyphs = {}
+    i = 0
+    while i < len(lines):
+        words = lines[i].split()
+        i += 1
+        if not words:
+            continue
+        key = words[0]
+        if key == "FONTBOUNDINGBOX":
+            bbox = [int(v) for v in words[1:5]]
+        elif key == "FONT_ASCENT":
+            ascent = int(words[1])
+        elif key == "FONT_DESCENT":
+            descent = int(words[1])
+        elif key == "STARTCHAR":
+            code = None
+            advance = None
+            box = None
+            rows = []
+            while i < len(lines):
+                words = lines[i].split()
+                i += 1
+                if not words:
+                    continue
+                if words[0] == "ENCODING":
+                    code = int(words[1])
+                elif words[0] == "DWIDTH":
+                    advance = int(words[1])
+                elif words[0] == "BBX":
+                    box = [int(v) for v in words[1:5]]
+                elif words[0] == "BITMAP":
+                    while i < len(lines) and lines[i].strip() != "ENDCHAR":
+                        rows.append(lines[i].strip())
+                        i += 1
+                elif words[0] == "ENDCHAR":
+                    break
+            if code is None or code < 0 or box is None:
+                continue
+            glyphs[code] = (advance, box, rows)
+
+    if bbox is None:
+        raise FontError("%s: no FONTBOUNDINGBOX" % path)
+    cell_w, cell_h, cell_x, cell_y = bbox
+    if ascent is None:
+        ascent = cell_h + cell_y
+    if descent is None:
+        descent = -cell_y
+    height = ascent + descent
+
+    result = {}
+    for code, (advance, box, rows) in glyphs.items():
+        w, h, x, y = box
+        columns = [0] * cell_w
+        for i, hexrow in enumerate(rows[:h]):
+            bits = int(hexrow, 16) if hexrow else 0
+            nbits = len(hexrow) * 4
+            # Bitmap row i sits (y + h - 1 - i) above the baseline
+            row = ascent - 1 - (y + h - 1 - i)
+            if row < 0 or row >= height:
+                continue
+            for j in range(w):
+                if bits & (1 << (nbits - 1 - j)):
+                    col = x - cell_x + j
+                    if 0 <= col < cell_w:
+                        columns[col] |= 1 << row
+        result[code] = Glyph(code, columns, advance if advance is not None else cell_w)
+    return result, cell_w, height
+
+
+def load_ttf(path, size, codes):
+    """Rasterize the requested characters of an outline font."""
+    try:
+        from PIL import Image, ImageDraw, ImageFont
+    except ImportError:
+        raise FontError("TTF input needs Pillow (pip install pillow); or convert to BDF first")
+
+    font = ImageFont.truetype(path, size)
+    ascent, descent = font.getmetrics()
+    height = ascent + descent
+    result = {}
+    cell_w = 0
+    for code in codes:
+        ch = chr(code)
+        advance = int(round(font.getlength(ch)))
+        width = max(advance, 1)
+        image = Image.new("L", (width + size, height), 0)
+        ImageDraw.Draw(image).text((0, 0), ch, font=font, fill=255)
+        pixels = image.load()
+        columns = []
+        for x in range(image.size[0]):
+            bits = 0
+            for y in range(height):
+                if pixels[x, y] >= 128:
+                    bits |= 1 << y
+            columns.append(bits)
+        while len(columns) > width and columns[-1] == 0:
+            columns.pop()
+        cell_w = max(cell_w, len(columns))
+        result[code] = Glyph(code, columns, advance)
+    for glyph in result.values():
+        glyph.columns += [0] * (cell_w - len(glyph.columns))
+    return result, cell_w, height
+
+
+# --------------------------------------------------------------------------
+# Shaping
+# --------------------------------------------------------------------------
+
+def parse_ranges(specs):
+    codes = set()
+    for spec in specs:
+        for part in spec.split(","):
+            part = part.strip()
+            if not part:
+                continue
+            m = re.fullmatch(r"(.+?)-(.+)", part) if len(part) > 1 else None
+            lo, hi = (m.group(1), m.group(2)) if m else (part, part)
+            codes.update(range(parse_char(lo), parse_char(hi) + 1))
+    return sorted(codes)
+
+
+def parse_char(text):
+    if len(text) == 1:
+        return ord(text)
+    return int(text, 0)
+
+
+def shape(glyphs, codes, proportional, space_width, cell_w):
+    """Column lists for every requested code (None = not in the font)."""
+    out = {}
+    for code in codes:
+        glyph = glyphs.get(code)
+        if glyph is None:
+            out[code] = None
+            continue
+        columns = list(glyph.columns)
+        if glyph.blank():
+            if space_width is not None:
+                width = space_width
+            elif proportional:
+                width = max(1, cell_w // 2)
+            else:
+                width = cell_w
+            columns = [0] * width
+        elif proportional:
+            while columns and columns[0] == 0:
+                columns.pop(0)
+            while columns and columns[-1] == 0:
+                columns.pop()
+        out[code] = columns
+    return out
+
+
+def auto_kern(shaped, spacing, max_kern):
+    """Pairs that can close up without pixels touching, even diagonally."""
+    inf = 1 << 8
+
+    def profile(columns, from_right):
+        rows = [inf] * MAX_ROWS
+        order = list(reversed(columns)) if from_right else columns
+        for distance, bits in enumerate(order):
+            for r in range(MAX_ROWS):
+                if bits & (1 << r) and rows[r] == inf:
+                    rows[r] = distance
+        return rows
+
+    inked = [(code, cols) for code, cols in sorted(shaped.items()) if cols and any(cols)]
+    rights = {code: profile(cols, True) for code, cols in inked}
+    lefts = {code: profile(cols, False) for code, cols in inked}
+    pairs = []
+    for left, _ in inked:
+        for right, _ in inked:
+            closest = inf
+            for r in range(MAX_ROWS):
+                if rights[left][r] == inf:
+                    continue
+                for n in (r - 1, r, r + 1):
+                    if 0 <= n < MAX_ROWS and lefts[right][n] != inf:
+                        closest = min(closest, rights[left][r] + lefts[right][n])
+            # Keep at least one blank column between the nearest pixels
+            k = min(max_kern, closest + spacing - 1) if closest != inf else 0
+            if k > 0:
+                pairs.append((left, right, -k))
+    return pairs
+
+
+def load_kerning(path):
+    pairs = []
+    with open(path, "r", encoding="utf-8") as f:
+        for number, line in enumerate(f, 1):
+            line = line.rstrip("\n")
+            if not line.strip() or line.lstrip().startswith("#"):
+                continue
+            if len(line) < 4 or line[2] != " ":
+                raise FontError("%s:%d: expected '<left><right> <adjust>'" % (path, number))
+            pairs.append((ord(line[0]), ord(line[1]), int(line[3:])))
+    return pairs
+
+
+def rle_encode(columns):
+    """Run-length code one glyph (format in TableFont.h)."""
+    out = []
+    i = 0
+    n = len(columns)
+    while i < n:
+        run = 1
+        while i + run < n and columns[i + run] == columns[i] and run < 128:
+            run += 1
+        if run >= 2:
+            out += [0x80 | (run - 1), columns[i]]
+            i += run
+            continue
+        start = i
+        while i < n and i - start < 128:
+            if i + 1 < n and columns[i + 1] == columns[i]:
+                break
+            i += 1
+        out += [i - start - 1] + columns[start:i]
+    return out
+
+
+# --------------------------------------------------------------------------
+# Output
+# --------------------------------------------------------------------------
+
+def char_comment(code):
+    if code == ord("\\"):
+        return "'\\\\'"
+    if 32 <= code < 127:
+        return "'%s'" % chr(code)
+    return "0x%02X" % code
+
+
+def c_char(code):
+    if code == ord("'"):
+        return "'\\''"
+    if code == ord("\\"):
+        return "'\\\\'"
+    if 32 <= code < 127:
+        return "'%s'" % chr(code)
+    return "'\\x%02X'" % code
+
+
+def identifier(name):
+    return re.sub(r"[^A-Za-z0-9]", "_", name).upper()
+
+
+def render(args, source, shaped, height, kerning):
+    prefix = identifier(args.name)
+    codes = sorted(shaped)
+    first, last = codes[0], codes[-1]
+
+    bitmap_lines = []
+    entries = []
+    offset = 0
+    widest = 0
+    for code in range(first, last + 1):
+        columns = shaped.get(code)
+        if not columns:
+            entries.append((0, 0))
+            continue
+        data = rle_encode(columns) if args.rle else columns
+        bitmap_lines.append("    %s, // %s" % (", ".join("0x%02X" % b for b in data), char_comment(code)))
+        entries.append((offset, len(columns)))
+        offset += len(data)
+        widest = max(widest, len(columns))
+    if offset > 0xFFFF:
+        raise FontError("bitmap is %d bytes; glyph offsets are 16-bit" % offset)
+    if widest > 255:
+        raise FontError("glyph %d columns wide; widths are 8-bit" % widest)
+
+    options = []
+    options.append("--name %s" % args.name)
+    if args.range:
+        options.append(" ".join("--range %s" % r for r in args.range))
+    if args.size:
+        options.append("--size %d" % args.size)
+    if args.proportional:
+        options.append("--proportional")
+    if args.space_width is not None:
+        options.append("--space-width %d" % args.space_width)
+    options.append("--spacing %d" % args.spacing)
+    if args.kern:
+        options.append("--kern %s" % os.path.basename(args.kern))
+    if args.auto_kern:
+        options.append("--auto-kern --max-kern %d" % args.max_kern)
+    if args.rle:
+        options.append("--rle")
+
+    lines = []
+    lines.append("// Generated by tools/fontc/fontc.py - do not edit; regenerate instead.")
+    lines.append("// Source: %s" % os.path.basename(source))
+    lines.append("// Options: %s" % " ".join(options))
+    lines.append("// %d glyphs (%s..%s), %d rows, bitmap %d B, glyph table %d B, %d kerning pairs"
+                 % (sum(1 for e in entries if e[1]), char_comment(first), char_comment(last), height,
+                    offset, GLYPH_ENTRY_SIZE * len(entries), len(kerning)))
+    lines.append("//")
+    lines.append("// Include from exactly one .cpp and wrap %s_TABLE in a TableFont." % prefix)
+    lines.append("#pragma once")
+    lines.append('#include "font/FontCommon.h"')
+    lines.append("#include <avr/pgmspace.h>")
+    lines.append("")
+    lines.append("static constexpr uint8_t %s_BITMAP[] PROGMEM = {" % prefix)
+    lines += bitmap_lines
+    lines.append("};")
+    lines.append("")
+    lines.append("static constexpr GlyphEntry %s_GLYPHS[] PROGMEM = {" % prefix)
+    for i in range(0, len(entries), 8):
+        lines.append("    " + ", ".join("{%d, %d}" % e for e in entries[i:i + 8]) + ",")
+    lines.append("};")
+    lines.append("")
+
+    kerning_ref = "nullptr"
+    if kerning:
+        kerning_ref = "%s_KERNING" % prefix
+        lines.append("static constexpr KernPair %s_KERNING[] PROGMEM = {" % prefix)
+        for i in range(0, len(kerning), 6):
+            lines.append("    " + ", ".join("{%s, %s, %d}" % (c_char(l), c_char(r), a)
+                                            for l, r, a in kerning[i:i + 6]) + ",")
+        lines.append("};")
+        lines.append("")
+
+    flags = "FONT_TABLE_RLE" if args.rle else "0"
+    lines.append("static constexpr FontTable %s_TABLE = {%s, %s, %d, %d, %s_BITMAP, %s_GLYPHS, %s, %d, %s};"
+                 % (prefix, c_char(first), c_char(last), height, args.spacing, prefix, prefix,
+                    kerning_ref, len(kerning), flags))
+    lines.append("")
+    lines.append("static_assert(sizeof(%s_GLYPHS) / sizeof(GlyphEntry) == %s_TABLE.count(), \"one entry per character\");"
+                 % (prefix, prefix))
+    lines.append("static_assert(sizeof(%s_BITMAP) == %d, \"bitmap size\");" % (prefix, offset))
+    lines.append("static_assert(sizeof(%s_GLYPHS) == %d, \"glyph table size\");"
+                 % (prefix, GLYPH_ENTRY_SIZE * len(entries)))
+    if args.rle:
+        lines.append("static_assert(%d <= FONT_TABLE_MAX_GLYPH_WIDTH, \"raise FONT_TABLE_MAX_GLYPH_WIDTH for this font\");"
+                     % widest)
+    return "\n".join(lines) + "\n", offset, sum(len(c) for c in shaped.values() if c)
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description="Compile a BDF/TTF font into a LEDMatrix FontTable header.")
+    parser.add_argument("font", help="BDF file, or TTF/OTF with --size")
+    parser.add_argument("--name", required=True, help="font name; prefixes the generated identifiers")
+    parser.add_argument("-o", "--output", help="header to write (default: stdout)")
+    parser.add_argument("--size", type=int, help="pixel size for TTF/OTF input")
+    parser.add_argument("--range", action="append",
+                        help="characters to include, e.g. 32-126, A-Z, 0x30-0x39 (repeatable; default 32-126)")
+    parser.add_argument("--proportional", action="store_true", help="trim each glyph to its ink")
+    parser.add_argument("--space-width", type=int, help="columns for blank glyphs such as space")
+    parser.add_argument("--spacing", type=int, default=1, help="blank columns after each glyph (default 1)")
+    parser.add_argument("--kern", help="kerning pairs file: '<left><right> <adjust>' per line")
+    parser.add_argument("--auto-kern", action="store_true", help="derive kerning pairs from glyph shapes")
+    parser.add_argument("--max-kern", type=int, default=1, help="most columns --auto-kern removes (default 1)")
+    parser.add_argument("--rle", action="store_true", help="run-length code the glyph bitmaps")
+    parser.add_argument("--check", action="store_true", help="exit 1 if --output is missing or stale")
+    args = parser.parse_args(argv)
+
+    try:
+        codes = parse_ranges(args.range or ["32-126"])
+        if not codes or codes[-1] > 255:
+            raise FontError("ranges must lie within 0-255")
+        if args.font.lower().endswith((".ttf", ".otf")):
+            if not args.size:
+                raise FontError("TTF/OTF input needs --size")
+            glyphs, cell_w, height = load_ttf(args.font, args.size, codes)
+        else:
+            glyphs, cell_w, height = load_bdf(args.font)
+        if height > MAX_ROWS:
+            raise FontError("font is %d rows; the column format holds %d" % (height, MAX_ROWS))
+
+        shaped = shape(glyphs, codes, args.proportional, args.space_width, cell_w)
+        if not any(shaped.values()):
+            raise FontError("none of the requested characters are in the font")
+
+        kerning = {}
+        if args.auto_kern:
+            for left, right, adjust in auto_kern(shaped, args.spacing, args.max_kern):
+                kerning[(left, right)] = adjust
+        if args.kern:
+            for left, right, adjust in load_kerning(args.kern):
+                kerning[(left, right)] = adjust
+        kerning = sorted((l, r, a) for (l, r), a in kerning.items()
+                         if a and shaped.get(l) and shaped.get(r))
+
+        text, stored, raw = render(args, args.font, shaped, height, kerning)
+    except (FontError, OSError, ValueError) as e:
+        print("fontc: %s" % e, file=sys.stderr)
+        return 2
+
+    if args.check:
+        try:
+            with open(args.output, "r", encoding="utf-8") as f:
+                current = f.read()
+        except (OSError, TypeError):
+            current = None
+        if current != text:
+            print("fontc: %s is out of date" % args.output, file=sys.stderr)
+            return 1
+        return 0
+
+    if args.output:
+        with open(args.output, "w", encoding="utf-8", newline="\n") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+    print("fontc: %s: %d glyphs, %d rows, %d B columns -> %d B stored%s, %d kerning pairs"
+          % (args.name, sum(1 for c in shaped.values() if c), height, raw, stored,
+             " (rle)" if args.rle else "", len(kerning)), file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())